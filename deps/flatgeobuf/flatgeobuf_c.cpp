@@ -230,8 +230,16 @@ void flatgeobuf_create_index(ctx *ctx)
 int flatgeobuf_decode_feature(ctx *ctx)
 {
     LWDEBUGF(2, "reading size prefix at %ld", ctx->offset);
+    if (ctx->offset + sizeof(uoffset_t) > ctx->size) {
+        lwerror("feature size prefix at %ld is out of bounds", ctx->offset);
+        return -1;
+    }
     auto size = flatbuffers::GetPrefixedSize(ctx->buf + ctx->offset);
 	LWDEBUGF(2, "size is %ld (without size prefix)", size);
+    if (size > ctx->size - ctx->offset - sizeof(uoffset_t)) {
+        lwerror("feature at %ld with size %ld is out of bounds", ctx->offset, size);
+        return -1;
+    }
 
     Verifier verifier(ctx->buf + ctx->offset, size);
 	if (VerifySizePrefixedFeatureBuffer(verifier)) {
@@ -268,8 +276,16 @@ int flatgeobuf_decode_feature(ctx *ctx)
 int flatgeobuf_decode_header(ctx *ctx)
 {
     LWDEBUGF(2, "reading size prefix at %ld", ctx->offset);
+    if (ctx->offset + sizeof(uoffset_t) > ctx->size) {
+        lwerror("header size prefix at %ld is out of bounds", ctx->offset);
+        return -1;
+    }
     auto size = flatbuffers::GetPrefixedSize(ctx->buf + ctx->offset);
 	LWDEBUGF(2, "size is %ld (without size prefix)", size);
+    if (size > ctx->size - ctx->offset - sizeof(uoffset_t)) {
+        lwerror("header with size %ld is out of bounds", size);
+        return -1;
+    }
 
     Verifier verifier(ctx->buf + ctx->offset, size);
 	if (VerifySizePrefixedHeaderBuffer(verifier)) {
@@ -310,11 +326,60 @@ int flatgeobuf_decode_header(ctx *ctx)
 	LWDEBUGF(2, "ctx->geometry_type: %d", ctx->geometry_type);
 	LWDEBUGF(2, "ctx->columns_len: %d", ctx->columns_size);
 
+    ctx->index_offset = 0;
     if (ctx->index_node_size > 0 && ctx->features_count > 0) {
         auto treeSize = PackedRTree::size(ctx->features_count, ctx->index_node_size);
         LWDEBUGF(2, "Adding tree size %ld to offset", treeSize);
+        if (treeSize > ctx->size - ctx->offset) {
+            lwerror("index with size %ld is out of bounds", treeSize);
+            return -1;
+        }
+        ctx->index_offset = ctx->offset;
         ctx->offset += treeSize;
     }
+    ctx->feature_offset = ctx->offset;
+
+    return 0;
+}
+
+int flatgeobuf_index_search(ctx *ctx, double xmin, double ymin, double xmax, double ymax)
+{
+    if (ctx->index_offset == 0) {
+        snprintf(ctx->search_error, sizeof(ctx->search_error), "data has no spatial index");
+        return -1;
+    }
+
+    const auto indexOffset = ctx->index_offset;
+    const auto indexSize = ctx->feature_offset - ctx->index_offset;
+    const auto buf = ctx->buf;
+    const auto readNode = [buf, indexOffset, indexSize] (uint8_t *nodesBuf, size_t i, size_t s) {
+        if (i + s > indexSize)
+            throw std::out_of_range("index node out of bounds");
+        memcpy(nodesBuf, buf + indexOffset + i, s);
+    };
+    const NodeItem item = { xmin, ymin, xmax, ymax, 0 };
+
+    std::vector<SearchResultItem> found;
+    try {
+        found = PackedRTree::streamSearch(ctx->features_count, ctx->index_node_size, item, readNode);
+    } catch (const std::exception &e) {
+        // No lwerror here, it would longjmp out of the handler and skip
+        // the destructors; the caller raises the error instead.
+        snprintf(ctx->search_error, sizeof(ctx->search_error), "%s", e.what());
+        return -1;
+    }
+
+    LWDEBUGF(2, "index search found %ld features", found.size());
+
+    ctx->search_result_len = found.size();
+    ctx->search_result = nullptr;
+    if (found.size() > 0) {
+        ctx->search_result = (flatgeobuf_search_item *) lwalloc(sizeof(flatgeobuf_search_item) * found.size());
+        for (size_t i = 0; i < found.size(); i++) {
+            ctx->search_result[i].offset = found[i].offset;
+            ctx->search_result[i].index = found[i].index;
+        }
+    }
 
     return 0;
 }
\ No newline at end of file
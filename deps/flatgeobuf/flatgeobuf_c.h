@@ -77,6 +77,12 @@ typedef struct flatgeobuf_item
 	uint64_t offset;
 } flatgeobuf_item;
 
+typedef struct flatgeobuf_search_item
+{
+	uint64_t offset; // relative to the first feature
+	uint64_t index;
+} flatgeobuf_search_item;
+
 typedef struct flatgeobuf_ctx
 {
     // header contents
@@ -116,6 +122,13 @@ typedef struct flatgeobuf_ctx
 	bool create_index;
 	flatgeobuf_item **items;
 	uint64_t items_len;
+
+	// decode spatial index search
+	uint64_t index_offset;
+	uint64_t feature_offset;
+	flatgeobuf_search_item *search_result;
+	uint64_t search_result_len;
+	char search_error[128]; // set when flatgeobuf_index_search fails
 } flatgeobuf_ctx;
 
 int flatgeobuf_encode_header(flatgeobuf_ctx *ctx);
@@ -124,6 +137,7 @@ void flatgeobuf_create_index(flatgeobuf_ctx *ctx);
 
 int flatgeobuf_decode_header(flatgeobuf_ctx *ctx);
 int flatgeobuf_decode_feature(flatgeobuf_ctx *ctx);
+int flatgeobuf_index_search(flatgeobuf_ctx *ctx, double xmin, double ymin, double xmax, double ymax);
 
 #ifdef __cplusplus
 }
@@ -262,11 +262,13 @@ bytebuffer_clear(bytebuffer_t *s)
 	s->readcursor = s->writecursor = s->buf_start;
 }
 
+#endif
+
 /**
 * Writes a uint8_t value to the buffer
 */
 void
-bytebuffer_append_bulk(bytebuffer_t *s, void * start, size_t size)
+bytebuffer_append_bulk(bytebuffer_t *s, const void *start, size_t size)
 {
 	LWDEBUGF(2,"bytebuffer_append_bulk with size %d",size);
 	bytebuffer_makeroom(s, size);
@@ -275,6 +277,7 @@ bytebuffer_append_bulk(bytebuffer_t *s, void * start, size_t size)
 	return;
 }
 
+#if 0
 /*
 * Writes Integer to the buffer
 */
@@ -69,7 +69,7 @@ int64_t bytebuffer_read_varint(bytebuffer_t *s);
 bytebuffer_t* bytebuffer_merge(bytebuffer_t **buff_array, int nbuffers);
 void bytebuffer_reset_reading(bytebuffer_t *s);
 void bytebuffer_append_bytebuffer(bytebuffer_t *write_to,bytebuffer_t *write_from);
-void bytebuffer_append_bulk(bytebuffer_t *s, void * start, size_t size);
+void bytebuffer_append_bulk(bytebuffer_t *s, const void *start, size_t size);
 void bytebuffer_append_int(bytebuffer_t *buf, const int val, int swap);
 void bytebuffer_append_double(bytebuffer_t *buf, const double val, int swap);
 #endif
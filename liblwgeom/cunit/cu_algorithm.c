@@ -1759,6 +1759,52 @@ static void test_kmeans(void)
 	return;
 }
 
+static void test_kmeans_many_clusters(void)
+{
+	/* 20x20 grid of tight blobs, one cluster per blob */
+	static int grid_size = 20;
+	static int blob_size = 5;
+	int num_clusters = grid_size * grid_size;
+	int N = num_clusters * blob_size;
+	LWGEOM **geoms;
+	char *seen;
+	int i, j, k = 0;
+	int *r;
+
+	geoms = lwalloc(sizeof(LWGEOM*) * N);
+	for (j = 0; j < num_clusters; j++)
+	{
+		for (i = 0; i < blob_size; i++)
+		{
+			double x = 10.0 * (j % grid_size) + 0.1 * i;
+			double y = 10.0 * (j / grid_size) - 0.05 * i;
+			geoms[k++] = lwpoint_as_lwgeom(lwpoint_make2d(SRID_UNKNOWN, x, y));
+		}
+	}
+
+	r = lwgeom_cluster_kmeans((const LWGEOM **)geoms, N, num_clusters, 0.0);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(r);
+
+	/* Every blob is a cluster of its own */
+	seen = lwalloc(num_clusters);
+	memset(seen, 0, num_clusters);
+	for (j = 0; j < num_clusters; j++)
+	{
+		int cluster = r[j * blob_size];
+		CU_ASSERT_FATAL(cluster >= 0 && cluster < num_clusters);
+		CU_ASSERT_FALSE(seen[cluster]);
+		seen[cluster] = 1;
+		for (i = 1; i < blob_size; i++)
+			CU_ASSERT_EQUAL(r[j * blob_size + i], cluster);
+	}
+
+	lwfree(seen);
+	lwfree(r);
+	for (i = 0; i < k; i++)
+		lwgeom_free(geoms[i]);
+	lwfree(geoms);
+}
+
 static void test_trim_bits(void)
 {
 	POINTARRAY *pta = ptarray_construct_empty(LW_TRUE, LW_TRUE, 2);
@@ -1837,6 +1883,7 @@ void algorithms_suite_setup(void)
 	PG_ADD_TEST(suite,test_lw_arc_center);
 	PG_ADD_TEST(suite,test_point_density);
 	PG_ADD_TEST(suite,test_kmeans);
+	PG_ADD_TEST(suite,test_kmeans_many_clusters);
 	PG_ADD_TEST(suite,test_median_handles_3d_correctly);
 	PG_ADD_TEST(suite,test_median_robustness);
 	PG_ADD_TEST(suite,test_lwpoly_construct_circle);
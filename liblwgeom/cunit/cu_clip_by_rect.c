@@ -15,6 +15,7 @@
 
 #include "liblwgeom.h"
 #include "liblwgeom_internal.h"
+#include "lwgeom_geos.h"
 
 static void test_lwgeom_clip_by_rect(void)
 {
@@ -73,6 +74,142 @@ static void test_lwgeom_clip_by_rect(void)
 	lwgeom_free(in);
 }
 
+static void
+check_clip_by_rect(const char *wkt, double x1, double y1, double x2, double y2, const char *expected)
+{
+	LWGEOM *in = lwgeom_from_wkt(wkt, LW_PARSER_CHECK_NONE);
+	LWGEOM *out = lwgeom_clip_by_rect(in, x1, y1, x2, y2);
+	char *tmp = lwgeom_to_ewkt(out);
+	ASSERT_STRING_EQUAL(tmp, expected);
+	lwfree(tmp);
+	lwgeom_free(out);
+	lwgeom_free(in);
+}
+
+static void test_lwgeom_clip_by_rect_native(void)
+{
+	cu_error_msg_reset();
+
+	/* Shell crossing the rectangle twice, clockwise output */
+	check_clip_by_rect("POLYGON((0 0,10 0,10 10,0 10,0 0))", 5, 5, 20, 20,
+	                   "POLYGON((5 5,5 10,10 10,10 5,5 5))");
+	check_clip_by_rect("POLYGON((-5 -5,15 -5,15 5,-5 5,-5 -5))", 0, 0, 10, 10,
+	                   "POLYGON((0 0,0 5,10 5,10 0,0 0))");
+
+	/* Rectangle inside the shell, holes inside kept and outside dropped */
+	check_clip_by_rect("POLYGON((0 0,20 0,20 20,0 20,0 0),(2 2,2 4,4 4,4 2,2 2),(15 15,15 16,16 16,16 15,15 15))",
+	                   1, 1, 10, 10,
+	                   "POLYGON((1 1,1 10,10 10,10 1,1 1),(2 2,2 4,4 4,4 2,2 2))");
+
+	/* Disjoint parts are dropped, a single survivor is not a multi */
+	check_clip_by_rect("MULTIPOLYGON(((0 0,1 0,1 1,0 1,0 0)),((20 20,21 20,21 21,20 20)))", -1, -1, 5, 5,
+	                   "POLYGON((0 0,1 0,1 1,0 1,0 0))");
+
+	/* Line leaving and coming back */
+	check_clip_by_rect("LINESTRING(-5 5,5 5,5 15,6 15,6 5,15 5)", 0, 0, 10, 10,
+	                   "MULTILINESTRING((0 5,5 5,5 10),(6 10,6 5,10 5))");
+
+	/* Pieces along the boundary are dropped */
+	check_clip_by_rect("LINESTRING(0 0,10 0,10 5,20 5)", 0, 0, 10, 10, "GEOMETRYCOLLECTION EMPTY");
+
+	/* Lines are split where they touch the boundary */
+	check_clip_by_rect("LINESTRING(5 5,10 5,5 6)", 0, 0, 10, 10,
+	                   "MULTILINESTRING((5 5,10 5),(10 5,5 6))");
+
+	/* Mixed parts come back polygons first */
+	check_clip_by_rect("GEOMETRYCOLLECTION(POINT(1 1),LINESTRING(-5 5,5 5),POLYGON((-5 -5,15 -5,15 5,-5 5,-5 -5)))",
+	                   0, 0, 10, 10,
+	                   "GEOMETRYCOLLECTION(POLYGON((0 0,0 5,10 5,10 0,0 0)),LINESTRING(0 5,5 5),POINT(1 1))");
+}
+
+static void
+check_clip_by_rect_closed(const char *wkt, double x1, double y1, double x2, double y2, const char *expected)
+{
+	LWGEOM *in = lwgeom_from_wkt(wkt, LW_PARSER_CHECK_NONE);
+	LWGEOM *out = lwgeom_clip_by_rect_native(in, x1, y1, x2, y2, LW_TRUE);
+	char *tmp = out ? lwgeom_to_ewkt(out) : NULL;
+	ASSERT_STRING_EQUAL(tmp ? tmp : "NULL", expected);
+	lwfree(tmp);
+	if (out)
+		lwgeom_free(out);
+	lwgeom_free(in);
+}
+
+static void test_lwgeom_clip_by_rect_native_closed(void)
+{
+	cu_error_msg_reset();
+
+	/* Points on the boundary are kept */
+	check_clip_by_rect_closed("MULTIPOINT(0 5,5 5,11 5,10 10)", 0, 0, 10, 10,
+	                          "MULTIPOINT(0 5,5 5,10 10)");
+
+	/* So are pieces along the boundary, and lines are not split there */
+	check_clip_by_rect_closed("LINESTRING(0 -5,0 5,5 5)", 0, 0, 10, 10,
+	                          "LINESTRING(0 0,0 5,5 5)");
+	check_clip_by_rect_closed("LINESTRING(5 5,10 5,5 6)", 0, 0, 10, 10,
+	                          "LINESTRING(5 5,10 5,5 6)");
+
+	/* Cut points carry interpolated measures, inputs with them still decline */
+	check_clip_by_rect_closed("LINESTRING M (-5 5 0,5 5 10)", 0, 0, 10, 10, "NULL");
+
+	/* Polygons clip as in the open case */
+	check_clip_by_rect_closed("POLYGON((-5 -5,15 -5,15 5,-5 5,-5 -5))", 0, 0, 10, 10,
+	                          "POLYGON((0 0,0 5,10 5,10 0,0 0))");
+}
+
+/* The native clipper has to give back exactly what GEOSClipByRect does */
+static void
+check_clip_by_rect_geos(const char *wkt, double x1, double y1, double x2, double y2)
+{
+	LWGEOM *in = lwgeom_from_wkt(wkt, LW_PARSER_CHECK_NONE);
+	LWGEOM *native = lwgeom_clip_by_rect_native(in, x1, y1, x2, y2, LW_FALSE);
+	GEOSGeometry *g_in, *g_out;
+	LWGEOM *geos;
+	char *native_wkt, *geos_wkt;
+
+	CU_ASSERT_PTR_NOT_NULL_FATAL(native);
+	initGEOS(lwnotice, lwgeom_geos_error);
+	g_in = LWGEOM2GEOS(in, LW_FALSE);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(g_in);
+	g_out = GEOSClipByRect(g_in, x1, y1, x2, y2);
+	CU_ASSERT_PTR_NOT_NULL_FATAL(g_out);
+	geos = GEOS2LWGEOM(g_out, LW_FALSE);
+	GEOSGeom_destroy(g_in);
+	GEOSGeom_destroy(g_out);
+
+	native_wkt = lwgeom_to_ewkt(native);
+	geos_wkt = lwgeom_to_ewkt(geos);
+	ASSERT_STRING_EQUAL(native_wkt, geos_wkt);
+	lwfree(native_wkt);
+	lwfree(geos_wkt);
+	lwgeom_free(native);
+	lwgeom_free(geos);
+	lwgeom_free(in);
+}
+
+static void test_lwgeom_clip_by_rect_native_geos(void)
+{
+	cu_error_msg_reset();
+
+	/* Shell orientation and start vertex, from either orientation */
+	check_clip_by_rect_geos("POLYGON((0 0,10 0,10 10,0 10,0 0))", 5, 5, 20, 20);
+	check_clip_by_rect_geos("POLYGON((0 0,0 10,10 10,10 0,0 0))", 5, 5, 20, 20);
+	check_clip_by_rect_geos("POLYGON((-5 -5,15 -5,15 5,-5 5,-5 -5))", 0, 0, 10, 10);
+	check_clip_by_rect_geos("POLYGON((5 5,15 5,15 8,5 8,5 5))", 0, 0, 10, 10);
+
+	/* Rectangle inside the shell, with a hole inside the rectangle */
+	check_clip_by_rect_geos("POLYGON((0 0,20 0,20 20,0 20,0 0),(2 2,2 4,4 4,4 2,2 2))", 1, 1, 10, 10);
+
+	/* Lines touching the boundary at a vertex, running along it, crossing it */
+	check_clip_by_rect_geos("LINESTRING(5 5,10 5,5 6)", 0, 0, 10, 10);
+	check_clip_by_rect_geos("LINESTRING(0 5,5 5,5 6)", 0, 0, 10, 10);
+	check_clip_by_rect_geos("LINESTRING(0 0,10 0,10 5,20 5)", 0, 0, 10, 10);
+	check_clip_by_rect_geos("LINESTRING(-5 5,5 5,5 15,6 15,6 5,15 5)", 0, 0, 10, 10);
+
+	/* Points on the boundary are dropped */
+	check_clip_by_rect_geos("MULTIPOINT(0 0,5 5,10 3,11 3)", 0, 0, 10, 10);
+}
+
 /*
 ** Used by test harness to register the tests in this file.
 */
@@ -81,4 +218,7 @@ void clip_by_rect_suite_setup(void)
 {
 	CU_pSuite suite = CU_add_suite("clip_by_rectangle", NULL, NULL);
 	PG_ADD_TEST(suite, test_lwgeom_clip_by_rect);
+	PG_ADD_TEST(suite, test_lwgeom_clip_by_rect_native);
+	PG_ADD_TEST(suite, test_lwgeom_clip_by_rect_native_geos);
+	PG_ADD_TEST(suite, test_lwgeom_clip_by_rect_native_closed);
 }
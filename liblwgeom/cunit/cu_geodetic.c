@@ -1347,6 +1347,41 @@ static void test_spheroid_distance(void)
 
 }
 
+static void test_spheroid_distances(void)
+{
+	GEOGRAPHIC_POINT g1[300], g2[300];
+	double d[300];
+	double length = 0.0;
+	POINTARRAY *pa;
+	uint32_t i;
+	SPHEROID s;
+
+	/* Init to WGS84 */
+	spheroid_init(&s, 6378137.0, 6356752.314245179498);
+
+	/* Batched distances are the ones of the pairs on their own */
+	pa = ptarray_construct_empty(LW_FALSE, LW_FALSE, 301);
+	for (i = 0; i <= 300; i++)
+	{
+		POINT4D p = {-170.0 + i * 1.1, 80.0 * sin(i * 0.1), 0, 0};
+		ptarray_append_point(pa, &p, LW_TRUE);
+		if (i < 300)
+			point_set(p.x, p.y, &g1[i]);
+		if (i > 0)
+			point_set(p.x, p.y, &g2[i-1]);
+	}
+	spheroid_distances(g1, g2, 300, &s, d);
+	for (i = 0; i < 300; i++)
+	{
+		CU_ASSERT_EQUAL(d[i], spheroid_distance(&g1[i], &g2[i], &s));
+		length += d[i];
+	}
+
+	/* Length measures across batches without losing a segment */
+	CU_ASSERT_DOUBLE_EQUAL(ptarray_length_spheroid(pa, &s), length, 1e-6);
+	ptarray_free(pa);
+}
+
 static void test_spheroid_area(void)
 {
 	LWGEOM *lwg;
@@ -1626,6 +1661,7 @@ void geodetic_suite_setup(void)
 	PG_ADD_TEST(suite, test_lwgeom_check_geodetic);
 	PG_ADD_TEST(suite, test_gserialized_from_lwgeom);
 	PG_ADD_TEST(suite, test_spheroid_distance);
+	PG_ADD_TEST(suite, test_spheroid_distances);
 	PG_ADD_TEST(suite, test_spheroid_area);
 	PG_ADD_TEST(suite, test_lwpoly_covers_point2d);
 	PG_ADD_TEST(suite, test_gbox_utils);
@@ -367,6 +367,25 @@ static void dbscan_test_3612c(void)
 	do_dbscan_test(test);
 }
 
+static void dbscan_test_point_grid(void)
+{
+	struct dbscan_test_info test;
+	/* Neighbours exactly eps apart, far from the origin, straddling grid cells */
+	char* wkt_inputs[] = { "POINT (1000000 7)", "POINT (1000000.5 7)", "POINT (1000001 7)", "POINT EMPTY",
+		                   "POINT (1000001 7.5)", "POINT (1000003 7)" };
+
+	test.eps = 0.5;
+	test.min_points = 2;
+	uint32_t expected_ids[]   = { 0, 0, 0, rand(), 0, rand() };
+	int expected_in_cluster[] = { 1, 1, 1, 0, 1, 0 };
+	test.num_geoms = sizeof(wkt_inputs) / sizeof(char*);
+
+	test.expected_ids = expected_ids;
+	test.expected_in_cluster = expected_in_cluster;
+	test.wkt_inputs = wkt_inputs;
+	do_dbscan_test(test);
+}
+
 void geos_cluster_suite_setup(void);
 void geos_cluster_suite_setup(void)
 {
@@ -381,4 +400,5 @@ void geos_cluster_suite_setup(void)
 	PG_ADD_TEST(suite, dbscan_test_3612a);
 	PG_ADD_TEST(suite, dbscan_test_3612b);
 	PG_ADD_TEST(suite, dbscan_test_3612c);
+	PG_ADD_TEST(suite, dbscan_test_point_grid);
 }
@@ -495,6 +495,194 @@ test_gserialized2_peek_first_point(void)
 	CU_ASSERT(peek2_point_helper("POLYGON((0 0, 1 1, 1 0, 0 0))", &p) == LW_FAILURE);
 }
 
+static void test_gserialized2_quantized(void)
+{
+	LWGEOM *geom1, *geom2;
+	GSERIALIZED *g1, *g2;
+	GBOX box1, box2;
+	char *out_ewkt;
+	size_t i, size;
+
+	/* Round trips at a precision that holds the inputs exactly */
+	char *ewkt[] =
+	{
+		"POINT EMPTY",
+		"POINT(0 0.2)",
+		"SRID=4326;POINT(-71.0638213 42.3582145)",
+		"LINESTRING EMPTY",
+		"LINESTRING(-1 -1,-1 2.5,2 2,2 -1)",
+		"LINESTRING(0 0,1 1)",
+		"MULTIPOINT(0.9 0.9,0.9 0.9,EMPTY,0.9 0.9)",
+		"SRID=1;MULTILINESTRING((-1 -1,-1 2.5,2 2,2 -1),(-1 -1,-1 2.5,2 2,2 -1))",
+		"POLYGON((-1 -1,-1 2.5,2 2,2 -1,-1 -1),(0 0,0 1,1 1,1 0,0 0))",
+		"POLYGON EMPTY",
+		"SRID=100000;POLYGON((-1 -1 3,-1 2.5 3,2 2 3,2 -1 3,-1 -1 3),(0 0 3,0 1 3,1 1 3,1 0 3,0 0 3),(-0.5 -0.5 3,-0.5 -0.4 3,-0.4 -0.4 3,-0.4 -0.5 3,-0.5 -0.5 3))",
+		"SRID=4326;GEOMETRYCOLLECTION(POINT(0 1),POLYGON((-1 -1,-1 2.5,2 2,2 -1,-1 -1),(0 0,0 1,1 1,1 0,0 0)),MULTIPOLYGON(((-1 -1,-1 2.5,2 2,2 -1,-1 -1))))",
+		"SRID=4326;GEOMETRYCOLLECTION(POINT EMPTY,MULTIPOLYGON EMPTY)",
+		"MULTICURVE((5 5 1 3,3 5 2 2,3 3 3 1,0 3 1 1),CIRCULARSTRING(0 0 0 0,0.26794 1 3 -2,0.5857864 1.414213 1 2))",
+		"MULTISURFACE(CURVEPOLYGON(CIRCULARSTRING(-2 0,-1 -1,0 0,1 -1,2 0,0 2,-2 0),(-1 0,0 0.5,1 0,0 1,-1 0)),((7 8,10 10,6 14,4 11,7 8)))",
+		"POLYHEDRALSURFACE(((0 0 0,0 1 0,1 1 0,1 0 0,0 0 0)),((0 0 1,1 0 1,1 1 1,0 1 1,0 0 1)))",
+		"TIN(((0 0 0,0 0 1,0 1 0,0 0 0)),((0 0 0,0 1 0,1 1 0,0 0 0)))",
+	};
+
+	for (i = 0; i < (sizeof ewkt/sizeof(char*)); i++)
+	{
+		geom1 = lwgeom_from_wkt(ewkt[i], LW_PARSER_CHECK_NONE);
+		g1 = gserialized2_from_lwgeom_quantized(geom1, 7, 7, 7, &size);
+		g2 = gserialized2_from_lwgeom(geom1, NULL);
+		CU_ASSERT_EQUAL(LWSIZE_GET(g1->size), size);
+		CU_ASSERT(gserialized2_is_quantized(g1));
+		CU_ASSERT(!gserialized2_is_quantized(g2));
+
+		geom2 = lwgeom_from_gserialized2(g1);
+		out_ewkt = lwgeom_to_ewkt(geom2);
+		ASSERT_STRING_EQUAL(out_ewkt, ewkt[i]);
+
+		/* Metadata reads the same as for the double form */
+		CU_ASSERT_EQUAL(gserialized2_get_type(g1), gserialized2_get_type(g2));
+		CU_ASSERT_EQUAL(gserialized2_get_srid(g1), gserialized2_get_srid(g2));
+		CU_ASSERT_EQUAL(gserialized2_is_empty(g1), gserialized2_is_empty(g2));
+		CU_ASSERT_EQUAL(gserialized2_hash(g1), gserialized2_hash(g2));
+		CU_ASSERT_EQUAL(gserialized_cmp(g1, g2), 0);
+		CU_ASSERT_EQUAL(gserialized2_get_gbox_p(g1, &box1), gserialized2_get_gbox_p(g2, &box2));
+		if (!lwgeom_is_empty(geom1))
+			CU_ASSERT(gbox_same(&box1, &box2));
+
+		lwfree(out_ewkt);
+		lwfree(g1);
+		lwfree(g2);
+		lwgeom_free(geom1);
+		lwgeom_free(geom2);
+	}
+
+	/* Ordinates are snapped to the grid */
+	geom1 = lwgeom_from_wkt("LINESTRING ZM(1.23456 2.34567 1.5 123,3 4 2.5 456)", LW_PARSER_CHECK_NONE);
+	g1 = gserialized2_from_lwgeom_quantized(geom1, 2, 0, -2, NULL);
+	geom2 = lwgeom_from_gserialized2(g1);
+	out_ewkt = lwgeom_to_ewkt(geom2);
+	ASSERT_STRING_EQUAL(out_ewkt, "LINESTRING(1.23 2.35 2 100,3 4 3 500)");
+	lwfree(out_ewkt);
+	lwfree(g1);
+	lwgeom_free(geom1);
+	lwgeom_free(geom2);
+
+	/* Geodetic boxes are computed on the snapped geometry */
+	geom1 = lwgeom_from_wkt("SRID=4326;LINESTRING(-71.06382 42.35821,-71.05 42.36,-71.04 42.37)", LW_PARSER_CHECK_NONE);
+	FLAGS_SET_GEODETIC(geom1->flags, 1);
+	g1 = gserialized2_from_lwgeom_quantized(geom1, 3, 0, 0, NULL);
+	CU_ASSERT(gserialized2_is_geodetic(g1));
+	CU_ASSERT(gserialized2_has_bbox(g1));
+	geom2 = lwgeom_from_gserialized2(g1);
+	lwgeom_drop_bbox(geom2);
+	lwgeom_add_bbox(geom2);
+	CU_ASSERT(gserialized2_read_gbox_p(g1, &box1) == LW_SUCCESS);
+	CU_ASSERT(gbox_contains_2d(&box1, geom2->bbox));
+	lwfree(g1);
+	lwgeom_free(geom1);
+	lwgeom_free(geom2);
+
+	/* A point shrinks, and its box is peeked without decoding a geometry */
+	geom1 = lwgeom_from_wkt("SRID=4326;POINT(-71.0638213 42.3582145)", LW_PARSER_CHECK_NONE);
+	g1 = gserialized2_from_lwgeom_quantized(geom1, 7, 7, 7, NULL);
+	g2 = gserialized2_from_lwgeom(geom1, NULL);
+	CU_ASSERT(LWSIZE_GET(g1->size) < LWSIZE_GET(g2->size));
+	CU_ASSERT(!gserialized2_has_extended(g1));
+	CU_ASSERT(!gserialized2_has_bbox(g1));
+	CU_ASSERT(gserialized2_peek_gbox_p(g1, &box1) == LW_SUCCESS);
+	CU_ASSERT(gserialized2_peek_gbox_p(g2, &box2) == LW_SUCCESS);
+	CU_ASSERT(gbox_same(&box1, &box2));
+	lwfree(g1);
+	lwfree(g2);
+	lwgeom_free(geom1);
+
+	/* Quantized values sort as their double forms do */
+	{
+		char *order_wkt[] =
+		{
+			"LINESTRING(0 0,1 1)",
+			"LINESTRING(0 0,1 1,2 2)",
+			"LINESTRING(0 0,1 2)",
+			"POLYGON((0 0,0 1,1 1,0 0))",
+			"POLYGON((0 0,0 9,9 9,0 0),(1 1,1 2,2 2,1 1))",
+			"GEOMETRYCOLLECTION(POINT(1 1),MULTIPOINT(2 2,3 3))",
+			"POINT(0.5 0.5)"
+		};
+		size_t n = sizeof(order_wkt)/sizeof(char*), j;
+		GSERIALIZED *gd[7], *gq[7];
+		for (i = 0; i < n; i++)
+		{
+			geom1 = lwgeom_from_wkt(order_wkt[i], LW_PARSER_CHECK_NONE);
+			gd[i] = gserialized2_from_lwgeom(geom1, NULL);
+			gq[i] = gserialized2_from_lwgeom_quantized(geom1, 7, 7, 7, NULL);
+			lwgeom_free(geom1);
+		}
+		for (i = 0; i < n; i++)
+		{
+			for (j = 0; j < n; j++)
+			{
+				int cmp = gserialized_cmp(gd[i], gd[j]);
+				CU_ASSERT_EQUAL(gserialized_cmp(gq[i], gq[j]), cmp);
+				CU_ASSERT_EQUAL(gserialized_cmp(gq[i], gd[j]), cmp);
+				CU_ASSERT_EQUAL(gserialized_cmp(gd[i], gq[j]), cmp);
+			}
+		}
+		for (i = 0; i < n; i++)
+		{
+			lwfree(gd[i]);
+			lwfree(gq[i]);
+		}
+	}
+
+	/* A dense line shrinks to well under half */
+	{
+		POINTARRAY *pa = ptarray_construct_empty(LW_FALSE, LW_FALSE, 1000);
+		for (i = 0; i < 1000; i++)
+		{
+			POINT4D p = {(-7106000.0 + i * 10) / 1e5, (4235000.0 + (i % 7) * 10) / 1e5, 0, 0};
+			ptarray_append_point(pa, &p, LW_TRUE);
+		}
+		geom1 = lwline_as_lwgeom(lwline_construct(4326, NULL, pa));
+		g1 = gserialized2_from_lwgeom_quantized(geom1, 5, 0, 0, NULL);
+		g2 = gserialized2_from_lwgeom(geom1, NULL);
+		CU_ASSERT(LWSIZE_GET(g1->size) * 2 < LWSIZE_GET(g2->size));
+		geom2 = lwgeom_from_gserialized2(g1);
+		CU_ASSERT_EQUAL(lwgeom_count_vertices(geom2), 1000);
+		lwgeom_drop_bbox(geom1);
+		lwgeom_drop_bbox(geom2);
+		CU_ASSERT(lwgeom_same(geom1, geom2));
+		lwfree(g1);
+		lwfree(g2);
+		lwgeom_free(geom1);
+		lwgeom_free(geom2);
+	}
+}
+
+static void test_gserialized_payload_hash(void)
+{
+	LWGEOM *geom;
+	GSERIALIZED *g1, *g2, *g3;
+
+	/* Same coordinates hash the same, whatever the srid or box */
+	geom = lwgeom_from_wkt("SRID=4326;LINESTRING(0 0,1 1,2 2)", LW_PARSER_CHECK_NONE);
+	g1 = gserialized2_from_lwgeom(geom, NULL);
+	lwgeom_add_bbox(geom);
+	lwgeom_set_srid(geom, 3857);
+	g2 = gserialized2_from_lwgeom(geom, NULL);
+	CU_ASSERT(gserialized2_has_bbox(g2));
+	CU_ASSERT_EQUAL(gserialized_payload_hash(g1), gserialized_payload_hash(g2));
+	lwgeom_free(geom);
+
+	/* Moving an interior vertex keeps count and box, but not the hash */
+	geom = lwgeom_from_wkt("SRID=4326;LINESTRING(0 0,1 0.5,2 2)", LW_PARSER_CHECK_NONE);
+	g3 = gserialized2_from_lwgeom(geom, NULL);
+	CU_ASSERT_NOT_EQUAL(gserialized_payload_hash(g1), gserialized_payload_hash(g3));
+	lwgeom_free(geom);
+
+	lwfree(g1);
+	lwfree(g2);
+	lwfree(g3);
+}
+
 /*
 ** Used by test harness to register the tests in this file.
 */
@@ -513,4 +701,6 @@ void gserialized2_suite_setup(void)
 	PG_ADD_TEST(suite, test_gserialized2_peek_gbox_p_fails_for_unsupported_cases);
 	PG_ADD_TEST(suite, test_gserialized2_extended_flags);
 	PG_ADD_TEST(suite, test_gserialized2_peek_first_point);
+	PG_ADD_TEST(suite, test_gserialized2_quantized);
+	PG_ADD_TEST(suite, test_gserialized_payload_hash);
 }
@@ -421,6 +421,67 @@ static void test_wkt_leak(void)
 	lwfree(err);
 }
 
+static void test_wkt_in_fast(void)
+{
+	/* Inputs the hand-written parser handles, with their expected output */
+	const char *ok[][2] = {
+		{"POINT(1 2)", "POINT(1 2)"},
+		{"  point z (1 2 3)  ", "POINT Z (1 2 3)"},
+		{"POINTM(1 2 3)", "POINT M (1 2 3)"},
+		{"SRID=4326;POINT(1e2 -2.5E-1)", "POINT(100 -0.25)"},
+		{"POINT(.5 1.)", "POINT(0.5 1)"},
+		{"POINT ZM EMPTY", "POINT ZM EMPTY"},
+		{"LINESTRING(0 0,\n1 1,\t2 2)", "LINESTRING(0 0,1 1,2 2)"},
+		{"POLYGON((0 0,1 0,1 1,0 0),(0.1 0.1,0.2 0.1,0.2 0.2,0.1 0.1))",
+		 "POLYGON((0 0,1 0,1 1,0 0),(0.1 0.1,0.2 0.1,0.2 0.2,0.1 0.1))"},
+		{"MULTIPOINT((1 2),3 4)", "MULTIPOINT(1 2,3 4)"},
+		{"MULTILINESTRING M ((0 0 1,1 1 2))", "MULTILINESTRING M ((0 0 1,1 1 2))"},
+		{"MULTIPOLYGON(((0 0,1 0,1 1,0 0)),((5 5,6 5,6 6,5 5)))",
+		 "MULTIPOLYGON(((0 0,1 0,1 1,0 0)),((5 5,6 5,6 6,5 5)))"},
+		{"MULTIPOLYGON EMPTY", "MULTIPOLYGON EMPTY"}
+	};
+	/* Inputs that must still reach the grammar for their error */
+	const char *err[][2] = {
+		{"POINT Z (1 2)", "can not mix dimensionality in a geometry"},
+		{"LINESTRING(0 0,1 1 1)", "can not mix dimensionality in a geometry"},
+		{"LINESTRING(0 0)", "geometry requires more points"},
+		{"POLYGON((0 0,1 0,1 1,0 1))", "geometry contains non-closed rings"},
+		{"POINT(1 2,3 4)", "geometry has too many points"},
+		{"POINT(1.e5 2)", "parse error - invalid geometry"},
+		{"POINT(1 2) foobar", "parse error - invalid geometry"}
+	};
+	LWGEOM_PARSER_RESULT p;
+	size_t i;
+
+	for ( i = 0; i < sizeof(ok) / sizeof(ok[0]); i++ )
+	{
+		char *s;
+		CU_ASSERT_EQUAL(lwgeom_parse_wkt(&p, (char*)ok[i][0], LW_PARSER_CHECK_ALL), LW_SUCCESS);
+		s = lwgeom_to_wkt(p.geom, WKT_ISO, 15, NULL);
+		ASSERT_STRING_EQUAL(s, ok[i][1]);
+		lwfree(s);
+		lwgeom_parser_result_free(&p);
+	}
+
+	for ( i = 0; i < sizeof(err) / sizeof(err[0]); i++ )
+	{
+		CU_ASSERT_EQUAL(lwgeom_parse_wkt(&p, (char*)err[i][0], LW_PARSER_CHECK_ALL), LW_FAILURE);
+		CU_ASSERT(!p.geom);
+		ASSERT_STRING_EQUAL(p.message, err[i][1]);
+		lwgeom_parser_result_free(&p);
+	}
+
+	CU_ASSERT_EQUAL(lwgeom_parse_wkt(&p, "SRID=4326;POINT(1 2)", LW_PARSER_CHECK_ALL), LW_SUCCESS);
+	ASSERT_INT_EQUAL(p.geom->srid, 4326);
+	lwgeom_parser_result_free(&p);
+
+	/* Values outside the exact fast conversion range still round like strtod */
+	CU_ASSERT_EQUAL(lwgeom_parse_wkt(&p, "POINT(9007199254740993 1e-300)", LW_PARSER_CHECK_ALL), LW_SUCCESS);
+	ASSERT_DOUBLE_EQUAL(lwpoint_get_x(lwgeom_as_lwpoint(p.geom)), strtod("9007199254740993", NULL));
+	ASSERT_DOUBLE_EQUAL(lwpoint_get_y(lwgeom_as_lwpoint(p.geom)), strtod("1e-300", NULL));
+	lwgeom_parser_result_free(&p);
+}
+
 /*
 ** Used by test harness to register the tests in this file.
 */
@@ -445,4 +506,5 @@ void wkt_in_suite_setup(void)
 	PG_ADD_TEST(suite, test_wkt_in_errlocation);
 	PG_ADD_TEST(suite, test_wkt_double);
 	PG_ADD_TEST(suite, test_wkt_leak);
+	PG_ADD_TEST(suite, test_wkt_in_fast);
 }
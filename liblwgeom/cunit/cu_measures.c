@@ -641,6 +641,43 @@ test_rect_tree_distance_tree(void)
 	TDT(wkt, "POLYGON((5 5,5 5.5,5.5 5.5,5.5 5, 5 5))", 0.5);
 }
 
+/*
+* Trees several levels deep, so the search stack has to
+* grow, checked against the brute force distance.
+*/
+static void
+test_rect_tree_distance_tree_deep(void)
+{
+	uint32_t i, npoints = 5000;
+	POINTARRAY *pa1 = ptarray_construct_empty(0, 0, npoints);
+	POINTARRAY *pa2 = ptarray_construct_empty(0, 0, npoints);
+	LWGEOM *lw1, *lw2;
+	RECT_NODE *n1, *n2;
+	double d;
+
+	for (i = 0; i < npoints; i++)
+	{
+		POINT4D p = {i, 10 * sin(i * 0.01), 0, 0};
+		POINT4D q = {i + 0.5, 25 + 10 * cos(i * 0.013), 0, 0};
+		ptarray_append_point(pa1, &p, LW_TRUE);
+		ptarray_append_point(pa2, &q, LW_TRUE);
+	}
+	lw1 = lwline_as_lwgeom(lwline_construct(SRID_UNKNOWN, NULL, pa1));
+	lw2 = lwline_as_lwgeom(lwline_construct(SRID_UNKNOWN, NULL, pa2));
+	d = lwgeom_mindistance2d(lw1, lw2);
+
+	n1 = rect_tree_from_lwgeom(lw1);
+	n2 = rect_tree_from_lwgeom(lw2);
+	CU_ASSERT_DOUBLE_EQUAL(rect_tree_distance_tree(n1, n2, 0.0), d, 0.00001);
+	/* Threshold above the distance stops at the first pair under it */
+	CU_ASSERT(rect_tree_distance_tree(n1, n2, d + 1.0) < d + 1.0);
+	rect_tree_free(n1);
+	rect_tree_free(n2);
+
+	lwgeom_free(lw1);
+	lwgeom_free(lw2);
+}
+
 
 static void
 test_lwgeom_segmentize2d(void)
@@ -1542,6 +1579,79 @@ test_lwgeom_is_trajectory(void)
 	ASSERT_INT_EQUAL(ret, LW_TRUE); /* ok (corner case) */
 }
 
+static void
+test_lw_dist2d_ptarray_blocks(void)
+{
+	/* Long zig-zags, so most blocks of segments are pruned */
+	POINTARRAY *pa = ptarray_construct(1, 0, 300);
+	POINTARRAY *pb = ptarray_construct(0, 0, 200);
+	POINT4D pt;
+	POINT2D p;
+	DISTPTS dl, dr;
+	const POINT2D *A, *B;
+	uint32_t i, j;
+	int twist;
+
+	for (i = 0; i < pa->npoints; i++)
+	{
+		pt.x = i;
+		pt.y = (i % 2) ? 1.0 : -1.0;
+		pt.z = i;
+		ptarray_set_point4d(pa, i, &pt);
+	}
+	for (i = 0; i < pb->npoints; i++)
+	{
+		pt.x = 0.5 * i + 0.25;
+		pt.y = 5.0 + ((i % 3) ? 0.5 : 1.5) - (i == 173 ? 2.75 : 0.0);
+		ptarray_set_point4d(pb, i, &pt);
+	}
+
+	/* Point near the end of the line, compared with the plain scan */
+	p.x = 250.3;
+	p.y = 2.5;
+	lw_dist2d_distpts_init(&dl, DIST_MIN);
+	lw_dist2d_pt_ptarray(&p, pa, &dl);
+	lw_dist2d_distpts_init(&dr, DIST_MIN);
+	lw_dist2d_pt_pt(&p, getPoint2d_cp(pa, 0), &dr);
+	for (i = 1; i < pa->npoints; i++)
+		lw_dist2d_pt_seg(&p, getPoint2d_cp(pa, i - 1), getPoint2d_cp(pa, i), &dr);
+	CU_ASSERT_EQUAL(dl.distance, dr.distance);
+	CU_ASSERT_EQUAL(dl.p1.x, dr.p1.x);
+	CU_ASSERT_EQUAL(dl.p1.y, dr.p1.y);
+	CU_ASSERT_EQUAL(dl.p2.x, dr.p2.x);
+	CU_ASSERT_EQUAL(dl.p2.y, dr.p2.y);
+
+	/* Tolerance still stops at the first segment close enough */
+	lw_dist2d_distpts_init(&dl, DIST_MIN);
+	dl.tolerance = 2.0;
+	lw_dist2d_pt_ptarray(&p, pa, &dl);
+	CU_ASSERT(dl.distance <= 2.0);
+
+	/* Line against line, with the closest pair in a late block */
+	lw_dist2d_distpts_init(&dl, DIST_MIN);
+	lw_dist2d_ptarray_ptarray(pa, pb, &dl);
+	lw_dist2d_distpts_init(&dr, DIST_MIN);
+	twist = dr.twisted;
+	for (i = 1; i < pa->npoints; i++)
+	{
+		A = getPoint2d_cp(pa, i - 1);
+		B = getPoint2d_cp(pa, i);
+		for (j = 1; j < pb->npoints; j++)
+		{
+			dr.twisted = twist;
+			lw_dist2d_seg_seg(A, B, getPoint2d_cp(pb, j - 1), getPoint2d_cp(pb, j), &dr);
+		}
+	}
+	CU_ASSERT_EQUAL(dl.distance, dr.distance);
+	CU_ASSERT_EQUAL(dl.p1.x, dr.p1.x);
+	CU_ASSERT_EQUAL(dl.p1.y, dr.p1.y);
+	CU_ASSERT_EQUAL(dl.p2.x, dr.p2.x);
+	CU_ASSERT_EQUAL(dl.p2.y, dr.p2.y);
+
+	ptarray_free(pa);
+	ptarray_free(pb);
+}
+
 /*
 ** Used by test harness to register the tests in this file.
 */
@@ -1561,7 +1671,9 @@ void measures_suite_setup(void)
 	PG_ADD_TEST(suite, test_lw_arc_length);
 	PG_ADD_TEST(suite, test_lw_dist2d_pt_ptarrayarc);
 	PG_ADD_TEST(suite, test_lw_dist2d_ptarray_ptarrayarc);
+	PG_ADD_TEST(suite, test_lw_dist2d_ptarray_blocks);
 	PG_ADD_TEST(suite, test_lwgeom_tcpa);
 	PG_ADD_TEST(suite, test_lwgeom_is_trajectory);
 	PG_ADD_TEST(suite, test_rect_tree_distance_tree);
+	PG_ADD_TEST(suite, test_rect_tree_distance_tree_deep);
 }
@@ -269,6 +269,117 @@ static void test_twkb_out_idlist(void)
 
 }
 
+/*
+** Stream the inputs through the TWKB aggregate, split in two partial
+** states at every position, and compare with the array encoding
+*/
+static void cu_twkb_agg(const char **wkt, uint32_t n, int8_t prec, uint8_t variant)
+{
+	LWCOLLECTION *col = NULL;
+	int64_t idlist[16];
+	uint8_t subtype = 0;
+	int is_homogeneous = LW_TRUE;
+	lwvarlena_t *twkb;
+	char *expected;
+	uint32_t i, split;
+
+	for ( i = 0; i < n; i++ )
+	{
+		LWGEOM *g = lwgeom_from_wkt(wkt[i], LW_PARSER_CHECK_NONE);
+		if ( ! col )
+			col = lwcollection_construct_empty(COLLECTIONTYPE, SRID_UNKNOWN, lwgeom_has_z(g), lwgeom_has_m(g));
+		if ( subtype && g->type != subtype )
+			is_homogeneous = LW_FALSE;
+		subtype = g->type;
+		lwcollection_add_lwgeom(col, g);
+		idlist[i] = 10 * i + 1;
+	}
+	if ( is_homogeneous )
+		col->type = lwtype_get_collectiontype(subtype);
+
+	twkb = lwgeom_to_twkb_with_idlist(lwcollection_as_lwgeom(col), (variant & TWKB_ID) ? idlist : NULL,
+	                                  variant, prec, prec, prec);
+	expected = hexbytes_from_bytes((uint8_t *)twkb->data, LWSIZE_GET(twkb->size) - LWVARHDRSZ);
+	lwfree(twkb);
+
+	for ( split = 0; split <= n; split++ )
+	{
+		TWKB_AGG_STATE *s1 = twkb_agg_init(variant, prec, prec, prec);
+		TWKB_AGG_STATE *s2 = twkb_agg_init(variant, prec, prec, prec);
+
+		for ( i = 0; i < n; i++ )
+			twkb_agg_add(i < split ? s1 : s2, col->geoms[i], idlist[i]);
+
+		/* Every other partial state goes through serialization */
+		if ( split % 2 )
+		{
+			lwvarlena_t *v = twkb_agg_serialize(s2);
+			twkb_agg_free(s2);
+			s2 = twkb_agg_deserialize((uint8_t *)v->data, LWSIZE_GET(v->size) - LWVARHDRSZ);
+			lwfree(v);
+		}
+
+		twkb = twkb_agg_finalize(twkb_agg_combine(s1, s2));
+		if ( s ) free(s);
+		s = hexbytes_from_bytes((uint8_t *)twkb->data, LWSIZE_GET(twkb->size) - LWVARHDRSZ);
+		lwfree(twkb);
+		twkb_agg_free(s1);
+		twkb_agg_free(s2);
+
+		CU_ASSERT_STRING_EQUAL(s, expected);
+	}
+
+	lwfree(expected);
+	lwcollection_free(col);
+}
+
+static void test_twkb_out_agg(void)
+{
+	const char *points[] = {"POINT(1 1)", "POINT(0 0)"};
+	const char *points_empty[] = {"POINT(1 1)", "POINT EMPTY", "POINT(2 3)", "POINT(2 3)", "POINT EMPTY", "POINT(-5 7)"};
+	const char *empties[] = {"POINT EMPTY", "POINT EMPTY"};
+	const char *lines[] = {"LINESTRING EMPTY", "LINESTRING(0 0,1 1)", "LINESTRING(5 5,5 5,6 6)", "LINESTRING(6 6,0 -1)"};
+	const char *polys[] = {"POLYGON((0 0 1,0 1 1,1 1 1,0 0 1))", "POLYGON Z EMPTY", "POLYGON((5 5 0,5 6 0,6 6 0,5 5 0),(5.2 5.5 0,5.3 5.5 0,5.3 5.6 0,5.2 5.5 0))"};
+	const char *mixed[] = {"POINT(1 1)", "POINT EMPTY", "POINT(2 2)", "LINESTRING(1 1,2 2)", "POINT(3 3)", "GEOMETRYCOLLECTION(POINT(4 4))"};
+	const char *collections[] = {"GEOMETRYCOLLECTION(POINT(1 1))", "MULTIPOINT(2 2,3 3)", "TRIANGLE((0 0,0 1,1 1,0 0))"};
+	uint8_t variants[] = {0, TWKB_ID, TWKB_ID | TWKB_SIZE | TWKB_BBOX, TWKB_SIZE | TWKB_BBOX};
+	uint32_t i;
+	TWKB_AGG_STATE *state;
+	lwvarlena_t *twkb;
+	LWGEOM *g;
+
+	/* Inputs of one type are deltas from the previous input */
+	state = twkb_agg_init(TWKB_ID, 0, 0, 0);
+	g = lwgeom_from_wkt(points[0], LW_PARSER_CHECK_NONE);
+	twkb_agg_add(state, g, 2);
+	lwgeom_free(g);
+	g = lwgeom_from_wkt(points[1], LW_PARSER_CHECK_NONE);
+	twkb_agg_add(state, g, 4);
+	lwgeom_free(g);
+	twkb = twkb_agg_finalize(state);
+	if ( s ) free(s);
+	s = hexbytes_from_bytes((uint8_t *)twkb->data, LWSIZE_GET(twkb->size) - LWVARHDRSZ);
+	CU_ASSERT_STRING_EQUAL(s, "040402040802020101");
+	lwfree(twkb);
+	twkb_agg_free(state);
+
+	/* Nothing added, nothing to return */
+	state = twkb_agg_init(0, 0, 0, 0);
+	CU_ASSERT_PTR_NULL(twkb_agg_finalize(state));
+	twkb_agg_free(state);
+
+	for ( i = 0; i < sizeof(variants); i++ )
+	{
+		cu_twkb_agg(points, 2, 0, variants[i]);
+		cu_twkb_agg(points_empty, 6, 0, variants[i]);
+		cu_twkb_agg(empties, 2, 0, variants[i]);
+		cu_twkb_agg(lines, 4, 0, variants[i]);
+		cu_twkb_agg(polys, 3, 1, variants[i]);
+		cu_twkb_agg(mixed, 6, 0, variants[i]);
+		cu_twkb_agg(collections, 3, -1, variants[i]);
+	}
+}
+
 
 /*
 ** Used by test harness to register the tests in this file.
@@ -285,4 +396,5 @@ void twkb_out_suite_setup(void)
 	PG_ADD_TEST(suite, test_twkb_out_multipolygon);
 	PG_ADD_TEST(suite, test_twkb_out_collection);
 	PG_ADD_TEST(suite, test_twkb_out_idlist);
+	PG_ADD_TEST(suite, test_twkb_out_agg);
 }
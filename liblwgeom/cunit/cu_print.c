@@ -561,6 +561,71 @@ test_lwprint_roundtrip(void)
 	 */
 }
 
+static void
+test_lwprint_ptarray(void)
+{
+	/* Values that exercise the integral, fixed and scientific paths */
+	static const double values[] = {
+	    0, -0.0, 1, -1, 2.5, 1234567, -99999999999999, 1e15, 0.3, -149.57565307617187,
+	    1e-9, 7000109.9999999990686774253845214843750000000000, 9e300, 4503599627370497.0, -8};
+	static const int opts[] = {0,
+				   LWPRINT_ORDSEP_COMMA | LWPRINT_BRACKETS,
+				   LWPRINT_ORDSEP_COMMA | LWPRINT_PTSEP_SPACE,
+				   LWPRINT_PTSEP_SPACE | LWPRINT_FLIP_XY};
+	const uint32_t nvalues = sizeof(values) / sizeof(double);
+	POINTARRAY *pa = ptarray_construct(1, 0, nvalues / 3);
+	char *out = lwalloc(OUT_MAX_BYTES_PTARRAY(pa->npoints, 3));
+	char *exp = lwalloc(OUT_MAX_BYTES_PTARRAY(pa->npoints, 3));
+	uint32_t i, j, o;
+
+	memcpy(pa->serialized_pointlist, values, pa->npoints * 3 * sizeof(double));
+
+	for (o = 0; o < sizeof(opts) / sizeof(int); o++)
+	{
+		for (int precision = 0; precision < OUT_MAX_DIGITS + 2; precision += 3)
+		{
+			for (uint32_t dims = 2; dims <= 3; dims++)
+			{
+				char *ptr = exp;
+				size_t len = lwprint_ptarray(pa, pa->npoints, dims, precision, opts[o], out);
+
+				/* Build the expected text with one lwprint_double call per ordinate */
+				for (i = 0; i < pa->npoints; i++)
+				{
+					const double *d = (const double *)getPoint_internal(pa, i);
+					if (i)
+						*ptr++ = (opts[o] & LWPRINT_PTSEP_SPACE) ? ' ' : ',';
+					if (opts[o] & LWPRINT_BRACKETS)
+						*ptr++ = '[';
+					for (j = 0; j < dims; j++)
+					{
+						uint32_t k = j;
+						if ((opts[o] & LWPRINT_FLIP_XY) && j < 2)
+							k = 1 - j;
+						if (j)
+							*ptr++ = (opts[o] & LWPRINT_ORDSEP_COMMA) ? ',' : ' ';
+						ptr += lwprint_double(d[k], precision, ptr);
+					}
+					if (opts[o] & LWPRINT_BRACKETS)
+						*ptr++ = ']';
+				}
+				*ptr = '\0';
+
+				ASSERT_STRING_EQUAL(out, exp);
+				ASSERT_INT_EQUAL((int)len, (int)strlen(exp));
+			}
+		}
+	}
+
+	/* Only the requested number of points is written */
+	lwprint_ptarray(pa, 1, 2, 15, 0, out);
+	ASSERT_STRING_EQUAL(out, "0 0");
+
+	lwfree(out);
+	lwfree(exp);
+	ptarray_free(pa);
+}
+
 /*
 ** Callback used by the test harness to register the tests in this file.
 */
@@ -575,5 +640,6 @@ void print_suite_setup(void)
 	PG_ADD_TEST(suite, test_lwpoint_to_latlon_bad_formats);
 	PG_ADD_TEST(suite, test_lwprint);
 	PG_ADD_TEST(suite, test_lwprint_roundtrip);
+	PG_ADD_TEST(suite, test_lwprint_ptarray);
 }
 
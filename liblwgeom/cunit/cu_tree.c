@@ -419,6 +419,76 @@ static void test_tree_circ_distance_threshold(void)
 
 }
 
+static void test_tree_circ_bytes(void)
+{
+	const char *wkt[] = {
+		"POINT(-69.83262 43.43636)",
+		"LINESTRING(0 0,1 1,1 1,2 0,3 1)",
+		"POLYGON((0 0,0 10,10 10,10 0,0 0),(2 2,4 2,4 4,2 2))",
+		"MULTIPOLYGON(((0 0,0 1,1 1,0 0)),((20 20,20 21,21 21,20 20)))",
+		"GEOMETRYCOLLECTION(POINT(5 5),LINESTRING(-10 -10,-9 -8,-7 -9))"
+	};
+	LWGEOM *lwpt = lwgeom_from_wkt("LINESTRING(-30 -30,-25 -25)", LW_PARSER_CHECK_NONE);
+	CIRC_NODE *cpt = lwgeom_calculate_circ_tree(lwpt);
+	SPHEROID s;
+	uint32_t i;
+
+	spheroid_init(&s, WGS84_MAJOR_AXIS, WGS84_MINOR_AXIS);
+
+	for ( i = 0; i < sizeof(wkt)/sizeof(char*); i++ )
+	{
+		LWGEOM *lwg = lwgeom_from_wkt(wkt[i], LW_PARSER_CHECK_NONE);
+		CIRC_NODE *c1 = lwgeom_calculate_circ_tree(lwg);
+		CIRC_NODE *c2;
+		POINTARRAY *pa, *pa_bad;
+		uint8_t *b1, *b2;
+		size_t size1, size2;
+		POINT2D p1, p2;
+		uint64_t hash = 0x0123456789abcdefULL + i;
+
+		b1 = circ_tree_to_bytes(c1, hash, &size1);
+		c2 = circ_tree_from_bytes(b1, size1, hash, &pa);
+		CU_ASSERT_PTR_NOT_NULL_FATAL(c2);
+
+		/* Round trip is stable, as long as no search has reordered the children */
+		b2 = circ_tree_to_bytes(c2, hash, &size2);
+		CU_ASSERT_EQUAL(size1, size2);
+		CU_ASSERT(memcmp(b1, b2, size1) == 0);
+
+		/* Same answers from the rebuilt tree */
+		CU_ASSERT_DOUBLE_EQUAL(circ_tree_distance_tree(c1, cpt, &s, 0.0),
+		                       circ_tree_distance_tree(c2, cpt, &s, 0.0), 1e-9);
+		circ_tree_get_point(c1, &p1);
+		circ_tree_get_point(c2, &p2);
+		CU_ASSERT_EQUAL(p1.x, p2.x);
+		CU_ASSERT_EQUAL(p1.y, p2.y);
+		CU_ASSERT_EQUAL(c1->geom_type, c2->geom_type);
+		CU_ASSERT_EQUAL(c1->pt_outside.x, c2->pt_outside.x);
+
+		/* Truncated input is refused */
+		cu_error_msg_reset();
+		CU_ASSERT_PTR_NULL(circ_tree_from_bytes(b1, size1 - 8, hash, &pa_bad));
+		CU_ASSERT_PTR_NULL(pa_bad);
+		CU_ASSERT_STRING_EQUAL(cu_error_msg, "circ_tree_from_bytes: tree size does not match its header");
+
+		/* So is a tree from another geometry */
+		cu_error_msg_reset();
+		CU_ASSERT_PTR_NULL(circ_tree_from_bytes(b1, size1, hash ^ 1, &pa_bad));
+		CU_ASSERT_PTR_NULL(pa_bad);
+		CU_ASSERT_STRING_EQUAL(cu_error_msg, "circ_tree_from_bytes: tree was built from a different geometry");
+
+		lwfree(b1);
+		lwfree(b2);
+		circ_tree_free(c1);
+		circ_tree_free(c2);
+		ptarray_free(pa);
+		lwgeom_free(lwg);
+	}
+
+	circ_tree_free(cpt);
+	lwgeom_free(lwpt);
+}
+
 /*
 ** Used by test harness to register the tests in this file.
 */
@@ -431,4 +501,5 @@ void tree_suite_setup(void)
 	PG_ADD_TEST(suite, test_tree_circ_pip2);
 	PG_ADD_TEST(suite, test_tree_circ_distance);
 	PG_ADD_TEST(suite, test_tree_circ_distance_threshold);
+	PG_ADD_TEST(suite, test_tree_circ_bytes);
 }
@@ -224,6 +224,26 @@ GSERIALIZED* gserialized_from_lwgeom(LWGEOM *geom, size_t *size)
 	return gserialized2_from_lwgeom(geom, size);
 }
 
+/**
+* Allocate a new #GSERIALIZED from an #LWGEOM, storing the ordinates as
+* integers on a decimal grid of the given precisions instead of doubles.
+*/
+GSERIALIZED* gserialized_from_lwgeom_quantized(LWGEOM *geom, int8_t prec_xy, int8_t prec_z, int8_t prec_m, size_t *size)
+{
+	return gserialized2_from_lwgeom_quantized(geom, prec_xy, prec_z, prec_m, size);
+}
+
+/**
+* Check if a #GSERIALIZED stores quantized ordinates.
+*/
+int gserialized_is_quantized(const GSERIALIZED *g)
+{
+	if (GFLAGS_GET_VERSION(g->gflags))
+		return gserialized2_is_quantized(g);
+	else
+		return LW_FALSE;
+}
+
 /**
 * Return the memory size a GSERIALIZED will occupy for a given LWGEOM.
 */
@@ -300,6 +320,25 @@ inline static size_t gserialized_header_size(const GSERIALIZED *g)
 	return sz;
 }
 
+/* Prototype for lookup3.c */
+void hashlittle2(const void *key, size_t length, uint32_t *pc, uint32_t *pb);
+
+/**
+* Returns a 64-bit hash of the type/coordinate part of the
+* GSERIALIZED, read in place without deserializing it. Unlike
+* gserialized_hash the srid is left out and the bytes are hashed
+* exactly as stored.
+*/
+uint64_t
+gserialized_payload_hash(const GSERIALIZED *g)
+{
+	size_t hsz = gserialized_header_size(g);
+	uint32_t pc = 0, pb = 0;
+
+	hashlittle2((const uint8_t *)g + hsz, LWSIZE_GET(g->size) - hsz, &pc, &pb);
+	return ((uint64_t)pc << 32) | pb;
+}
+
 inline static int gserialized_cmp_srid(const GSERIALIZED *g1, const GSERIALIZED *g2)
 {
 	return (
@@ -323,16 +362,23 @@ int gserialized_cmp(const GSERIALIZED *g1, const GSERIALIZED *g2)
 	size_t bsz1 = sz1 - hsz1;
 	size_t bsz2 = sz2 - hsz2;
 	size_t bsz_min = bsz1 < bsz2 ? bsz1 : bsz2;
+	int cmp;
 
 	/* Equality fast path */
 	/* Return equality for perfect equality only */
 	int cmp_srid = gserialized_cmp_srid(g1, g2);
-	int cmp = memcmp(b1, b2, bsz_min);
 	int g1hasz = gserialized_has_z(g1);
 	int g1hasm = gserialized_has_m(g1);
 	int g2hasz = gserialized_has_z(g2);
 	int g2hasm = gserialized_has_m(g2);
 
+	/* Quantized ordinates compare as their double form, so that */
+	/* equal geometries compare equal however they are stored */
+	if (gserialized_is_quantized(g1) || gserialized_is_quantized(g2))
+		cmp = gserialized2_cmp_data(g1, b1, &bsz1, g2, b2, &bsz2);
+	else
+		cmp = memcmp(b1, b2, bsz_min);
+
 	if (bsz1 == bsz2 && cmp_srid == 0 && cmp == 0 && g1hasz == g2hasz && g1hasm == g2hasm)
 		return 0;
 	else
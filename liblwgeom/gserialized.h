@@ -77,6 +77,13 @@ extern uint32_t gserialized_max_header_size(void);
 */
 extern int32_t gserialized_hash(const GSERIALIZED *g);
 
+/**
+* Returns a 64-bit hash of the type/coordinate part of the
+* GSERIALIZED, read in place. Changes whenever any stored
+* ordinate changes.
+*/
+extern uint64_t gserialized_payload_hash(const GSERIALIZED *g);
+
 /**
 * Extract the SRID from the serialized form (it is packed into
 * three bytes so this is a handy function).
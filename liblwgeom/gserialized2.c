@@ -46,6 +46,7 @@
 #include "lwgeom_log.h"
 #include "lwgeodetic.h"
 #include "gserialized2.h"
+#include "varint.h"
 
 #include <stddef.h>
 
@@ -155,6 +156,11 @@ int gserialized2_has_extended(const GSERIALIZED *g)
 	return G2FLAGS_GET_EXTENDED(g->gflags);
 }
 
+int gserialized2_is_quantized(const GSERIALIZED *g)
+{
+	return G2FLAGS_GET_QUANTIZED(g->gflags);
+}
+
 int gserialized2_has_z(const GSERIALIZED *g)
 {
 	return G2FLAGS_GET_Z(g->gflags);
@@ -185,7 +191,8 @@ uint32_t gserialized2_max_header_size(void)
 uint32_t gserialized2_get_type(const GSERIALIZED *g)
 {
 	uint8_t *ptr = gserialized2_get_geometry_p(g);
-	return *((uint32_t*)(ptr));
+	/* Quantized serializations keep their grid in the upper bytes */
+	return G2_TYPE_WORD_GET_TYPE(*((uint32_t*)(ptr)));
 }
 
 int32_t gserialized2_get_srid(const GSERIALIZED *g)
@@ -229,6 +236,7 @@ static size_t gserialized2_is_empty_recurse(const uint8_t *p, int *isempty)
 
 	memcpy(&type, p, 4);
 	memcpy(&num, p+4, 4);
+	type = G2_TYPE_WORD_GET_TYPE(type);
 
 	if (lwtype_is_collection(type))
 	{
@@ -265,21 +273,32 @@ int gserialized2_is_empty(const GSERIALIZED *g)
 /* pb = IN: secondary initval, OUT: secondary hash */
 void hashlittle2(const void *key, size_t length, uint32_t *pc, uint32_t *pb);
 
+static int32_t gserialized2_quant_hash(const GSERIALIZED *g);
+
 int32_t
 gserialized2_hash(const GSERIALIZED *g1)
 {
 	int32_t hval;
 	int32_t pb = 0, pc = 0;
+	size_t hsz1, sz1, bsz1, bsz2;
+	uint8_t *b1, *b2;
+	int32_t srid;
+
+	/* Quantized ordinates hash as their double form, so that */
+	/* equal geometries hash the same however they are stored */
+	if (gserialized2_is_quantized(g1))
+		return gserialized2_quant_hash(g1);
+
 	/* Point to just the type/coordinate part of buffer */
-	size_t hsz1 = gserialized2_header_size(g1);
-	uint8_t *b1 = (uint8_t *)g1 + hsz1;
+	hsz1 = gserialized2_header_size(g1);
+	b1 = (uint8_t *)g1 + hsz1;
 	/* Calculate size of type/coordinate buffer */
-	size_t sz1 = LWSIZE_GET(g1->size);
-	size_t bsz1 = sz1 - hsz1;
+	sz1 = LWSIZE_GET(g1->size);
+	bsz1 = sz1 - hsz1;
 	/* Calculate size of srid/type/coordinate buffer */
-	int32_t srid = gserialized2_get_srid(g1);
-	size_t bsz2 = bsz1 + sizeof(int);
-	uint8_t *b2 = lwalloc(bsz2);
+	srid = gserialized2_get_srid(g1);
+	bsz2 = bsz1 + sizeof(int);
+	b2 = lwalloc(bsz2);
 	/* Copy srid into front of combined buffer */
 	memcpy(b2, &srid, sizeof(int));
 	/* Copy type/coordinates into rest of combined buffer */
@@ -353,6 +372,8 @@ int gserialized2_read_gbox_p(const GSERIALIZED *g, GBOX *gbox)
 	return LW_FAILURE;
 }
 
+static void gserialized2_quant_peek_point(const GSERIALIZED *g, POINT4D *out_point);
+
 /*
 * Populate a bounding box *without* allocating an LWGEOM. Useful
 * for some performance purposes.
@@ -371,6 +392,25 @@ gserialized2_peek_gbox_p(const GSERIALIZED *g, GBOX *gbox)
 		return LW_FAILURE;
 	}
 
+	/* Quantized serializations only come without a box for points, */
+	/* whose ordinates are decoded in place */
+	if (G2FLAGS_GET_QUANTIZED(g->gflags))
+	{
+		POINT4D pt;
+		if (type != POINTTYPE || iptr[1] == 0)
+			return LW_FAILURE;
+		gserialized2_quant_peek_point(g, &pt);
+		gbox->xmin = gbox->xmax = pt.x;
+		gbox->ymin = gbox->ymax = pt.y;
+		gbox->flags = gserialized2_get_lwflags(g);
+		if (G2FLAGS_GET_Z(g->gflags))
+			gbox->zmin = gbox->zmax = pt.z;
+		if (G2FLAGS_GET_M(g->gflags))
+			gbox->mmin = gbox->mmax = pt.m;
+		gbox_float_round(gbox);
+		return LW_SUCCESS;
+	}
+
 	/* Boxes of points are easy peasy */
 	if (type == POINTTYPE)
 	{
@@ -556,7 +596,14 @@ gserialized2_peek_first_point(const GSERIALIZED *g, POINT4D *out_point)
 		return LW_FAILURE;
 	}
 
-	uint32_t type = (((uint32_t *)geometry_start)[0]);
+	uint32_t type = G2_TYPE_WORD_GET_TYPE(((uint32_t *)geometry_start)[0]);
+
+	if (G2FLAGS_GET_QUANTIZED(g->gflags) && type == POINTTYPE)
+	{
+		gserialized2_quant_peek_point(g, out_point);
+		return LW_SUCCESS;
+	}
+
 	/* Setup double_array_start depending on the geometry type */
 	double *double_array_start = NULL;
 	switch (type)
@@ -1201,6 +1248,682 @@ GSERIALIZED* gserialized2_from_lwgeom(LWGEOM *geom, size_t *size)
 	return g;
 }
 
+/***********************************************************************
+* Quantized serialization.
+*
+* The layout is the one of the double serialization, with the type and
+* count words in the same places (so type, emptiness and box access are
+* unchanged), except that rings counts are not padded and every point
+* array is written as zigzag varints of the differences between
+* consecutive grid coordinates. The differences run across the whole
+* geometry, so each part starts from the last point of the previous one.
+*/
+
+/* Largest grid coordinate that can be delta encoded without overflow */
+#define G2_QUANT_MAX 4.0e18
+
+typedef struct
+{
+	uint8_t *ptr;
+	const uint8_t *end;
+	double factor[4];
+	int64_t last[4];
+	int64_t min[4];
+	int64_t max[4];
+	uint32_t ndims;
+	lwflags_t lwflags;
+	int32_t srid;
+} G2_QUANT;
+
+static LWGEOM *gserialized2_quant_read_any(G2_QUANT *q);
+
+static void
+gserialized2_quant_init(G2_QUANT *q, lwflags_t lwflags, int8_t prec_xy, int8_t prec_z, int8_t prec_m)
+{
+	uint32_t i = 0;
+	memset(q, 0, sizeof(G2_QUANT));
+	q->lwflags = lwflags;
+	q->ndims = FLAGS_NDIMS(lwflags);
+	q->factor[i++] = pow(10, prec_xy);
+	q->factor[i++] = pow(10, prec_xy);
+	if (FLAGS_GET_Z(lwflags))
+		q->factor[i++] = pow(10, prec_z);
+	if (FLAGS_GET_M(lwflags))
+		q->factor[i++] = pow(10, prec_m);
+	for (i = 0; i < 4; i++)
+	{
+		q->min[i] = INT64_MAX;
+		q->max[i] = INT64_MIN;
+	}
+}
+
+static void
+gserialized2_quant_write_uint32(G2_QUANT *q, uint32_t val)
+{
+	memcpy(q->ptr, &val, sizeof(uint32_t));
+	q->ptr += sizeof(uint32_t);
+}
+
+static void
+gserialized2_quant_write_ptarray(G2_QUANT *q, const POINTARRAY *pa)
+{
+	uint32_t i, j;
+	const double *dptr = (const double *)pa->serialized_pointlist;
+	for (i = 0; i < pa->npoints; i++)
+	{
+		for (j = 0; j < q->ndims; j++)
+		{
+			double scaled = dptr[j] * q->factor[j];
+			int64_t val;
+			if (!(fabs(scaled) < G2_QUANT_MAX))
+			{
+				lwerror("%s: ordinate %g cannot be stored at the requested precision", __func__, dptr[j]);
+				return;
+			}
+			val = llround(scaled);
+			q->ptr += varint_s64_encode_buf(val - q->last[j], q->ptr);
+			q->last[j] = val;
+			if (val < q->min[j]) q->min[j] = val;
+			if (val > q->max[j]) q->max[j] = val;
+		}
+		dptr += q->ndims;
+	}
+}
+
+static void
+gserialized2_quant_write_any(G2_QUANT *q, const LWGEOM *geom)
+{
+	uint32_t i;
+	gserialized2_quant_write_uint32(q, geom->type);
+	switch (geom->type)
+	{
+	case POINTTYPE:
+	case LINETYPE:
+	case CIRCSTRINGTYPE:
+	case TRIANGLETYPE:
+	{
+		/* These all share the layout of LWLINE */
+		const POINTARRAY *pa = ((const LWLINE *)geom)->points;
+		gserialized2_quant_write_uint32(q, pa->npoints);
+		gserialized2_quant_write_ptarray(q, pa);
+		return;
+	}
+	case POLYGONTYPE:
+	{
+		const LWPOLY *poly = (const LWPOLY *)geom;
+		gserialized2_quant_write_uint32(q, poly->nrings);
+		for (i = 0; i < poly->nrings; i++)
+			gserialized2_quant_write_uint32(q, poly->rings[i]->npoints);
+		for (i = 0; i < poly->nrings; i++)
+			gserialized2_quant_write_ptarray(q, poly->rings[i]);
+		return;
+	}
+	default:
+	{
+		const LWCOLLECTION *col = (const LWCOLLECTION *)geom;
+		if (!lwtype_is_collection(geom->type))
+		{
+			lwerror("%s: Unknown geometry type: %d - %s", __func__, geom->type, lwtype_name(geom->type));
+			return;
+		}
+		gserialized2_quant_write_uint32(q, col->ngeoms);
+		for (i = 0; i < col->ngeoms; i++)
+			gserialized2_quant_write_any(q, col->geoms[i]);
+		return;
+	}
+	}
+}
+
+/*
+* Largest number of bytes the quantized form of geom can take: the
+* count words are the same as in the double form, without padding, and
+* a varint takes at most ten bytes for eight bytes of double.
+*/
+static size_t
+gserialized2_quant_max_size(const LWGEOM *geom)
+{
+	return gserialized2_from_any_size(geom) * 10 / 8 + 8;
+}
+
+GSERIALIZED *
+gserialized2_from_lwgeom_quantized(LWGEOM *geom, int8_t prec_xy, int8_t prec_z, int8_t prec_m, size_t *size)
+{
+	G2_QUANT q;
+	uint8_t *body, *ptr;
+	size_t body_size, box_size = 0, return_size;
+	uint64_t xflags = 0;
+	uint32_t type_word;
+	GBOX gbox;
+	int has_box = LW_FALSE;
+	int has_extended = FLAGS_GET_SOLID(geom->flags) ? LW_TRUE : LW_FALSE;
+	GSERIALIZED *g;
+
+	assert(geom);
+
+	if (prec_xy < -7 || prec_xy > 15 || prec_z < -7 || prec_z > 15 || prec_m < -7 || prec_m > 15)
+	{
+		lwerror("%s: precision must be between -7 and 15", __func__);
+		return NULL;
+	}
+
+	/* Write the body first, its size is only known afterwards */
+	body = lwalloc(gserialized2_quant_max_size(geom));
+	gserialized2_quant_init(&q, geom->flags, prec_xy, prec_z, prec_m);
+	q.ptr = body;
+	gserialized2_quant_write_any(&q, geom);
+	body_size = q.ptr - body;
+
+	/* The grid travels in the spare bytes of the top level type word */
+	type_word = G2_TYPE_WORD(geom->type, prec_xy, prec_z, prec_m);
+	memcpy(body, &type_word, sizeof(uint32_t));
+
+	/*
+	** Boxes cannot be peeked out of quantized data, so every non-point
+	** gets one. It has to hold the grid coordinates rather than the
+	** input ones: planar linear boxes come straight from the grid
+	** extremes, others are computed on the decoded geometry.
+	*/
+	if (geom->type != POINTTYPE && !lwgeom_is_empty(geom))
+	{
+		has_box = LW_TRUE;
+		if (FLAGS_GET_GEODETIC(geom->flags) || lwgeom_has_arc(geom))
+		{
+			LWGEOM *decoded;
+			G2_QUANT r;
+			gserialized2_quant_init(&r, geom->flags, prec_xy, prec_z, prec_m);
+			r.ptr = body;
+			r.end = body + body_size;
+			r.srid = geom->srid;
+			decoded = gserialized2_quant_read_any(&r);
+			lwgeom_calculate_gbox(decoded, &gbox);
+			lwgeom_free(decoded);
+		}
+		else
+		{
+			uint32_t i = 0;
+			gbox.flags = geom->flags;
+			gbox.xmin = q.min[i] / q.factor[i]; gbox.xmax = q.max[i] / q.factor[i]; i++;
+			gbox.ymin = q.min[i] / q.factor[i]; gbox.ymax = q.max[i] / q.factor[i]; i++;
+			if (FLAGS_GET_Z(geom->flags))
+			{
+				gbox.zmin = q.min[i] / q.factor[i]; gbox.zmax = q.max[i] / q.factor[i]; i++;
+			}
+			if (FLAGS_GET_M(geom->flags))
+			{
+				gbox.mmin = q.min[i] / q.factor[i]; gbox.mmax = q.max[i] / q.factor[i];
+			}
+		}
+		box_size = gbox_serialized_size(geom->flags);
+	}
+
+	return_size = 8 + (has_extended ? sizeof(uint64_t) : 0) + box_size + body_size;
+	ptr = lwalloc(return_size);
+	g = (GSERIALIZED *)ptr;
+
+	gserialized2_set_srid(g, geom->srid);
+	LWSIZE_SET(g->size, return_size);
+	g->gflags = lwflags_get_g2flags(geom->flags);
+	G2FLAGS_SET_BBOX(g->gflags, has_box);
+	G2FLAGS_SET_QUANTIZED(g->gflags, 1);
+	ptr += 8;
+
+	/* Extended flags only when something needs them, */
+	/* so that a quantized point stays smaller than a double one */
+	if (has_extended)
+	{
+		xflags |= G2FLAG_X_SOLID;
+		memcpy(ptr, &xflags, sizeof(uint64_t));
+		ptr += sizeof(uint64_t);
+	}
+
+	if (has_box)
+	{
+		gbox.flags = geom->flags;
+		ptr += gserialized2_from_gbox(&gbox, ptr);
+	}
+
+	memcpy(ptr, body, body_size);
+	lwfree(body);
+
+	if (size)
+		*size = return_size;
+	return g;
+}
+
+static uint32_t
+gserialized2_quant_read_uint32(G2_QUANT *q)
+{
+	uint32_t val;
+	if (q->ptr + sizeof(uint32_t) > q->end)
+	{
+		lwerror("%s: quantized serialization is truncated", __func__);
+		return 0;
+	}
+	memcpy(&val, q->ptr, sizeof(uint32_t));
+	q->ptr += sizeof(uint32_t);
+	return val;
+}
+
+static POINTARRAY *
+gserialized2_quant_read_ptarray(G2_QUANT *q, uint32_t npoints)
+{
+	uint32_t i, j;
+	POINTARRAY *pa = ptarray_construct(FLAGS_GET_Z(q->lwflags), FLAGS_GET_M(q->lwflags), npoints);
+	double *dptr = (double *)pa->serialized_pointlist;
+	for (i = 0; i < npoints; i++)
+	{
+		for (j = 0; j < q->ndims; j++)
+		{
+			size_t sz = 0;
+			q->last[j] += varint_s64_decode(q->ptr, q->end, &sz);
+			q->ptr += sz;
+			*dptr++ = q->last[j] / q->factor[j];
+		}
+	}
+	return pa;
+}
+
+static LWGEOM *
+gserialized2_quant_read_any(G2_QUANT *q)
+{
+	uint32_t type = G2_TYPE_WORD_GET_TYPE(gserialized2_quant_read_uint32(q));
+	uint32_t num = gserialized2_quant_read_uint32(q);
+	lwflags_t lwflags = q->lwflags;
+	uint32_t i;
+
+	/* Sub-geometries are never de-serialized with boxes (#1254) */
+	FLAGS_SET_BBOX(lwflags, 0);
+
+	switch (type)
+	{
+	case POINTTYPE:
+	case LINETYPE:
+	case CIRCSTRINGTYPE:
+	case TRIANGLETYPE:
+	{
+		/* These all share the layout of LWLINE */
+		LWLINE *line = lwalloc(sizeof(LWLINE));
+		line->srid = q->srid;
+		line->bbox = NULL;
+		line->type = type;
+		line->flags = lwflags;
+		line->points = gserialized2_quant_read_ptarray(q, num);
+		return (LWGEOM *)line;
+	}
+	case POLYGONTYPE:
+	{
+		LWPOLY *poly = lwalloc(sizeof(LWPOLY));
+		poly->srid = q->srid;
+		poly->bbox = NULL;
+		poly->type = type;
+		poly->flags = lwflags;
+		poly->nrings = poly->maxrings = num;
+		poly->rings = NULL;
+		if (num > 0)
+		{
+			uint8_t *counts = q->ptr;
+			if (q->ptr + num * sizeof(uint32_t) > q->end)
+			{
+				lwerror("%s: quantized serialization is truncated", __func__);
+				return NULL;
+			}
+			q->ptr += num * sizeof(uint32_t);
+			poly->rings = lwalloc(sizeof(POINTARRAY *) * num);
+			for (i = 0; i < num; i++)
+				poly->rings[i] = gserialized2_quant_read_ptarray(q, gserialized2_get_uint32_t(counts + 4 * i));
+		}
+		return (LWGEOM *)poly;
+	}
+	default:
+	{
+		LWCOLLECTION *col;
+		if (!lwtype_is_collection(type))
+		{
+			lwerror("Unknown geometry type: %d - %s", type, lwtype_name(type));
+			return NULL;
+		}
+		col = lwalloc(sizeof(LWCOLLECTION));
+		col->srid = q->srid;
+		col->bbox = NULL;
+		col->type = type;
+		col->flags = lwflags;
+		col->ngeoms = col->maxgeoms = num;
+		col->geoms = num > 0 ? lwalloc(sizeof(LWGEOM *) * num) : NULL;
+		for (i = 0; i < num; i++)
+		{
+			col->geoms[i] = gserialized2_quant_read_any(q);
+			if (!lwcollection_allows_subtype(type, col->geoms[i]->type))
+			{
+				lwerror("Invalid subtype (%s) for collection type (%s)",
+					lwtype_name(col->geoms[i]->type), lwtype_name(type));
+				return NULL;
+			}
+		}
+		return (LWGEOM *)col;
+	}
+	}
+}
+
+/* Set up a reader on the body of a quantized serialization */
+static void
+gserialized2_quant_reader(G2_QUANT *q, const GSERIALIZED *g)
+{
+	uint32_t type_word;
+	q->ptr = gserialized2_get_geometry_p(g);
+	memcpy(&type_word, q->ptr, sizeof(uint32_t));
+	gserialized2_quant_init(q, gserialized2_get_lwflags(g),
+		G2_TYPE_WORD_GET_PREC_XY(type_word), G2_TYPE_WORD_GET_PREC_Z(type_word), G2_TYPE_WORD_GET_PREC_M(type_word));
+	q->ptr = gserialized2_get_geometry_p(g);
+	q->end = (const uint8_t *)g + LWSIZE_GET(g->size);
+	q->srid = gserialized2_get_srid(g);
+}
+
+/* Decode the ordinates of a non-empty quantized point in place */
+static void
+gserialized2_quant_peek_point(const GSERIALIZED *g, POINT4D *out_point)
+{
+	G2_QUANT q;
+	double ord[4];
+	uint32_t j;
+
+	gserialized2_quant_reader(&q, g);
+	q.ptr += 2 * sizeof(uint32_t); /* Past the type and npoints */
+	for (j = 0; j < q.ndims; j++)
+	{
+		size_t sz = 0;
+		ord[j] = varint_s64_decode(q.ptr, q.end, &sz) / q.factor[j];
+		q.ptr += sz;
+	}
+	gserialized2_copy_point(ord, g->gflags, out_point);
+}
+
+/*
+* Reader that hands out the double serialization of a data area in
+* pieces, so that a quantized one can be hashed or compared without
+* building it. A data area that is not quantized is one single piece.
+*/
+#define G2_STREAM_MAX_DEPTH 200
+
+typedef struct
+{
+	G2_QUANT q;
+	const uint8_t *chunk;  /* Stored bytes to hand out as they are */
+	size_t chunk_len;
+	int pad;               /* Ring count padding to hand out */
+	int skip;              /* Only report lengths, do not decode ordinates */
+	uint32_t npoints;      /* Points left in the current point array */
+	uint32_t nrings;       /* Rings left in the current polygon */
+	const uint8_t *counts; /* Point count of the next of those rings */
+	uint32_t depth;
+	uint32_t ngeoms[G2_STREAM_MAX_DEPTH]; /* Geometries left at each level */
+	uint8_t buf[4 * sizeof(double)];
+} G2_STREAM;
+
+static void
+gserialized2_stream_init(G2_STREAM *s, const GSERIALIZED *g, const uint8_t *data, size_t size, int skip)
+{
+	s->chunk = NULL;
+	s->chunk_len = 0;
+	s->pad = LW_FALSE;
+	s->skip = skip;
+	s->npoints = s->nrings = 0;
+	s->counts = NULL;
+	if (gserialized_is_quantized(g))
+	{
+		gserialized2_quant_reader(&(s->q), g);
+		s->depth = 1;
+		s->ngeoms[0] = 1;
+	}
+	else
+	{
+		s->chunk = data;
+		s->chunk_len = size;
+		s->depth = 0;
+	}
+}
+
+/*
+* Next piece of the double serialization and its length, NULL at the
+* end. The piece stays valid until the following call. In skip mode
+* ordinates are stepped over, and only the length of their piece is
+* meaningful.
+*/
+static const uint8_t *
+gserialized2_stream_next(G2_STREAM *s, size_t *len)
+{
+	static const uint8_t pad[4] = {0, 0, 0, 0};
+	G2_QUANT *q = &(s->q);
+	uint32_t type, num, j;
+
+	while (LW_TRUE)
+	{
+		if (s->chunk_len)
+		{
+			*len = s->chunk_len;
+			s->chunk_len = 0;
+			return s->chunk;
+		}
+		if (s->pad)
+		{
+			s->pad = LW_FALSE;
+			*len = sizeof(pad);
+			return pad;
+		}
+		if (s->npoints && s->skip)
+		{
+			size_t nvals = (size_t)s->npoints * q->ndims;
+			*len = nvals * sizeof(double);
+			s->npoints = 0;
+			/* A varint ends on the first byte without the high bit */
+			while (nvals && q->ptr < q->end)
+			{
+				if (!(*(q->ptr) & 0x80))
+					nvals--;
+				q->ptr++;
+			}
+			if (nvals)
+			{
+				lwerror("%s: quantized serialization is truncated", __func__);
+				return NULL;
+			}
+			return s->buf;
+		}
+		if (s->npoints)
+		{
+			for (j = 0; j < q->ndims; j++)
+			{
+				size_t sz = 0;
+				double ord;
+				q->last[j] += varint_s64_decode(q->ptr, q->end, &sz);
+				q->ptr += sz;
+				ord = q->last[j] / q->factor[j];
+				memcpy(s->buf + j * sizeof(double), &ord, sizeof(double));
+			}
+			s->npoints--;
+			*len = q->ndims * sizeof(double);
+			return s->buf;
+		}
+		if (s->nrings)
+		{
+			s->npoints = gserialized2_get_uint32_t(s->counts);
+			s->counts += sizeof(uint32_t);
+			s->nrings--;
+			continue;
+		}
+		if (s->depth == 0)
+			return NULL;
+		if (s->ngeoms[s->depth - 1] == 0)
+		{
+			s->depth--;
+			continue;
+		}
+		s->ngeoms[s->depth - 1]--;
+
+		/* Type and count words of the next geometry, the type */
+		/* without the grid the top level one carries */
+		type = G2_TYPE_WORD_GET_TYPE(gserialized2_quant_read_uint32(q));
+		num = gserialized2_quant_read_uint32(q);
+		memcpy(s->buf, &type, sizeof(uint32_t));
+		memcpy(s->buf + sizeof(uint32_t), &num, sizeof(uint32_t));
+		*len = 2 * sizeof(uint32_t);
+
+		switch (type)
+		{
+		case POINTTYPE:
+		case LINETYPE:
+		case CIRCSTRINGTYPE:
+		case TRIANGLETYPE:
+			s->npoints = num;
+			break;
+		case POLYGONTYPE:
+			/* Ring counts are stored as in the double form, less the padding */
+			if (q->ptr + (size_t)num * sizeof(uint32_t) > q->end)
+			{
+				lwerror("%s: quantized serialization is truncated", __func__);
+				return NULL;
+			}
+			s->nrings = num;
+			s->counts = s->chunk = q->ptr;
+			s->chunk_len = (size_t)num * sizeof(uint32_t);
+			s->pad = num % 2;
+			q->ptr += s->chunk_len;
+			break;
+		default:
+			if (!lwtype_is_collection(type))
+			{
+				lwerror("Unknown geometry type: %d - %s", type, lwtype_name(type));
+				return NULL;
+			}
+			if (s->depth == G2_STREAM_MAX_DEPTH)
+			{
+				lwerror("%s: geometry is nested too deeply", __func__);
+				return NULL;
+			}
+			s->ngeoms[s->depth++] = num;
+			break;
+		}
+		return s->buf;
+	}
+}
+
+/* Size of the double serialization of a quantized data area */
+static size_t
+gserialized2_quant_data_size(const GSERIALIZED *g)
+{
+	G2_STREAM s;
+	size_t len, size = 0;
+	gserialized2_stream_init(&s, g, NULL, 0, LW_TRUE);
+	while (gserialized2_stream_next(&s, &len))
+		size += len;
+	return size;
+}
+
+/* lookup3 state, fed 32-bit words */
+typedef struct
+{
+	uint32_t a, b, c;
+	uint32_t k[3];
+	uint32_t nk;
+} G2_HASH;
+
+/* Block steps of hashlittle2, in lookup3.c */
+void hashlittle2_mix(uint32_t *pa, uint32_t *pb, uint32_t *pc);
+void hashlittle2_final(uint32_t *pa, uint32_t *pb, uint32_t *pc);
+
+static void
+gserialized2_hash_add(G2_HASH *h, const uint8_t *p, size_t len)
+{
+	size_t i;
+	for (i = 0; i + 4 <= len; i += 4)
+	{
+		/* Mix a full block only once it is known not to be the last one */
+		if (h->nk == 3)
+		{
+			h->a += h->k[0];
+			h->b += h->k[1];
+			h->c += h->k[2];
+			hashlittle2_mix(&(h->a), &(h->b), &(h->c));
+			h->nk = 0;
+		}
+		h->k[h->nk++] = (uint32_t)p[i] | ((uint32_t)p[i+1] << 8) |
+		                ((uint32_t)p[i+2] << 16) | ((uint32_t)p[i+3] << 24);
+	}
+}
+
+/*
+* Same value as gserialized2_hash gives for the double serialization:
+* every piece of that serialization is a whole number of 32-bit words,
+* so they can go into hashlittle2 one word at a time.
+*/
+static int32_t
+gserialized2_quant_hash(const GSERIALIZED *g)
+{
+	G2_STREAM s;
+	G2_HASH h;
+	const uint8_t *chunk;
+	size_t len;
+	int32_t srid = gserialized2_get_srid(g);
+
+	h.a = h.b = h.c = 0xdeadbeef + (uint32_t)(sizeof(int) + gserialized2_quant_data_size(g));
+	h.nk = 0;
+	gserialized2_hash_add(&h, (const uint8_t *)&srid, sizeof(int));
+
+	gserialized2_stream_init(&s, g, NULL, 0, LW_FALSE);
+	while ((chunk = gserialized2_stream_next(&s, &len)))
+		gserialized2_hash_add(&h, chunk, len);
+
+	while (h.nk < 3)
+		h.k[h.nk++] = 0;
+	h.a += h.k[0];
+	h.b += h.k[1];
+	h.c += h.k[2];
+	hashlittle2_final(&(h.a), &(h.b), &(h.c));
+	return h.b ^ h.c;
+}
+
+/**
+* Compare the double serializations of two data areas, as memcmp does
+* over the shorter one. A quantized area is decoded on the fly and its
+* size in *size is replaced by the size of its double serialization.
+*/
+int
+gserialized2_cmp_data(const GSERIALIZED *g1, const uint8_t *data1, size_t *size1,
+                      const GSERIALIZED *g2, const uint8_t *data2, size_t *size2)
+{
+	G2_STREAM s1, s2;
+	const uint8_t *p1 = NULL, *p2 = NULL;
+	size_t n1 = 0, n2 = 0, n, left;
+
+	if (gserialized_is_quantized(g1))
+		*size1 = gserialized2_quant_data_size(g1);
+	if (gserialized_is_quantized(g2))
+		*size2 = gserialized2_quant_data_size(g2);
+	gserialized2_stream_init(&s1, g1, data1, *size1, LW_FALSE);
+	gserialized2_stream_init(&s2, g2, data2, *size2, LW_FALSE);
+
+	left = *size1 < *size2 ? *size1 : *size2;
+	while (left)
+	{
+		int cmp;
+		if (!n1)
+			p1 = gserialized2_stream_next(&s1, &n1);
+		if (!n2)
+			p2 = gserialized2_stream_next(&s2, &n2);
+		n = n1 < n2 ? n1 : n2;
+		if (n > left)
+			n = left;
+		cmp = memcmp(p1, p2, n);
+		if (cmp)
+			return cmp;
+		p1 += n;
+		p2 += n;
+		n1 -= n;
+		n2 -= n;
+		left -= n;
+	}
+	return 0;
+}
+
 // xxxx continue reviewing extended flags content from here
 
 /***********************************************************************
@@ -1526,7 +2249,14 @@ LWGEOM* lwgeom_from_gserialized2(const GSERIALIZED *g)
 	if (FLAGS_GET_BBOX(lwflags))
 		data_ptr += gbox_serialized_size(lwflags);
 
-	lwgeom = lwgeom_from_gserialized2_buffer(data_ptr, lwflags, &size, srid);
+	if (gserialized2_is_quantized(g))
+	{
+		G2_QUANT q;
+		gserialized2_quant_reader(&q, g);
+		lwgeom = gserialized2_quant_read_any(&q);
+	}
+	else
+		lwgeom = lwgeom_from_gserialized2_buffer(data_ptr, lwflags, &size, srid);
 
 	if (!lwgeom)
 		lwerror("%s: unable create geometry", __func__); /* Ooops! */
@@ -6,7 +6,7 @@
 #define G2FLAG_BBOX      0x04
 #define G2FLAG_GEODETIC  0x08
 #define G2FLAG_EXTENDED  0x10
-#define G2FLAG_RESERVED1 0x20 /* RESERVED FOR FUTURE USES */
+#define G2FLAG_QUANTIZED 0x20 /* Data area layout, kept out of the extended flags so points stay small */
 #define G2FLAG_VER_0     0x40
 #define G2FLAG_RESERVED2 0x80 /* RESERVED FOR FUTURE VERSIONS */
 
@@ -18,19 +18,32 @@
 #define G2FLAG_X_IS_VALID         0x00000004 // To Be Implemented?
 #define G2FLAG_X_HAS_HASH         0x00000008 // To Be Implemented?
 
+/**
+* Quantized serializations keep the number of decimal digits of their
+* xy, z and m grids in the second, third and fourth byte of the type
+* word of the top level geometry, which only needs the first one.
+*/
+#define G2_TYPE_WORD_GET_TYPE(word)    ((word) & 0xFF)
+#define G2_TYPE_WORD_GET_PREC_XY(word) ((int8_t)(((word) >> 8) & 0xFF))
+#define G2_TYPE_WORD_GET_PREC_Z(word)  ((int8_t)(((word) >> 16) & 0xFF))
+#define G2_TYPE_WORD_GET_PREC_M(word)  ((int8_t)(((word) >> 24) & 0xFF))
+#define G2_TYPE_WORD(type, prec_xy, prec_z, prec_m) ((uint32_t)(type) | \
+	((uint32_t)(uint8_t)(prec_xy) << 8) | ((uint32_t)(uint8_t)(prec_z) << 16) | ((uint32_t)(uint8_t)(prec_m) << 24))
+
 #define G2FLAGS_GET_VERSION(gflags)  (((gflags) & G2FLAG_VER_0)>>6)
 #define G2FLAGS_GET_Z(gflags)         ((gflags) & G2FLAG_Z)
 #define G2FLAGS_GET_M(gflags)        (((gflags) & G2FLAG_M)>>1)
 #define G2FLAGS_GET_BBOX(gflags)     (((gflags) & G2FLAG_BBOX)>>2)
 #define G2FLAGS_GET_GEODETIC(gflags) (((gflags) & G2FLAG_GEODETIC)>>3)
 #define G2FLAGS_GET_EXTENDED(gflags) (((gflags) & G2FLAG_EXTENDED)>>4)
-#define G2FLAGS_GET_UNUSED(gflags)   (((gflags) & G2FLAG_UNUSED)>>5)
+#define G2FLAGS_GET_QUANTIZED(gflags) (((gflags) & G2FLAG_QUANTIZED)>>5)
 
 #define G2FLAGS_SET_Z(gflags, value) ((gflags) = (value) ? ((gflags) | G2FLAG_Z) : ((gflags) & ~G2FLAG_Z))
 #define G2FLAGS_SET_M(gflags, value) ((gflags) = (value) ? ((gflags) | G2FLAG_M) : ((gflags) & ~G2FLAG_M))
 #define G2FLAGS_SET_BBOX(gflags, value) ((gflags) = (value) ? ((gflags) | G2FLAG_BBOX) : ((gflags) & ~G2FLAG_BBOX))
 #define G2FLAGS_SET_GEODETIC(gflags, value) ((gflags) = (value) ? ((gflags) | G2FLAG_GEODETIC) : ((gflags) & ~G2FLAG_GEODETIC))
 #define G2FLAGS_SET_EXTENDED(gflags, value) ((gflags) = (value) ? ((gflags) | G2FLAG_EXTENDED) : ((gflags) & ~G2FLAG_EXTENDED))
+#define G2FLAGS_SET_QUANTIZED(gflags, value) ((gflags) = (value) ? ((gflags) | G2FLAG_QUANTIZED) : ((gflags) & ~G2FLAG_QUANTIZED))
 #define G2FLAGS_SET_VERSION(gflags, value) ((gflags) = (value) ? ((gflags) | G2FLAG_VER_0) : ((gflags) & ~G2FLAG_VER_0))
 
 #define G2FLAGS_NDIMS(gflags) (2 + G2FLAGS_GET_Z(gflags) + G2FLAGS_GET_M(gflags))
@@ -159,6 +172,27 @@ GSERIALIZED* gserialized2_from_lwgeom(LWGEOM *geom, size_t *size);
 */
 size_t gserialized2_from_lwgeom_size(const LWGEOM *geom);
 
+/**
+* Allocate a new #GSERIALIZED from an #LWGEOM, storing the ordinates as
+* delta encoded varints on a decimal grid instead of as doubles. The
+* precisions are numbers of decimal digits, as in TWKB.
+*/
+GSERIALIZED* gserialized2_from_lwgeom_quantized(LWGEOM *geom, int8_t prec_xy, int8_t prec_z, int8_t prec_m, size_t *size);
+
+/**
+* Check if a #GSERIALIZED stores quantized ordinates.
+*/
+int gserialized2_is_quantized(const GSERIALIZED *g);
+
+/**
+* Compare the double serializations of the data areas of two #GSERIALIZED,
+* as memcmp over the shorter one, without de-serializing quantized ones.
+* *size1 and *size2 go in as the stored sizes of the data areas and come
+* out as the sizes of their double serializations.
+*/
+int gserialized2_cmp_data(const GSERIALIZED *g1, const uint8_t *data1, size_t *size1,
+                          const GSERIALIZED *g2, const uint8_t *data2, size_t *size2);
+
 /**
 * Allocate a new #LWGEOM from a #GSERIALIZED. The resulting #LWGEOM will have coordinates
 * that are double aligned and suitable for direct reading using getPoint2d_cp
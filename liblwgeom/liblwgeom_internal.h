@@ -150,6 +150,16 @@
 #define OUT_MAX_BYTES_DOUBLE (1 /* Sign */ + 2 /* 0.x */ + OUT_MAX_DIGITS)
 #define OUT_DOUBLE_BUFFER_SIZE OUT_MAX_BYTES_DOUBLE + 1 /* +1 including NULL */
 
+/* Layout options for lwprint_ptarray */
+#define LWPRINT_ORDSEP_COMMA 0x01 /* x,y instead of x y */
+#define LWPRINT_PTSEP_SPACE  0x02 /* points separated by ' ' instead of ',' */
+#define LWPRINT_BRACKETS     0x04 /* every point wrapped in [] */
+#define LWPRINT_FLIP_XY      0x08 /* y is written before x */
+
+/* Upper bound of the bytes written by lwprint_ptarray, including the final NULL */
+#define OUT_MAX_BYTES_PTARRAY(npoints, dims) \
+	((size_t)(npoints) * ((dims) * (OUT_MAX_BYTES_DOUBLE + 1) + 2) + 1)
+
 /**
 * Constants for point-in-polygon return values
 */
@@ -448,6 +458,16 @@ int lwgeom_contains_point(const LWGEOM *geom, const POINT2D *pt);
 */
 int lwline_split_by_point_to(const LWLINE* ln, const LWPOINT* pt, LWMLINE* to);
 
+/**
+* Clip a 2D geometry by a rectangle without going through GEOS.
+* Follows the output conventions of GEOSClipByRect, or with closed set
+* keeps what lies on the boundary like an intersection does. Returns NULL
+* when the input is not one it can clip exactly (3D/measured input,
+* curves, polygon rings cut more than once by the rectangle, rings
+* with vertices on the rectangle boundary lines).
+*/
+LWGEOM *lwgeom_clip_by_rect_native(const LWGEOM *geom, double x1, double y1, double x2, double y2, int closed);
+
 /** Ensure the collection can hold at least up to ngeoms geometries */
 void lwcollection_reserve(LWCOLLECTION *col, uint32_t ngeoms);
 
@@ -461,6 +481,7 @@ int gbox_centroid(const GBOX* gbox, POINT2D* out);
 
 /* Utilities */
 int lwprint_double(double d, int maxdd, char *buf);
+size_t lwprint_ptarray(const POINTARRAY *pa, uint32_t npoints, uint32_t dims, int maxdd, int opts, char *buf);
 extern uint8_t MULTITYPE[NUMTYPES];
 
 extern lwinterrupt_callback *_lwgeom_interrupt_callback;
@@ -81,6 +81,8 @@ static uint32_t hashbig( const void *key, size_t length, uint32_t initval);
 #endif
 
 void hashlittle2(const void *key, size_t length, uint32_t *pc, uint32_t *pb);
+void hashlittle2_mix(uint32_t *pa, uint32_t *pb, uint32_t *pc);
+void hashlittle2_final(uint32_t *pa, uint32_t *pb, uint32_t *pc);
 
 /*
 -------------------------------------------------------------------------------
@@ -650,6 +652,29 @@ void hashlittle2(
   *pc=c; *pb=b;
 }
 
+/*
+ * hashlittle2_mix(), hashlittle2_final(): the block steps of hashlittle2(),
+ * for callers that produce the key a 32-bit word at a time instead of
+ * holding all of it in one buffer.  Set a=b=c=0xdeadbeef+length+*pc and
+ * c+=*pb as hashlittle2() does.  For every 12 byte block, add its words,
+ * read as little-endian, to a, b and c.  Call hashlittle2_mix() after each
+ * block that is not the last one.  Zero pad the last block and call
+ * hashlittle2_final() after it.  c and b then hold *pc and *pb.
+ */
+void hashlittle2_mix(uint32_t *pa, uint32_t *pb, uint32_t *pc)
+{
+  uint32_t a = *pa, b = *pb, c = *pc;
+  mix(a,b,c);
+  *pa=a; *pb=b; *pc=c;
+}
+
+void hashlittle2_final(uint32_t *pa, uint32_t *pb, uint32_t *pc)
+{
+  uint32_t a = *pa, b = *pb, c = *pc;
+  final(a,b,c);
+  *pa=a; *pb=b; *pc=c;
+}
+
 
 #if 0
 /*
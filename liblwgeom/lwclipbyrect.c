@@ -0,0 +1,655 @@
+/**********************************************************************
+ *
+ * PostGIS - Spatial Types for PostgreSQL
+ * http://postgis.net
+ *
+ * PostGIS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * PostGIS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with PostGIS.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **********************************************************************/
+
+#include "liblwgeom_internal.h"
+#include "lwgeom_log.h"
+
+/*
+ * Native clipping of 2D geometries by an axis-aligned rectangle.
+ *
+ * This follows the conventions of GEOSClipByRect so the two can be used
+ * interchangeably: points on the rectangle boundary are dropped, line
+ * pieces running along the boundary are dropped, lines are split at
+ * vertices on the boundary, clipped polygon shells are oriented clockwise
+ * and start at their lowest x (then y) vertex, holes wholly inside are
+ * copied as they are, and the parts are assembled as polygons, then
+ * lines, then points.
+ *
+ * Only the cases that can be answered exactly without building a
+ * topology graph are handled here: polygon rings that touch the
+ * rectangle boundary, cross it more than twice (the result may split
+ * into several polygons) or are otherwise degenerate make the clipper
+ * decline, and the caller falls back on GEOS.
+ *
+ * With a closed rectangle the boundary counts as inside instead, which
+ * gives what an intersection with the rectangle polygon gives: points on
+ * the boundary and line pieces along it are kept.
+ */
+
+/* Sides of the rectangle, as reported by rect_clip_segment */
+#define RECT_LEFT 0
+#define RECT_RIGHT 1
+#define RECT_BOTTOM 2
+#define RECT_TOP 3
+
+typedef struct
+{
+	LWCOLLECTION *polys;
+	LWCOLLECTION *lines;
+	LWCOLLECTION *points;
+	int closed;	/* Boundary counts as inside */
+} RECT_CLIP_PARTS;
+
+/* Crossing of a ring with the rectangle boundary */
+typedef struct
+{
+	POINT4D pt;	/* Point on the boundary */
+	uint32_t edge;	/* Ring edge the crossing is on */
+	double s;	/* Position along the perimeter, counter-clockwise from (xmin, ymin) */
+} RECT_CROSSING;
+
+static inline int
+rect_contains_point(const GBOX *box, const POINT2D *pt)
+{
+	return pt->x > box->xmin && pt->x < box->xmax && pt->y > box->ymin && pt->y < box->ymax;
+}
+
+/* Same as rect_contains_point, boundary included when closed is set */
+static inline int
+rect_covers_point(const GBOX *box, const POINT2D *pt, int closed)
+{
+	return closed ? gbox_contains_point2d(box, pt) : rect_contains_point(box, pt);
+}
+
+/* Strictly inside, a part touching the boundary still has to be clipped */
+static inline int
+rect_contains_box(const GBOX *box, const GBOX *inner)
+{
+	return inner->xmin > box->xmin && inner->xmax < box->xmax && inner->ymin > box->ymin && inner->ymax < box->ymax;
+}
+
+static inline int
+rect_on_boundary_line(const GBOX *box, const POINT2D *pt)
+{
+	return pt->x == box->xmin || pt->x == box->xmax || pt->y == box->ymin || pt->y == box->ymax;
+}
+
+/*
+ * Liang-Barsky clipping of segment a-b. On success the visible part runs
+ * from parameter t0 to t1 (t0 == t1 when the segment only touches a corner),
+ * and side0/side1 tell which rectangle side cut the segment there (-1 when
+ * the segment end itself is kept).
+ */
+static int
+rect_clip_segment(const POINT4D *a, const POINT4D *b, const GBOX *box,
+		  double *t0, int *side0, double *t1, int *side1)
+{
+	double p[4], q[4];
+	int k;
+
+	p[RECT_LEFT] = a->x - b->x;
+	q[RECT_LEFT] = a->x - box->xmin;
+	p[RECT_RIGHT] = b->x - a->x;
+	q[RECT_RIGHT] = box->xmax - a->x;
+	p[RECT_BOTTOM] = a->y - b->y;
+	q[RECT_BOTTOM] = a->y - box->ymin;
+	p[RECT_TOP] = b->y - a->y;
+	q[RECT_TOP] = box->ymax - a->y;
+
+	*t0 = 0.0;
+	*t1 = 1.0;
+	*side0 = *side1 = -1;
+
+	for (k = 0; k < 4; k++)
+	{
+		double r;
+		if (p[k] == 0.0)
+		{
+			if (q[k] < 0.0)
+				return LW_FALSE;
+			continue;
+		}
+		r = q[k] / p[k];
+		if (p[k] < 0.0)
+		{
+			if (r > *t1)
+				return LW_FALSE;
+			if (r > *t0)
+			{
+				*t0 = r;
+				*side0 = k;
+			}
+		}
+		else
+		{
+			if (r < *t0)
+				return LW_FALSE;
+			if (r < *t1)
+			{
+				*t1 = r;
+				*side1 = k;
+			}
+		}
+	}
+	return LW_TRUE;
+}
+
+/* Point at parameter t of segment a-b, snapped exactly onto the cutting side */
+static void
+rect_segment_point(const POINT4D *a, const POINT4D *b, double t, int side, const GBOX *box, POINT4D *pt)
+{
+	if (side < 0)
+	{
+		*pt = t == 0.0 ? *a : *b;
+		return;
+	}
+	pt->x = a->x + t * (b->x - a->x);
+	pt->y = a->y + t * (b->y - a->y);
+	pt->z = a->z + t * (b->z - a->z);
+	pt->m = a->m + t * (b->m - a->m);
+	switch (side)
+	{
+	case RECT_LEFT:
+		pt->x = box->xmin;
+		break;
+	case RECT_RIGHT:
+		pt->x = box->xmax;
+		break;
+	case RECT_BOTTOM:
+		pt->y = box->ymin;
+		break;
+	case RECT_TOP:
+		pt->y = box->ymax;
+		break;
+	}
+}
+
+/* Position of a boundary point along the perimeter, in [0, 4) */
+static double
+rect_perimeter_position(const GBOX *box, const POINT4D *pt, int side)
+{
+	double s;
+	switch (side)
+	{
+	case RECT_BOTTOM:
+		s = (pt->x - box->xmin) / (box->xmax - box->xmin);
+		break;
+	case RECT_RIGHT:
+		s = 1.0 + (pt->y - box->ymin) / (box->ymax - box->ymin);
+		break;
+	case RECT_TOP:
+		s = 2.0 + (box->xmax - pt->x) / (box->xmax - box->xmin);
+		break;
+	default:
+		s = 3.0 + (box->ymax - pt->y) / (box->ymax - box->ymin);
+		break;
+	}
+	return s >= 4.0 ? s - 4.0 : s;
+}
+
+static void
+rect_corner(const GBOX *box, int corner, POINT4D *pt)
+{
+	/* Corners counter-clockwise from (xmin, ymin), matching the perimeter position */
+	corner = ((corner % 4) + 4) % 4;
+	pt->x = (corner == 1 || corner == 2) ? box->xmax : box->xmin;
+	pt->y = (corner >= 2) ? box->ymax : box->ymin;
+	pt->z = pt->m = 0.0;
+}
+
+static POINTARRAY *
+rect_ring(const GBOX *box)
+{
+	/* Clockwise, the way GEOS hands back a fully covered rectangle */
+	POINTARRAY *pa = ptarray_construct_empty(LW_FALSE, LW_FALSE, 5);
+	POINT4D pt = {box->xmin, box->ymin, 0.0, 0.0};
+	ptarray_append_point(pa, &pt, LW_TRUE);
+	pt.y = box->ymax;
+	ptarray_append_point(pa, &pt, LW_TRUE);
+	pt.x = box->xmax;
+	ptarray_append_point(pa, &pt, LW_TRUE);
+	pt.y = box->ymin;
+	ptarray_append_point(pa, &pt, LW_TRUE);
+	pt.x = box->xmin;
+	ptarray_append_point(pa, &pt, LW_TRUE);
+	return pa;
+}
+
+/* Start a closed ring at its lowest x (then y) vertex, as GEOS does for the rings it rebuilds */
+static void
+rect_normalize_ring(POINTARRAY *pa)
+{
+	POINT4D first, pt;
+	uint32_t i;
+
+	getPoint4d_p(pa, 0, &first);
+	for (i = 1; i < pa->npoints - 1; i++)
+	{
+		getPoint4d_p(pa, i, &pt);
+		if (pt.x < first.x || (pt.x == first.x && pt.y < first.y))
+			first = pt;
+	}
+	ptarray_scroll_in_place(pa, &first);
+}
+
+/*
+ * Clip a closed ring that crosses the rectangle boundary exactly twice.
+ * The part inside is the arc of the ring between the entry and the exit
+ * closed by the rectangle boundary, walked in the ring's own direction.
+ */
+static POINTARRAY *
+rect_clip_ring(const POINTARRAY *ring, const GBOX *box, const RECT_CROSSING *entry, const RECT_CROSSING *exit)
+{
+	uint32_t nvertices = ring->npoints - 1;
+	int ccw = ptarray_isccw(ring);
+	POINTARRAY *pa = ptarray_construct_empty(LW_FALSE, LW_FALSE, 8);
+	POINT4D pt;
+	double dist;
+	int corner, n;
+
+	ptarray_append_point(pa, &entry->pt, LW_TRUE);
+	if (entry->edge != exit->edge)
+	{
+		uint32_t i = (entry->edge + 1) % nvertices;
+		for (;;)
+		{
+			getPoint4d_p(ring, i, &pt);
+			ptarray_append_point(pa, &pt, LW_TRUE);
+			if (i == exit->edge)
+				break;
+			i = (i + 1) % nvertices;
+		}
+	}
+	ptarray_append_point(pa, &exit->pt, LW_TRUE);
+
+	/* Walk the boundary from the exit back to the entry */
+	if (ccw)
+	{
+		dist = fmod(entry->s - exit->s + 4.0, 4.0);
+		corner = (int)floor(exit->s) + 1;
+		for (n = 0; n < 4 && corner - exit->s < dist; n++, corner++)
+		{
+			rect_corner(box, corner, &pt);
+			ptarray_append_point(pa, &pt, LW_TRUE);
+		}
+	}
+	else
+	{
+		dist = fmod(exit->s - entry->s + 4.0, 4.0);
+		corner = (int)ceil(exit->s) - 1;
+		for (n = 0; n < 4 && exit->s - corner < dist; n++, corner--)
+		{
+			rect_corner(box, corner, &pt);
+			ptarray_append_point(pa, &pt, LW_TRUE);
+		}
+	}
+	ptarray_append_point(pa, &entry->pt, LW_TRUE);
+
+	if (pa->npoints < 4)
+	{
+		ptarray_free(pa);
+		return NULL;
+	}
+	if (ccw)
+		ptarray_reverse_in_place(pa);
+	rect_normalize_ring(pa);
+	return pa;
+}
+
+/*
+ * Find where a closed ring crosses the rectangle boundary.
+ * Returns the number of crossings, or -1 when the ring touches
+ * a corner or enters and leaves more than once.
+ */
+static int
+rect_ring_crossings(const POINTARRAY *ring, const GBOX *box, RECT_CROSSING *entry, RECT_CROSSING *exit)
+{
+	int nentries = 0, nexits = 0;
+	uint32_t i;
+
+	for (i = 0; i < ring->npoints - 1; i++)
+	{
+		POINT4D a, b;
+		int a_in, b_in;
+		double t0, t1;
+		int side0, side1;
+
+		getPoint4d_p(ring, i, &a);
+		getPoint4d_p(ring, i + 1, &b);
+		a_in = rect_contains_point(box, (POINT2D *)&a);
+		b_in = rect_contains_point(box, (POINT2D *)&b);
+		if (a_in && b_in)
+			continue;
+		if (!rect_clip_segment(&a, &b, box, &t0, &side0, &t1, &side1))
+			continue;
+		if (t0 == t1)
+			return -1;
+
+		if (!a_in)
+		{
+			if (nentries++)
+				return -1;
+			rect_segment_point(&a, &b, t0, side0, box, &entry->pt);
+			entry->s = rect_perimeter_position(box, &entry->pt, side0);
+			entry->edge = i;
+		}
+		if (!b_in)
+		{
+			if (nexits++)
+				return -1;
+			rect_segment_point(&a, &b, t1, side1, box, &exit->pt);
+			exit->s = rect_perimeter_position(box, &exit->pt, side1);
+			exit->edge = i;
+		}
+	}
+
+	if (nentries != nexits)
+		return -1;
+	if (nentries && entry->s == exit->s)
+		return -1;
+	return nentries + nexits;
+}
+
+static int
+rect_clip_poly(const LWPOLY *poly, const GBOX *box, RECT_CLIP_PARTS *parts)
+{
+	RECT_CROSSING entry, exit;
+	POINTARRAY *shell;
+	LWPOLY *out;
+	GBOX ringbox;
+	uint32_t i, j;
+	int ncrossings;
+
+	if (lwpoly_is_empty(poly))
+		return LW_SUCCESS;
+
+	ptarray_calculate_gbox_cartesian(poly->rings[0], &ringbox);
+	if (rect_contains_box(box, &ringbox))
+	{
+		lwcollection_add_lwgeom(parts->polys, lwgeom_clone_deep(lwpoly_as_lwgeom(poly)));
+		return LW_SUCCESS;
+	}
+	if (!gbox_overlaps_2d(box, &ringbox))
+		return LW_SUCCESS;
+
+	/* Rings touching the boundary lines or degenerate rings are left to GEOS */
+	for (i = 0; i < poly->nrings; i++)
+	{
+		const POINTARRAY *ring = poly->rings[i];
+		if (ring->npoints < 4 || !ptarray_is_closed_2d(ring) || ptarray_signed_area(ring) == 0.0)
+			return LW_FAILURE;
+		for (j = 0; j < ring->npoints; j++)
+		{
+			if (rect_on_boundary_line(box, getPoint2d_cp(ring, j)))
+				return LW_FAILURE;
+		}
+	}
+
+	ncrossings = rect_ring_crossings(poly->rings[0], box, &entry, &exit);
+	if (ncrossings == 2)
+	{
+		shell = rect_clip_ring(poly->rings[0], box, &entry, &exit);
+		if (!shell)
+			return LW_FAILURE;
+	}
+	else if (ncrossings == 0)
+	{
+		/* The shell is not inside the rectangle, so it either
+		 * surrounds it or misses it */
+		POINT2D corner = {box->xmin, box->ymin};
+		if (ptarray_contains_point(poly->rings[0], &corner) != LW_INSIDE)
+			return LW_SUCCESS;
+		shell = rect_ring(box);
+	}
+	else
+		return LW_FAILURE;
+
+	out = lwpoly_construct_empty(poly->srid, LW_FALSE, LW_FALSE);
+	lwpoly_add_ring(out, shell);
+
+	for (i = 1; i < poly->nrings; i++)
+	{
+		ptarray_calculate_gbox_cartesian(poly->rings[i], &ringbox);
+		if (rect_contains_box(box, &ringbox))
+			lwpoly_add_ring(out, ptarray_clone_deep(poly->rings[i]));
+		else if (gbox_overlaps_2d(box, &ringbox))
+		{
+			/* A hole cut by the boundary changes the shell */
+			lwpoly_free(out);
+			return LW_FAILURE;
+		}
+	}
+
+	lwcollection_add_lwgeom(parts->polys, lwpoly_as_lwgeom(out));
+	return LW_SUCCESS;
+}
+
+/* Add the line in construction to the collection, unless it collapsed */
+static void
+rect_flush_line(POINTARRAY **pa, LWCOLLECTION *col)
+{
+	if (!*pa)
+		return;
+	if ((*pa)->npoints > 1)
+		lwcollection_add_lwgeom(col, lwline_as_lwgeom(lwline_construct(col->srid, NULL, *pa)));
+	else
+		ptarray_free(*pa);
+	*pa = NULL;
+}
+
+void
+ptarray_clip_by_rect(const POINTARRAY *pa, const GBOX *box, int closed, LWCOLLECTION *col)
+{
+	POINTARRAY *run = NULL;
+	uint32_t i;
+
+	for (i = 1; i < pa->npoints; i++)
+	{
+		POINT4D a, b, p0, p1;
+		POINT2D mid;
+		double t0, t1;
+		int side0, side1;
+
+		getPoint4d_p(pa, i - 1, &a);
+		getPoint4d_p(pa, i, &b);
+		if (a.x == b.x && a.y == b.y)
+			continue;
+
+		/* Missed the box, or only touched a corner of it */
+		if (!rect_clip_segment(&a, &b, box, &t0, &side0, &t1, &side1) || t0 >= t1)
+		{
+			rect_flush_line(&run, col);
+			continue;
+		}
+		rect_segment_point(&a, &b, t0, side0, box, &p0);
+		rect_segment_point(&a, &b, t1, side1, box, &p1);
+
+		/* Pieces running along the boundary are outside an open box */
+		mid.x = (p0.x + p1.x) / 2;
+		mid.y = (p0.y + p1.y) / 2;
+		if (!rect_covers_point(box, &mid, closed))
+		{
+			rect_flush_line(&run, col);
+			continue;
+		}
+
+		if (!run || t0 > 0.0)
+		{
+			rect_flush_line(&run, col);
+			run = ptarray_construct_empty(FLAGS_GET_Z(pa->flags), FLAGS_GET_M(pa->flags), 8);
+			ptarray_append_point(run, &p0, LW_TRUE);
+		}
+		ptarray_append_point(run, &p1, LW_TRUE);
+
+		/* The line leaves the box here, or reaches the boundary of an open one */
+		if (t1 < 1.0 || !rect_covers_point(box, (POINT2D *)&b, closed))
+			rect_flush_line(&run, col);
+	}
+	rect_flush_line(&run, col);
+}
+
+static int
+rect_clip_line(const LWLINE *line, const GBOX *box, RECT_CLIP_PARTS *parts)
+{
+	if (lwline_is_empty(line))
+		return LW_SUCCESS;
+	if (line->points->npoints < 2)
+		return LW_FAILURE;
+	ptarray_clip_by_rect(line->points, box, parts->closed, parts->lines);
+	return LW_SUCCESS;
+}
+
+static int
+rect_clip_point(const LWPOINT *point, const GBOX *box, RECT_CLIP_PARTS *parts)
+{
+	if (lwpoint_is_empty(point))
+		return LW_SUCCESS;
+	if (rect_covers_point(box, getPoint2d_cp(point->point, 0), parts->closed))
+		lwcollection_add_lwgeom(parts->points, lwgeom_clone_deep(lwpoint_as_lwgeom(point)));
+	return LW_SUCCESS;
+}
+
+static int
+rect_clip_geom(const LWGEOM *geom, const GBOX *box, RECT_CLIP_PARTS *parts)
+{
+	switch (geom->type)
+	{
+	case POINTTYPE:
+		return rect_clip_point((LWPOINT *)geom, box, parts);
+	case LINETYPE:
+		return rect_clip_line((LWLINE *)geom, box, parts);
+	case POLYGONTYPE:
+		return rect_clip_poly((LWPOLY *)geom, box, parts);
+	case MULTIPOINTTYPE:
+	case MULTILINETYPE:
+	case MULTIPOLYGONTYPE:
+	case COLLECTIONTYPE:
+	{
+		const LWCOLLECTION *col = (LWCOLLECTION *)geom;
+		uint32_t i;
+		for (i = 0; i < col->ngeoms; i++)
+		{
+			if (rect_clip_geom(col->geoms[i], box, parts) == LW_FAILURE)
+				return LW_FAILURE;
+		}
+		return LW_SUCCESS;
+	}
+	default:
+		return LW_FAILURE;
+	}
+}
+
+/* Move the parts of src into dst, leaving src empty */
+static void
+rect_move_parts(LWCOLLECTION *dst, LWCOLLECTION *src)
+{
+	uint32_t i;
+	for (i = 0; i < src->ngeoms; i++)
+		lwcollection_add_lwgeom(dst, src->geoms[i]);
+	src->ngeoms = 0;
+}
+
+static LWGEOM *
+rect_build_result(RECT_CLIP_PARTS *parts, int32_t srid)
+{
+	LWCOLLECTION *cols[3];
+	LWCOLLECTION *result;
+	uint32_t ngeoms = 0, i;
+
+	cols[0] = parts->polys;
+	cols[1] = parts->lines;
+	cols[2] = parts->points;
+	for (i = 0; i < 3; i++)
+		ngeoms += cols[i]->ngeoms;
+
+	/* A single part comes back as itself, same kind parts as a multi */
+	for (i = 0; i < 3; i++)
+	{
+		if (ngeoms > 0 && cols[i]->ngeoms == ngeoms)
+		{
+			LWGEOM *geom = lwcollection_as_lwgeom(cols[i]);
+			uint32_t j;
+			if (ngeoms == 1)
+			{
+				geom = cols[i]->geoms[0];
+				cols[i]->ngeoms = 0;
+				lwcollection_free(cols[i]);
+			}
+			for (j = 0; j < 3; j++)
+			{
+				if (j != i)
+					lwcollection_free(cols[j]);
+			}
+			return geom;
+		}
+	}
+
+	result = lwcollection_construct_empty(COLLECTIONTYPE, srid, LW_FALSE, LW_FALSE);
+	for (i = 0; i < 3; i++)
+	{
+		rect_move_parts(result, cols[i]);
+		lwcollection_free(cols[i]);
+	}
+	return lwcollection_as_lwgeom(result);
+}
+
+/*
+ * Clip a geometry by the rectangle (x1, y1) - (x2, y2), open or closed.
+ * Returns NULL when the geometry is not one the native clipper
+ * handles exactly, in which case the caller should use GEOS.
+ */
+LWGEOM *
+lwgeom_clip_by_rect_native(const LWGEOM *geom, double x1, double y1, double x2, double y2, int closed)
+{
+	RECT_CLIP_PARTS parts;
+	GBOX box, geombox;
+	uint32_t i;
+
+	if (FLAGS_GET_Z(geom->flags) || FLAGS_GET_M(geom->flags) || FLAGS_GET_GEODETIC(geom->flags))
+		return NULL;
+	if (!(x1 < x2 && y1 < y2))
+		return NULL;
+
+	gbox_init(&box);
+	box.xmin = x1;
+	box.ymin = y1;
+	box.xmax = x2;
+	box.ymax = y2;
+
+	if (lwgeom_calculate_gbox(geom, &geombox) == LW_FAILURE)
+		return NULL;
+	if (rect_contains_box(&box, &geombox))
+		return lwgeom_clone_deep(geom);
+
+	parts.polys = lwcollection_construct_empty(MULTIPOLYGONTYPE, geom->srid, LW_FALSE, LW_FALSE);
+	parts.lines = lwcollection_construct_empty(MULTILINETYPE, geom->srid, LW_FALSE, LW_FALSE);
+	parts.points = lwcollection_construct_empty(MULTIPOINTTYPE, geom->srid, LW_FALSE, LW_FALSE);
+	parts.closed = closed;
+
+	if (rect_clip_geom(geom, &box, &parts) == LW_FAILURE)
+	{
+		LWCOLLECTION *cols[3] = {parts.polys, parts.lines, parts.points};
+		for (i = 0; i < 3; i++)
+			lwcollection_free(cols[i]);
+		return NULL;
+	}
+
+	return rect_build_result(&parts, geom->srid);
+}
@@ -3228,15 +3228,18 @@ int lwgeom_force_geodetic(LWGEOM *geom)
 }
 
 
+/* Number of segments measured per spheroid_distances call */
+#define LENGTH_SPHEROID_BATCH 128
+
 double ptarray_length_spheroid(const POINTARRAY *pa, const SPHEROID *s)
 {
-	GEOGRAPHIC_POINT a, b;
-	double za = 0.0, zb = 0.0;
+	GEOGRAPHIC_POINT g[LENGTH_SPHEROID_BATCH + 1];
+	double z[LENGTH_SPHEROID_BATCH + 1];
+	double seglength[LENGTH_SPHEROID_BATCH];
 	POINT4D p;
-	uint32_t i;
+	uint32_t i, j, n;
 	int hasz = LW_FALSE;
 	double length = 0.0;
-	double seglength = 0.0;
 
 	/* Return zero on non-sensical inputs */
 	if ( ! pa || pa->npoints < 2 )
@@ -3245,38 +3248,42 @@ double ptarray_length_spheroid(const POINTARRAY *pa, const SPHEROID *s)
 	/* See if we have a third dimension */
 	hasz = FLAGS_GET_Z(pa->flags);
 
-	/* Initialize first point */
-	getPoint4d_p(pa, 0, &p);
-	geographic_point_init(p.x, p.y, &a);
-	if ( hasz )
-		za = p.z;
-
-	/* Loop and sum the length for each segment */
-	for ( i = 1; i < pa->npoints; i++ )
+	/* Measure the segments a batch at a time, each batch */
+	/* starting on the last point of the previous one */
+	for ( i = 0; i < pa->npoints - 1; i += n )
 	{
-		seglength = 0.0;
-		getPoint4d_p(pa, i, &p);
-		geographic_point_init(p.x, p.y, &b);
-		if ( hasz )
-			zb = p.z;
+		n = pa->npoints - 1 - i;
+		if ( n > LENGTH_SPHEROID_BATCH )
+			n = LENGTH_SPHEROID_BATCH;
+
+		for ( j = 0; j <= n; j++ )
+		{
+			getPoint4d_p(pa, i + j, &p);
+			geographic_point_init(p.x, p.y, &g[j]);
+			z[j] = p.z;
+		}
 
 		/* Special sphere case */
 		if ( s->a == s->b )
-			seglength = s->radius * sphere_distance(&a, &b);
+		{
+			for ( j = 0; j < n; j++ )
+				seglength[j] = s->radius * sphere_distance(&g[j], &g[j+1]);
+		}
 		/* Spheroid case */
 		else
-			seglength = spheroid_distance(&a, &b, s);
-
-		/* Add in the vertical displacement if we're in 3D */
-		if ( hasz )
-			seglength = sqrt( (zb-za)*(zb-za) + seglength*seglength );
+		{
+			spheroid_distances(g, g + 1, n, s, seglength);
+		}
 
-		/* Add this segment length to the total */
-		length += seglength;
+		for ( j = 0; j < n; j++ )
+		{
+			/* Add in the vertical displacement if we're in 3D */
+			if ( hasz )
+				seglength[j] = sqrt( (z[j+1]-z[j])*(z[j+1]-z[j]) + seglength[j]*seglength[j] );
 
-		/* B gets incremented in the next loop, so we save the value here */
-		a = b;
-		za = zb;
+			/* Add this segment length to the total */
+			length += seglength[j];
+		}
 	}
 	return length;
 }
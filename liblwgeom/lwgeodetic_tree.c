@@ -1026,3 +1026,266 @@ lwgeom_calculate_circ_tree(const LWGEOM* lwgeom)
 	}
 
 }
+
+
+/*
+* Flattened form of a CIRC_NODE tree, for storing next to a geography
+* value and loading back without recomputing every circle.
+*
+* HEADER (24 bytes)
+*   uint8  version
+*   uint8  big endian flag of the writer
+*   uint16 unused
+*   uint32 number of nodes
+*   uint32 number of points
+*   uint32 unused
+*   uint64 hash of the source geometry
+* POINTS (16 bytes each), the x/y edge end points referenced by leaves
+* NODES (64 bytes each), in pre-order, children follow their parent
+*   double center lon, center lat, radius, pt_outside x, pt_outside y
+*   uint32 number of children, int32 edge number, uint32 geometry type
+*   uint32 index of p1, index of p2 (UINT32_MAX on internal nodes)
+*   uint32 unused
+*/
+#define CIRC_BYTES_VERSION 1
+#define CIRC_BYTES_HEADER_SIZE 24
+#define CIRC_BYTES_POINT_SIZE 16
+#define CIRC_BYTES_NODE_SIZE 64
+#define CIRC_BYTES_MAX_DEPTH 128
+
+typedef struct
+{
+	uint8_t *points;       /* Write cursors, NULL while only counting */
+	uint8_t *nodes;
+	uint32_t num_points;
+	uint32_t num_nodes;
+	const POINT2D *last;   /* Last point emitted, shared by consecutive edges */
+	uint32_t last_idx;
+} circ_bytes_state;
+
+static uint32_t
+circ_bytes_point(circ_bytes_state *s, const POINT2D *p)
+{
+	if ( p == s->last )
+		return s->last_idx;
+
+	if ( s->points )
+		memcpy(s->points + (size_t)s->num_points * CIRC_BYTES_POINT_SIZE, p, sizeof(POINT2D));
+	s->last = p;
+	s->last_idx = s->num_points++;
+	return s->last_idx;
+}
+
+static void
+circ_bytes_node(circ_bytes_state *s, const CIRC_NODE *node)
+{
+	uint32_t i;
+	uint32_t idx[2] = {UINT32_MAX, UINT32_MAX};
+
+	if ( circ_node_is_leaf(node) )
+	{
+		idx[0] = circ_bytes_point(s, node->p1);
+		idx[1] = circ_bytes_point(s, node->p2);
+	}
+
+	if ( s->nodes )
+	{
+		uint8_t *rec = s->nodes + (size_t)s->num_nodes * CIRC_BYTES_NODE_SIZE;
+		double dbl[5];
+		uint32_t u32[5];
+		int32_t edge_num = node->edge_num;
+
+		dbl[0] = node->center.lon;
+		dbl[1] = node->center.lat;
+		dbl[2] = node->radius;
+		dbl[3] = node->pt_outside.x;
+		dbl[4] = node->pt_outside.y;
+		u32[0] = node->num_nodes;
+		memcpy(&(u32[1]), &edge_num, sizeof(int32_t));
+		u32[2] = node->geom_type;
+		u32[3] = idx[0];
+		u32[4] = idx[1];
+		memset(rec, 0, CIRC_BYTES_NODE_SIZE);
+		memcpy(rec, dbl, sizeof(dbl));
+		memcpy(rec + sizeof(dbl), u32, sizeof(u32));
+	}
+	s->num_nodes++;
+
+	for ( i = 0; i < node->num_nodes; i++ )
+		circ_bytes_node(s, node->nodes[i]);
+}
+
+/**
+* Flatten a tree into a single buffer of *size bytes, allocated with
+* lwalloc. The edge end points are copied in, so the buffer does not
+* depend on the geometry the tree was built from. src_hash identifies
+* that geometry, see gserialized_payload_hash, and is recorded so that
+* circ_tree_from_bytes can refuse to pair the tree with another one.
+*/
+uint8_t*
+circ_tree_to_bytes(const CIRC_NODE* node, uint64_t src_hash, size_t* size)
+{
+	circ_bytes_state s;
+	uint8_t *bytes;
+	uint32_t u32;
+
+	if ( ! node )
+		return NULL;
+
+	/* Count nodes and distinct points first */
+	memset(&s, 0, sizeof(circ_bytes_state));
+	circ_bytes_node(&s, node);
+
+	*size = CIRC_BYTES_HEADER_SIZE +
+	        (size_t)s.num_points * CIRC_BYTES_POINT_SIZE +
+	        (size_t)s.num_nodes * CIRC_BYTES_NODE_SIZE;
+	bytes = lwalloc(*size);
+	memset(bytes, 0, CIRC_BYTES_HEADER_SIZE);
+	bytes[0] = CIRC_BYTES_VERSION;
+	bytes[1] = IS_BIG_ENDIAN;
+	u32 = s.num_nodes;
+	memcpy(bytes + 4, &u32, sizeof(uint32_t));
+	u32 = s.num_points;
+	memcpy(bytes + 8, &u32, sizeof(uint32_t));
+	memcpy(bytes + 16, &src_hash, sizeof(uint64_t));
+
+	/* Then write them out */
+	s.points = bytes + CIRC_BYTES_HEADER_SIZE;
+	s.nodes = s.points + (size_t)s.num_points * CIRC_BYTES_POINT_SIZE;
+	s.num_points = s.num_nodes = 0;
+	s.last = NULL;
+	circ_bytes_node(&s, node);
+
+	return bytes;
+}
+
+static CIRC_NODE*
+circ_node_from_bytes(const uint8_t *nodes, uint32_t num_nodes, uint32_t *cur,
+                     const POINTARRAY *pa, int depth)
+{
+	CIRC_NODE *node;
+	const uint8_t *rec;
+	double dbl[5];
+	uint32_t u32[5];
+	int32_t edge_num;
+	uint32_t i;
+
+	if ( *cur >= num_nodes || depth > CIRC_BYTES_MAX_DEPTH )
+		return NULL;
+
+	rec = nodes + (size_t)(*cur) * CIRC_BYTES_NODE_SIZE;
+	(*cur)++;
+	memcpy(dbl, rec, sizeof(dbl));
+	memcpy(u32, rec + sizeof(dbl), sizeof(u32));
+	memcpy(&edge_num, &(u32[1]), sizeof(int32_t));
+
+	node = lwalloc(sizeof(CIRC_NODE));
+	node->center.lon = dbl[0];
+	node->center.lat = dbl[1];
+	node->radius = dbl[2];
+	node->pt_outside.x = dbl[3];
+	node->pt_outside.y = dbl[4];
+	node->edge_num = edge_num;
+	node->geom_type = u32[2];
+	node->d = 0.0;
+	node->num_nodes = 0;
+	node->nodes = NULL;
+	node->p1 = node->p2 = NULL;
+
+	/* Leaf, point back into the point array */
+	if ( u32[0] == 0 )
+	{
+		if ( u32[3] >= pa->npoints || u32[4] >= pa->npoints )
+		{
+			lwfree(node);
+			return NULL;
+		}
+		node->p1 = (POINT2D*)getPoint_internal(pa, u32[3]);
+		node->p2 = (POINT2D*)getPoint_internal(pa, u32[4]);
+		return node;
+	}
+
+	/* Internal node, every child takes at least one more record */
+	if ( u32[0] > num_nodes - *cur )
+	{
+		lwfree(node);
+		return NULL;
+	}
+	node->nodes = lwalloc(sizeof(CIRC_NODE*) * u32[0]);
+	for ( i = 0; i < u32[0]; i++ )
+	{
+		CIRC_NODE *child = circ_node_from_bytes(nodes, num_nodes, cur, pa, depth + 1);
+		if ( ! child )
+		{
+			circ_tree_free(node);
+			return NULL;
+		}
+		node->nodes[i] = child;
+		node->num_nodes = i + 1;
+	}
+	return node;
+}
+
+/**
+* Rebuild a tree from the output of circ_tree_to_bytes. src_hash
+* identifies the geometry the tree is going to be used with, and must
+* match the one it was written with. The leaves point into *pa, which the
+* caller frees with ptarray_free once the tree itself has been freed.
+*/
+CIRC_NODE*
+circ_tree_from_bytes(const uint8_t* bytes, size_t size, uint64_t src_hash, POINTARRAY** pa)
+{
+	uint32_t num_nodes, num_points, cur = 0;
+	uint64_t tree_hash;
+	const uint8_t *nodes;
+	CIRC_NODE *tree;
+
+	*pa = NULL;
+	if ( size < CIRC_BYTES_HEADER_SIZE || bytes[0] != CIRC_BYTES_VERSION )
+	{
+		lwerror("%s: invalid tree header", __func__);
+		return NULL;
+	}
+	if ( bytes[1] != IS_BIG_ENDIAN )
+	{
+		lwerror("%s: tree was written with a different byte order", __func__);
+		return NULL;
+	}
+	memcpy(&num_nodes, bytes + 4, sizeof(uint32_t));
+	memcpy(&num_points, bytes + 8, sizeof(uint32_t));
+
+	if ( num_nodes == 0 || num_points == 0 ||
+	     num_points > (size - CIRC_BYTES_HEADER_SIZE) / CIRC_BYTES_POINT_SIZE ||
+	     num_nodes > (size - CIRC_BYTES_HEADER_SIZE) / CIRC_BYTES_NODE_SIZE ||
+	     size != CIRC_BYTES_HEADER_SIZE +
+	             (size_t)num_points * CIRC_BYTES_POINT_SIZE +
+	             (size_t)num_nodes * CIRC_BYTES_NODE_SIZE )
+	{
+		lwerror("%s: tree size does not match its header", __func__);
+		return NULL;
+	}
+
+	memcpy(&tree_hash, bytes + 16, sizeof(uint64_t));
+	if ( tree_hash != src_hash )
+	{
+		lwerror("%s: tree was built from a different geometry", __func__);
+		return NULL;
+	}
+
+	/* All the end points in one copy */
+	*pa = ptarray_construct(0, 0, num_points);
+	memcpy(getPoint_internal(*pa, 0), bytes + CIRC_BYTES_HEADER_SIZE,
+	       (size_t)num_points * CIRC_BYTES_POINT_SIZE);
+
+	nodes = bytes + CIRC_BYTES_HEADER_SIZE + (size_t)num_points * CIRC_BYTES_POINT_SIZE;
+	tree = circ_node_from_bytes(nodes, num_nodes, &cur, *pa, 0);
+	if ( ! tree || cur != num_nodes )
+	{
+		circ_tree_free(tree);
+		ptarray_free(*pa);
+		*pa = NULL;
+		lwerror("%s: invalid tree structure", __func__);
+		return NULL;
+	}
+	return tree;
+}
@@ -55,6 +55,8 @@ double circ_tree_distance_tree(const CIRC_NODE* n1, const CIRC_NODE* n2, const S
 CIRC_NODE* lwgeom_calculate_circ_tree(const LWGEOM* lwgeom);
 int circ_tree_get_point(const CIRC_NODE* node, POINT2D* pt);
 int circ_tree_get_point_outside(const CIRC_NODE* node, POINT2D* pt);
+uint8_t* circ_tree_to_bytes(const CIRC_NODE* node, uint64_t src_hash, size_t* size);
+CIRC_NODE* circ_tree_from_bytes(const uint8_t* bytes, size_t size, uint64_t src_hash, POINTARRAY** pa);
 
 #endif /* _LWGEODETIC_TREE_H */
 
@@ -2254,6 +2254,36 @@ lwgeom_grid(const LWGEOM *lwgeom, const gridspec *grid)
 }
 
 
+/*
+ * Clip one half of a subdivision step out of geom. The native box
+ * clipper is tried first, GEOS takes what it declines and any clip that
+ * has to be snapped to a grid. Returns NULL when nothing is left.
+ */
+static LWGEOM *
+lwgeom_subdivide_clip(const LWGEOM *geom, const GBOX *box, double gridSize)
+{
+	LWGEOM *clipped = NULL;
+
+	if (gridSize < 0)
+		clipped = lwgeom_clip_by_rect_native(geom, box->xmin, box->ymin, box->xmax, box->ymax, LW_TRUE);
+	if (!clipped)
+	{
+		LWGEOM *subbox = (LWGEOM *)lwpoly_construct_envelope(
+		    geom->srid, box->xmin, box->ymin, box->xmax, box->ymax);
+		clipped = lwgeom_intersection_prec(geom, subbox, gridSize);
+		lwgeom_free(subbox);
+	}
+	if (!clipped)
+		return NULL;
+	lwgeom_simplify_in_place(clipped, 0.0, LW_TRUE);
+	if (lwgeom_is_empty(clipped))
+	{
+		lwgeom_free(clipped);
+		return NULL;
+	}
+	return clipped;
+}
+
 /* Prototype for recursion */
 static void lwgeom_subdivide_recursive(const LWGEOM *geom,
 				       uint8_t dimension,
@@ -2418,24 +2448,16 @@ lwgeom_subdivide_recursive(const LWGEOM *geom,
 	++depth;
 
 	{
-		LWGEOM *subbox = (LWGEOM *)lwpoly_construct_envelope(
-		    geom->srid, subbox1.xmin, subbox1.ymin, subbox1.xmax, subbox1.ymax);
-		LWGEOM *clipped = lwgeom_intersection_prec(geom, subbox, gridSize);
-		lwgeom_simplify_in_place(clipped, 0.0, LW_TRUE);
-		lwgeom_free(subbox);
-		if (clipped && !lwgeom_is_empty(clipped))
+		LWGEOM *clipped = lwgeom_subdivide_clip(geom, &subbox1, gridSize);
+		if (clipped)
 		{
 			lwgeom_subdivide_recursive(clipped, dimension, maxvertices, depth, col, gridSize);
 			lwgeom_free(clipped);
 		}
 	}
 	{
-		LWGEOM *subbox = (LWGEOM *)lwpoly_construct_envelope(
-		    geom->srid, subbox2.xmin, subbox2.ymin, subbox2.xmax, subbox2.ymax);
-		LWGEOM *clipped = lwgeom_intersection_prec(geom, subbox, gridSize);
-		lwgeom_simplify_in_place(clipped, 0.0, LW_TRUE);
-		lwgeom_free(subbox);
-		if (clipped && !lwgeom_is_empty(clipped))
+		LWGEOM *clipped = lwgeom_subdivide_clip(geom, &subbox2, gridSize);
+		if (clipped)
 		{
 			lwgeom_subdivide_recursive(clipped, dimension, maxvertices, depth, col, gridSize);
 			lwgeom_free(clipped);
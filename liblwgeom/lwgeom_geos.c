@@ -703,13 +703,17 @@ lwgeom_intersection(const LWGEOM* g1, const LWGEOM* g2)
 
 LWGEOM*
 lwgeom_intersection_prec(const LWGEOM* geom1, const LWGEOM* geom2, double prec)
+{
+	return lwgeom_intersection_prec_geos(geom1, NULL, geom2, NULL, prec);
+}
+
+LWGEOM*
+lwgeom_intersection_prec_geos(const LWGEOM* geom1, const GEOSGeometry* geos1, const LWGEOM* geom2, const GEOSGeometry* geos2, double prec)
 {
 	LWGEOM* result;
 	int32_t srid = RESULT_SRID(geom1, geom2);
 	uint8_t is3d = (FLAGS_GET_Z(geom1->flags) || FLAGS_GET_Z(geom2->flags));
-	GEOSGeometry* g1;
-	GEOSGeometry* g2;
-	GEOSGeometry* g3;
+	GEOSGeometry *g1 = NULL, *g2 = NULL, *g3;
 
 	if (srid == SRID_INVALID) return NULL;
 
@@ -721,8 +725,17 @@ lwgeom_intersection_prec(const LWGEOM* geom1, const LWGEOM* geom2, double prec)
 
 	initGEOS(lwnotice, lwgeom_geos_error);
 
-	if (!(g1 = LWGEOM2GEOS(geom1, AUTOFIX))) GEOS_FAIL();
-	if (!(g2 = LWGEOM2GEOS(geom2, AUTOFIX))) GEOS_FREE_AND_FAIL(g1);
+	/* Convert the arguments the caller has no GEOS geometry for */
+	if (!geos1)
+	{
+		if (!(g1 = LWGEOM2GEOS(geom1, AUTOFIX))) GEOS_FAIL();
+		geos1 = g1;
+	}
+	if (!geos2)
+	{
+		if (!(g2 = LWGEOM2GEOS(geom2, AUTOFIX))) GEOS_FREE_AND_FAIL(g1);
+		geos2 = g2;
+	}
 
 	if ( prec >= 0) {
 #if POSTGIS_GEOS_VERSION < 30900
@@ -730,15 +743,15 @@ lwgeom_intersection_prec(const LWGEOM* geom1, const LWGEOM* geom2, double prec)
 		GEOS_FREE_AND_FAIL(g1, g2);
 		return NULL;
 #else
-		g3 = GEOSIntersectionPrec(g1, g2, prec);
+		g3 = GEOSIntersectionPrec(geos1, geos2, prec);
 #endif
 	}
 	else
 	{
-		g3 = GEOSIntersection(g1, g2);
+		g3 = GEOSIntersection(geos1, geos2);
 	}
 
-	if (!g3) GEOS_FREE_AND_FAIL(g1);
+	if (!g3) GEOS_FREE_AND_FAIL(g1, g2);
 	GEOSSetSRID(g3, srid);
 
 	if (!(result = GEOS2LWGEOM(g3, is3d))) GEOS_FREE_AND_FAIL(g1, g2, g3);
@@ -835,11 +848,17 @@ lwgeom_difference(const LWGEOM* geom1, const LWGEOM* geom2)
 
 LWGEOM*
 lwgeom_difference_prec(const LWGEOM* geom1, const LWGEOM* geom2, double prec)
+{
+	return lwgeom_difference_prec_geos(geom1, NULL, geom2, NULL, prec);
+}
+
+LWGEOM*
+lwgeom_difference_prec_geos(const LWGEOM* geom1, const GEOSGeometry* geos1, const LWGEOM* geom2, const GEOSGeometry* geos2, double prec)
 {
 	LWGEOM* result;
 	int32_t srid = RESULT_SRID(geom1, geom2);
 	uint8_t is3d = (FLAGS_GET_Z(geom1->flags) || FLAGS_GET_Z(geom2->flags));
-	GEOSGeometry *g1, *g2, *g3;
+	GEOSGeometry *g1 = NULL, *g2 = NULL, *g3;
 
 	if (srid == SRID_INVALID) return NULL;
 
@@ -851,8 +870,17 @@ lwgeom_difference_prec(const LWGEOM* geom1, const LWGEOM* geom2, double prec)
 
 	initGEOS(lwnotice, lwgeom_geos_error);
 
-	if (!(g1 = LWGEOM2GEOS(geom1, AUTOFIX))) GEOS_FAIL();
-	if (!(g2 = LWGEOM2GEOS(geom2, AUTOFIX))) GEOS_FREE_AND_FAIL(g1);
+	/* Convert the arguments the caller has no GEOS geometry for */
+	if (!geos1)
+	{
+		if (!(g1 = LWGEOM2GEOS(geom1, AUTOFIX))) GEOS_FAIL();
+		geos1 = g1;
+	}
+	if (!geos2)
+	{
+		if (!(g2 = LWGEOM2GEOS(geom2, AUTOFIX))) GEOS_FREE_AND_FAIL(g1);
+		geos2 = g2;
+	}
 
 	if ( prec >= 0) {
 #if POSTGIS_GEOS_VERSION < 30900
@@ -860,12 +888,12 @@ lwgeom_difference_prec(const LWGEOM* geom1, const LWGEOM* geom2, double prec)
 		GEOS_FREE_AND_FAIL(g1, g2);
 		return NULL;
 #else
-		g3 = GEOSDifferencePrec(g1, g2, prec);
+		g3 = GEOSDifferencePrec(geos1, geos2, prec);
 #endif
 	}
 	else
 	{
-		g3 = GEOSDifference(g1, g2);
+		g3 = GEOSDifference(geos1, geos2);
 	}
 
 	if (!g3) GEOS_FREE_AND_FAIL(g1, g2);
@@ -886,11 +914,17 @@ lwgeom_symdifference(const LWGEOM* geom1, const LWGEOM* geom2)
 
 LWGEOM*
 lwgeom_symdifference_prec(const LWGEOM* geom1, const LWGEOM* geom2, double prec)
+{
+	return lwgeom_symdifference_prec_geos(geom1, NULL, geom2, NULL, prec);
+}
+
+LWGEOM*
+lwgeom_symdifference_prec_geos(const LWGEOM* geom1, const GEOSGeometry* geos1, const LWGEOM* geom2, const GEOSGeometry* geos2, double prec)
 {
 	LWGEOM* result;
 	int32_t srid = RESULT_SRID(geom1, geom2);
 	uint8_t is3d = (FLAGS_GET_Z(geom1->flags) || FLAGS_GET_Z(geom2->flags));
-	GEOSGeometry *g1, *g2, *g3;
+	GEOSGeometry *g1 = NULL, *g2 = NULL, *g3;
 
 	if (srid == SRID_INVALID) return NULL;
 
@@ -902,8 +936,17 @@ lwgeom_symdifference_prec(const LWGEOM* geom1, const LWGEOM* geom2, double prec)
 
 	initGEOS(lwnotice, lwgeom_geos_error);
 
-	if (!(g1 = LWGEOM2GEOS(geom1, AUTOFIX))) GEOS_FAIL();
-	if (!(g2 = LWGEOM2GEOS(geom2, AUTOFIX))) GEOS_FREE_AND_FAIL(g1);
+	/* Convert the arguments the caller has no GEOS geometry for */
+	if (!geos1)
+	{
+		if (!(g1 = LWGEOM2GEOS(geom1, AUTOFIX))) GEOS_FAIL();
+		geos1 = g1;
+	}
+	if (!geos2)
+	{
+		if (!(g2 = LWGEOM2GEOS(geom2, AUTOFIX))) GEOS_FREE_AND_FAIL(g1);
+		geos2 = g2;
+	}
 
 	if ( prec >= 0) {
 #if POSTGIS_GEOS_VERSION < 30900
@@ -911,12 +954,12 @@ lwgeom_symdifference_prec(const LWGEOM* geom1, const LWGEOM* geom2, double prec)
 		GEOS_FREE_AND_FAIL(g1, g2);
 		return NULL;
 #else
-		g3 = GEOSSymDifferencePrec(g1, g2, prec);
+		g3 = GEOSSymDifferencePrec(geos1, geos2, prec);
 #endif
 	}
 	else
 	{
-		g3 = GEOSSymDifference(g1, g2);
+		g3 = GEOSSymDifference(geos1, geos2);
 	}
 
 	if (!g3) GEOS_FREE_AND_FAIL(g1, g2);
@@ -1093,6 +1136,11 @@ lwgeom_clip_by_rect(const LWGEOM *geom1, double x1, double y1, double x2, double
 	if ( lwgeom_is_empty(geom1) )
 		return lwgeom_clone_deep(geom1);
 
+	/* Most inputs are clipped without leaving liblwgeom, GEOS takes the rest */
+	result = lwgeom_clip_by_rect_native(geom1, x1, y1, x2, y2, LW_FALSE);
+	if (result)
+		return result;
+
 	is3d = FLAGS_GET_Z(geom1->flags);
 
 	initGEOS(lwnotice, lwgeom_geos_error);
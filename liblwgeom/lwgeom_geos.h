@@ -48,5 +48,14 @@ int union_dbscan(LWGEOM **geoms, uint32_t num_geoms, UNIONFIND *uf, double eps,
 
 POINTARRAY* ptarray_from_GEOSCoordSeq(const GEOSCoordSequence* cs, uint8_t want3d);
 
+/*
+** Overlay functions taking the GEOS conversion of either argument
+** when the caller already has it (NULL to convert the LWGEOM).
+** The GEOS geometries passed in are not modified nor freed.
+*/
+LWGEOM* lwgeom_intersection_prec_geos(const LWGEOM* geom1, const GEOSGeometry* geos1, const LWGEOM* geom2, const GEOSGeometry* geos2, double prec);
+LWGEOM* lwgeom_difference_prec_geos(const LWGEOM* geom1, const GEOSGeometry* geos1, const LWGEOM* geom2, const GEOSGeometry* geos2, double prec);
+LWGEOM* lwgeom_symdifference_prec_geos(const LWGEOM* geom1, const GEOSGeometry* geos1, const LWGEOM* geom2, const GEOSGeometry* geos2, double prec);
+
 extern char lwgeom_geos_errmsg[];
 extern void lwgeom_geos_error(const char* fmt, ...);
@@ -31,6 +31,11 @@
 
 static const int STRTREE_NODE_CAPACITY = 10;
 
+/* Largest number of cells across a point grid, so cell numbers stay exact */
+static const double POINT_GRID_MAX_CELLS = 1125899906842624.0; /* 2^50 */
+/* Largest single allocation lwalloc can make inside PostgreSQL (MaxAllocSize) */
+static const size_t POINT_GRID_MAX_ALLOC = 0x3fffffff;
+
 /* Utility struct used to accumulate items in GEOSSTRtree_query callback */
 struct QueryContext
 {
@@ -48,6 +53,41 @@ struct STRTree
 	uint32_t num_geoms;
 };
 
+/* Input point binned into a square grid cell */
+struct GridPoint
+{
+	int64_t row;
+	int64_t col;
+	uint32_t id;
+};
+
+/* Occupied grid cell.  For each of the rows above, at and below the cell,
+ * start and end delimit the points in that row's three cells around it. */
+struct GridCell
+{
+	int64_t row;
+	int64_t col;
+	uint32_t first;
+	uint32_t start[3];
+	uint32_t end[3];
+};
+
+/* Utility struct to look up the points near a point without a GEOSSTRtree.
+ * Cells are at least eps wide, so every point within eps of a point lies in
+ * the 3x3 block of cells around it. Point ids are sorted by row then column,
+ * which makes the three cells of each row in that block one contiguous run. */
+struct PointGrid
+{
+	uint32_t* ids;
+	uint32_t num_points;
+	uint32_t* cell_of;
+	struct GridCell* cells;
+	uint32_t num_cells;
+	double xmin;
+	double ymin;
+	double cell_size;
+};
+
 static struct STRTree make_strtree(void** geoms, uint32_t num_geoms, char is_lwgeom);
 static void destroy_strtree(struct STRTree * tree);
 static int union_intersecting_pairs(GEOSGeometry** geoms, uint32_t num_geoms, UNIONFIND* uf);
@@ -260,6 +300,169 @@ cluster_intersecting(GEOSGeometry** geoms, uint32_t num_geoms, GEOSGeometry*** c
 	return cluster_success;
 }
 
+static int
+grid_point_cmp(const void* a, const void* b)
+{
+	const struct GridPoint* pa = a;
+	const struct GridPoint* pb = b;
+	if (pa->row != pb->row)
+		return pa->row < pb->row ? -1 : 1;
+	if (pa->col != pb->col)
+		return pa->col < pb->col ? -1 : 1;
+	return pa->id < pb->id ? -1 : (pa->id > pb->id ? 1 : 0);
+}
+
+/* Is cell c before (row, col) in row-major order? */
+static inline int
+grid_cell_lt(const struct GridCell* c, int64_t row, int64_t col)
+{
+	return c->row < row || (c->row == row && c->col < col);
+}
+
+/* Bin the inputs into a grid of cells eps wide.  Returns LW_FAILURE, leaving
+ * the caller to use a GEOSSTRtree, if any input is not a point, if eps is
+ * too small against the extent for the cell numbers to stay exact, or if
+ * there are too many inputs for the cell table to fit in one allocation.
+ */
+static int
+make_point_grid(LWGEOM** geoms, uint32_t num_geoms, double eps, struct PointGrid* grid)
+{
+	uint32_t i, c;
+	int d;
+	double xmin = DBL_MAX, ymin = DBL_MAX, xmax = -DBL_MAX, ymax = -DBL_MAX;
+	double max_abs;
+	struct GridPoint* points;
+
+	memset(grid, 0, sizeof(struct PointGrid));
+
+	if ((size_t)num_geoms + 1 > POINT_GRID_MAX_ALLOC / sizeof(struct GridCell))
+		return LW_FAILURE;
+
+	for (i = 0; i < num_geoms; i++)
+	{
+		const POINT2D* pt;
+		if (lwgeom_get_type(geoms[i]) != POINTTYPE)
+			return LW_FAILURE;
+		if (lwgeom_is_empty(geoms[i]))
+			continue;
+		pt = getPoint2d_cp(lwgeom_as_lwpoint(geoms[i])->point, 0);
+		xmin = FP_MIN(xmin, pt->x);
+		ymin = FP_MIN(ymin, pt->y);
+		xmax = FP_MAX(xmax, pt->x);
+		ymax = FP_MAX(ymax, pt->y);
+	}
+
+	/* Pad the cell by the rounding error of computing cell numbers, so that
+	 * points within eps never land more than one cell apart. */
+	max_abs = FP_MAX(FP_MAX(fabs(xmin), fabs(xmax)), FP_MAX(fabs(ymin), fabs(ymax)));
+	grid->cell_size = eps + 8 * DBL_EPSILON * max_abs;
+	grid->xmin = xmin;
+	grid->ymin = ymin;
+
+	if (!(grid->cell_size > 0) ||
+	    !((xmax - xmin) / grid->cell_size < POINT_GRID_MAX_CELLS) ||
+	    !((ymax - ymin) / grid->cell_size < POINT_GRID_MAX_CELLS))
+		return LW_FAILURE;
+
+	points = lwalloc(num_geoms * sizeof(struct GridPoint));
+	for (i = 0; i < num_geoms; i++)
+	{
+		const POINT2D* pt;
+		struct GridPoint* gp;
+		if (lwgeom_is_empty(geoms[i]))
+			continue;
+		pt = getPoint2d_cp(lwgeom_as_lwpoint(geoms[i])->point, 0);
+		gp = &(points[grid->num_points++]);
+		gp->row = (int64_t) floor((pt->y - grid->ymin) / grid->cell_size);
+		gp->col = (int64_t) floor((pt->x - grid->xmin) / grid->cell_size);
+		gp->id = i;
+	}
+	qsort(points, grid->num_points, sizeof(struct GridPoint), grid_point_cmp);
+
+	/* Collapse the sorted points into runs of occupied cells */
+	grid->ids = lwalloc(grid->num_points * sizeof(uint32_t));
+	grid->cell_of = lwalloc(num_geoms * sizeof(uint32_t));
+	grid->cells = lwalloc((grid->num_points + 1) * sizeof(struct GridCell));
+	for (i = 0; i < grid->num_points; i++)
+	{
+		if (i == 0 || points[i].row != points[i-1].row || points[i].col != points[i-1].col)
+		{
+			struct GridCell* cell = &(grid->cells[grid->num_cells++]);
+			cell->row = points[i].row;
+			cell->col = points[i].col;
+			cell->first = i;
+		}
+		grid->ids[i] = points[i].id;
+		grid->cell_of[points[i].id] = grid->num_cells - 1;
+	}
+	lwfree(points);
+
+	/* Sentinel past the last cell, so every run ends at a cell's first point */
+	grid->cells[grid->num_cells].first = grid->num_points;
+
+	/* The runs around each cell move forward with the cells, so one sweep
+	 * per row offset finds them all. */
+	for (d = -1; d <= 1; d++)
+	{
+		uint32_t lo = 0, hi = 0;
+		for (c = 0; c < grid->num_cells; c++)
+		{
+			struct GridCell* cell = &(grid->cells[c]);
+			int64_t row = cell->row + d;
+			while (lo < grid->num_cells && grid_cell_lt(&(grid->cells[lo]), row, cell->col - 1))
+				lo++;
+			if (hi < lo)
+				hi = lo;
+			while (hi < grid->num_cells && grid_cell_lt(&(grid->cells[hi]), row, cell->col + 2))
+				hi++;
+			cell->start[d + 1] = grid->cells[lo].first;
+			cell->end[d + 1] = grid->cells[hi].first;
+		}
+	}
+
+	return LW_SUCCESS;
+}
+
+static void
+destroy_point_grid(struct PointGrid* grid)
+{
+	if (grid->ids)
+		lwfree(grid->ids);
+	if (grid->cell_of)
+		lwfree(grid->cell_of);
+	if (grid->cells)
+		lwfree(grid->cells);
+}
+
+static void
+point_grid_update_context(const struct PointGrid* grid, struct QueryContext* cxt, uint32_t p)
+{
+	const struct GridCell* cell = &(grid->cells[grid->cell_of[p]]);
+	uint32_t d, k;
+
+	cxt->num_items_found = 0;
+	for (d = 0; d < 3; d++)
+	{
+		for (k = cell->start[d]; k < cell->end[d]; k++)
+			query_accumulate(&(grid->ids[k]), cxt);
+	}
+}
+
+/* Distance between two inputs, computed directly when both are points */
+static inline double
+dbscan_mindistance(const LWGEOM* g1, const LWGEOM* g2, double eps)
+{
+	if (g1->type == POINTTYPE && g2->type == POINTTYPE)
+	{
+		const POINT2D* p1 = getPoint2d_cp(lwgeom_as_lwpoint(g1)->point, 0);
+		const POINT2D* p2 = getPoint2d_cp(lwgeom_as_lwpoint(g2)->point, 0);
+		double hside = p2->x - p1->x;
+		double vside = p2->y - p1->y;
+		return sqrt(hside * hside + vside * vside);
+	}
+	return lwgeom_mindistance2d_tolerance(g1, g2, eps);
+}
+
 static int
 dbscan_update_context(GEOSSTRtree* tree, struct QueryContext* cxt, LWGEOM** geoms, uint32_t p, double eps)
 {
@@ -326,6 +529,8 @@ union_dbscan_minpoints_1(LWGEOM** geoms, uint32_t num_geoms, UNIONFIND* uf, doub
 		.items_found_size = 0
 	};
 	int success = LW_SUCCESS;
+	int use_grid;
+	struct PointGrid grid;
 
 	if (in_a_cluster_ret)
 	{
@@ -338,11 +543,16 @@ union_dbscan_minpoints_1(LWGEOM** geoms, uint32_t num_geoms, UNIONFIND* uf, doub
 	if (num_geoms <= 1)
 		return LW_SUCCESS;
 
-	tree = make_strtree((void**) geoms, num_geoms, LW_TRUE);
-	if (tree.tree == NULL)
+	use_grid = make_point_grid(geoms, num_geoms, eps, &grid);
+	if (!use_grid)
 	{
-		destroy_strtree(&tree);
-		return LW_FAILURE;
+		destroy_point_grid(&grid);
+		tree = make_strtree((void**) geoms, num_geoms, LW_TRUE);
+		if (tree.tree == NULL)
+		{
+			destroy_strtree(&tree);
+			return LW_FAILURE;
+		}
 	}
 
 	for (p = 0; p < num_geoms; p++)
@@ -350,14 +560,17 @@ union_dbscan_minpoints_1(LWGEOM** geoms, uint32_t num_geoms, UNIONFIND* uf, doub
 		if (lwgeom_is_empty(geoms[p]))
 			continue;
 
-		dbscan_update_context(tree.tree, &cxt, geoms, p, eps);
+		if (use_grid)
+			point_grid_update_context(&grid, &cxt, p);
+		else
+			dbscan_update_context(tree.tree, &cxt, geoms, p, eps);
 		for (i = 0; i < cxt.num_items_found; i++)
 		{
 			uint32_t q = *((uint32_t*) cxt.items_found[i]);
 
 			if (UF_find(uf, p) != UF_find(uf, q))
 			{
-				double mindist = lwgeom_mindistance2d_tolerance(geoms[p], geoms[q], eps);
+				double mindist = dbscan_mindistance(geoms[p], geoms[q], eps);
 				if (mindist == FLT_MAX)
 				{
 					success = LW_FAILURE;
@@ -373,7 +586,10 @@ union_dbscan_minpoints_1(LWGEOM** geoms, uint32_t num_geoms, UNIONFIND* uf, doub
 	if (cxt.items_found)
 		lwfree(cxt.items_found);
 
-	destroy_strtree(&tree);
+	if (use_grid)
+		destroy_point_grid(&grid);
+	else
+		destroy_strtree(&tree);
 
 	return success;
 }
@@ -393,6 +609,8 @@ union_dbscan_general(LWGEOM** geoms, uint32_t num_geoms, UNIONFIND* uf, double e
 	uint32_t* neighbors;
 	char* in_a_cluster;
 	char* is_in_core;
+	int use_grid;
+	struct PointGrid grid;
 
 	in_a_cluster = lwalloc(num_geoms * sizeof(char));
 	memset(in_a_cluster, 0, num_geoms * sizeof(char));
@@ -408,11 +626,16 @@ union_dbscan_general(LWGEOM** geoms, uint32_t num_geoms, UNIONFIND* uf, double e
 		return LW_SUCCESS;
 	}
 
-	tree = make_strtree((void**) geoms, num_geoms, LW_TRUE);
-	if (tree.tree == NULL)
+	use_grid = make_point_grid(geoms, num_geoms, eps, &grid);
+	if (!use_grid)
 	{
-		destroy_strtree(&tree);
-		return LW_FAILURE;
+		destroy_point_grid(&grid);
+		tree = make_strtree((void**) geoms, num_geoms, LW_TRUE);
+		if (tree.tree == NULL)
+		{
+			destroy_strtree(&tree);
+			return LW_FAILURE;
+		}
 	}
 
 	is_in_core = lwalloc(num_geoms * sizeof(char));
@@ -426,7 +649,10 @@ union_dbscan_general(LWGEOM** geoms, uint32_t num_geoms, UNIONFIND* uf, double e
 		if (lwgeom_is_empty(geoms[p]))
 			continue;
 
-		dbscan_update_context(tree.tree, &cxt, geoms, p, eps);
+		if (use_grid)
+			point_grid_update_context(&grid, &cxt, p);
+		else
+			dbscan_update_context(tree.tree, &cxt, geoms, p, eps);
 
 		/* We didn't find enough points to do anything, even if they are all within eps. */
 		if (cxt.num_items_found < min_points)
@@ -452,7 +678,7 @@ union_dbscan_general(LWGEOM** geoms, uint32_t num_geoms, UNIONFIND* uf, double e
 					continue;
 			}
 
-			double mindist = lwgeom_mindistance2d_tolerance(geoms[p], geoms[q], eps);
+			double mindist = dbscan_mindistance(geoms[p], geoms[q], eps);
 			if (mindist == FLT_MAX)
 			{
 				success = LW_FAILURE;
@@ -507,7 +733,10 @@ union_dbscan_general(LWGEOM** geoms, uint32_t num_geoms, UNIONFIND* uf, double e
 	if (cxt.items_found)
 		lwfree(cxt.items_found);
 
-	destroy_strtree(&tree);
+	if (use_grid)
+		destroy_point_grid(&grid);
+	else
+		destroy_strtree(&tree);
 	return success;
 }
 
@@ -406,3 +406,174 @@ lwgeom_transform(LWGEOM *geom, LWPROJ *pj)
 	}
 	return LW_SUCCESS;
 }
+
+#if POSTGIS_PROJ_VERSION >= 61
+/* Append all point arrays of a geometry to a growing list */
+static void
+lwgeom_collect_ptarrays(const LWGEOM *geom, POINTARRAY ***pas, uint32_t *npas, uint32_t *maxpas)
+{
+	uint32_t i;
+
+	if (lwgeom_is_empty(geom))
+		return;
+
+	switch(geom->type)
+	{
+		case POINTTYPE:
+		case LINETYPE:
+		case CIRCSTRINGTYPE:
+		case TRIANGLETYPE:
+		case POLYGONTYPE:
+		{
+			POINTARRAY **rings;
+			uint32_t nrings;
+			if (geom->type == POLYGONTYPE)
+			{
+				rings = ((LWPOLY*)geom)->rings;
+				nrings = ((LWPOLY*)geom)->nrings;
+			}
+			else
+			{
+				rings = &(((LWLINE*)geom)->points);
+				nrings = 1;
+			}
+			for (i = 0; i < nrings; i++)
+			{
+				if (*npas == *maxpas)
+				{
+					*maxpas *= 2;
+					*pas = lwrealloc(*pas, sizeof(POINTARRAY*) * (*maxpas));
+				}
+				(*pas)[(*npas)++] = rings[i];
+			}
+			break;
+		}
+		default:
+		{
+			LWCOLLECTION *g;
+			if (!lwgeom_is_collection(geom))
+			{
+				lwerror("%s: Cannot handle type '%s'", __func__, lwtype_name(geom->type));
+				return;
+			}
+			g = (LWCOLLECTION*)geom;
+			for (i = 0; i < g->ngeoms; i++)
+				lwgeom_collect_ptarrays(g->geoms[i], pas, npas, maxpas);
+			break;
+		}
+	}
+}
+#endif
+
+/**
+ * Transform an array of geometries in-place, all with the same
+ * transformation. Coordinates of all the geometries are handed to PROJ
+ * in a single call, which is much cheaper than a call per geometry when
+ * there are many small ones. NULL entries are skipped.
+ */
+int
+lwgeom_transform_array(LWGEOM **geoms, uint32_t ngeoms, LWPROJ *pj)
+{
+	uint32_t i;
+#if POSTGIS_PROJ_VERSION >= 61
+	POINTARRAY **pas;
+	uint32_t npas = 0, maxpas = 16;
+	size_t j, n_points = 0, n_converted;
+	double *buf, *b;
+
+	/* Degree/radian handling lives in ptarray_transform */
+	if (proj_angular_input(pj->pj, PJ_FWD) || proj_angular_output(pj->pj, PJ_FWD))
+	{
+		for (i = 0; i < ngeoms; i++)
+			if (geoms[i] && !lwgeom_transform(geoms[i], pj))
+				return LW_FAILURE;
+		return LW_SUCCESS;
+	}
+
+	pas = lwalloc(sizeof(POINTARRAY*) * maxpas);
+	for (i = 0; i < ngeoms; i++)
+		if (geoms[i])
+			lwgeom_collect_ptarrays(geoms[i], &pas, &npas, &maxpas);
+	for (i = 0; i < npas; i++)
+		n_points += pas[i]->npoints;
+
+	if (!n_points)
+	{
+		lwfree(pas);
+		return LW_SUCCESS;
+	}
+
+	/*
+	 * Gather XYZT of all points. Time matches what ptarray_transform
+	 * passes: zero for single points (proj_trans), none for the others
+	 * (proj_trans_generic without a time array).
+	 */
+	buf = lwalloc(sizeof(double) * 4 * n_points);
+	b = buf;
+	for (i = 0; i < npas; i++)
+	{
+		const POINTARRAY *pa = pas[i];
+		const double *pa_double = (const double*)(pa->serialized_pointlist);
+		size_t stride = FLAGS_NDIMS(pa->flags);
+		int has_z = ptarray_has_z(pa);
+		double t = pa->npoints == 1 ? 0.0 : HUGE_VAL;
+		for (j = 0; j < pa->npoints; j++, pa_double += stride, b += 4)
+		{
+			b[0] = pa_double[0];
+			b[1] = pa_double[1];
+			b[2] = has_z ? pa_double[2] : 0.0;
+			b[3] = t;
+		}
+	}
+
+	n_converted = proj_trans_generic(pj->pj,
+					 PJ_FWD,
+					 buf, 4 * sizeof(double), n_points, /* X */
+					 buf + 1, 4 * sizeof(double), n_points, /* Y */
+					 buf + 2, 4 * sizeof(double), n_points, /* Z */
+					 buf + 3, 4 * sizeof(double), n_points /* T */
+	);
+
+	if (n_converted != n_points)
+	{
+		lwfree(buf);
+		lwfree(pas);
+		lwerror("%s: converted (%d) != input (%d)", __func__, n_converted, n_points);
+		return LW_FAILURE;
+	}
+
+	int pj_errno_val = proj_errno_reset(pj->pj);
+	if (pj_errno_val)
+	{
+		lwfree(buf);
+		lwfree(pas);
+		lwerror("transform: %s (%d)", proj_errno_string(pj_errno_val), pj_errno_val);
+		return LW_FAILURE;
+	}
+
+	/* Scatter the results back */
+	b = buf;
+	for (i = 0; i < npas; i++)
+	{
+		POINTARRAY *pa = pas[i];
+		double *pa_double = (double*)(pa->serialized_pointlist);
+		size_t stride = FLAGS_NDIMS(pa->flags);
+		int has_z = ptarray_has_z(pa);
+		for (j = 0; j < pa->npoints; j++, pa_double += stride, b += 4)
+		{
+			pa_double[0] = b[0];
+			pa_double[1] = b[1];
+			if (has_z)
+				pa_double[2] = b[2];
+		}
+	}
+
+	lwfree(buf);
+	lwfree(pas);
+#else
+	for (i = 0; i < ngeoms; i++)
+		if (geoms[i] && !lwgeom_transform(geoms[i], pj))
+			return LW_FAILURE;
+#endif
+	return LW_SUCCESS;
+}
@@ -899,6 +899,542 @@ void lwgeom_parser_result_free(LWGEOM_PARSER_RESULT *parser_result)
 	   it is a const *char */
 }
 
+/*
+* Hand-written fast path for the common WKT types.
+*
+* The flex/bison pipeline grows a POINTARRAY one coordinate at a time and
+* pays the token-by-token overhead of the generated lexer. For the simple
+* feature types (POINT, LINESTRING, POLYGON and their MULTI* forms) this
+* recursive descent reader counts the coordinates of each list first,
+* allocates the POINTARRAY once at its final size and reads the ordinates
+* straight into it.
+*
+* The fast path accepts exactly the subset of the grammar it understands.
+* Anything else (curves, collections, NaN, unusual number formats, empty
+* sub-geometries, failed validity checks, syntax errors) makes it give up
+* without side effects, and lwgeom_parse_wkt() falls back to the grammar,
+* which also takes care of producing the error messages and locations.
+*/
+
+typedef struct
+{
+	const char *cur;   /* read position */
+	int check;         /* LW_PARSER_CHECK_* flags */
+	int tagdims;       /* ordinates implied by a Z/M/ZM tag, 0 if untagged */
+	int ndims;         /* ordinates per coordinate, 0 until the first one */
+	int hasz;
+	int hasm;
+}
+wkt_fast_state;
+
+/* Powers of ten that are exactly representable as doubles */
+static const double wkt_fast_pow10[] =
+{
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+	1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+	1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static inline void
+wkt_fast_skip_space(wkt_fast_state *s)
+{
+	while ( *s->cur == ' ' || *s->cur == '\t' || *s->cur == '\n' || *s->cur == '\r' )
+		s->cur++;
+}
+
+static inline int
+wkt_fast_is_digit(char c)
+{
+	return c >= '0' && c <= '9';
+}
+
+/*
+* Consume a (case insensitive) keyword at the read position.
+*/
+static int
+wkt_fast_keyword(wkt_fast_state *s, const char *keyword)
+{
+	size_t i;
+	for ( i = 0; keyword[i]; i++ )
+	{
+		if ( toupper((unsigned char)s->cur[i]) != keyword[i] )
+			return LW_FALSE;
+	}
+	s->cur += i;
+	return LW_TRUE;
+}
+
+static inline int
+wkt_fast_char(wkt_fast_state *s, char c)
+{
+	wkt_fast_skip_space(s);
+	if ( *s->cur != c )
+		return LW_FALSE;
+	s->cur++;
+	wkt_fast_skip_space(s);
+	return LW_TRUE;
+}
+
+/*
+* Read one number using the same token shape as the lexer, that is
+* -?(([0-9]+\.?)|([0-9]*\.?[0-9]+)([eE][-+]?[0-9]+)?) followed by a
+* separator. Numbers with at most 19 significant digits and a small
+* decimal exponent are converted exactly with a single multiplication
+* or division, everything else goes through strtod() like the lexer.
+*/
+static int
+wkt_fast_double(wkt_fast_state *s, double *d)
+{
+	const char *start = s->cur;
+	const char *c = start;
+	uint64_t mantissa = 0;
+	int sigdigits = 0;
+	int intdigits = 0;
+	int fracdigits = 0;
+	int exponent = 0;
+	int exact = LW_TRUE;
+	int negative = LW_FALSE;
+
+	if ( *c == '-' )
+	{
+		negative = LW_TRUE;
+		c++;
+	}
+
+	for ( ; wkt_fast_is_digit(*c); c++, intdigits++ )
+	{
+		if ( sigdigits < 19 )
+		{
+			mantissa = mantissa * 10 + (*c - '0');
+			if ( mantissa ) sigdigits++;
+		}
+		else
+		{
+			exponent++;
+			exact = LW_FALSE;
+		}
+	}
+
+	if ( *c == '.' )
+	{
+		c++;
+		for ( ; wkt_fast_is_digit(*c); c++, fracdigits++ )
+		{
+			if ( sigdigits < 19 )
+			{
+				mantissa = mantissa * 10 + (*c - '0');
+				if ( mantissa ) sigdigits++;
+				exponent--;
+			}
+			else
+			{
+				exact = LW_FALSE;
+			}
+		}
+		/* The lexer does not accept an exponent after a bare trailing dot */
+		if ( ! fracdigits && (*c == 'e' || *c == 'E') )
+			return LW_FAILURE;
+	}
+
+	if ( ! (intdigits || fracdigits) )
+		return LW_FAILURE;
+
+	if ( *c == 'e' || *c == 'E' )
+	{
+		int expsign = 1;
+		int expvalue = 0;
+		int expdigits = 0;
+		c++;
+		if ( *c == '-' || *c == '+' )
+		{
+			if ( *c == '-' ) expsign = -1;
+			c++;
+		}
+		for ( ; wkt_fast_is_digit(*c); c++, expdigits++ )
+		{
+			if ( expdigits < 5 )
+				expvalue = expvalue * 10 + (*c - '0');
+			else
+				exact = LW_FALSE;
+		}
+		if ( ! expdigits )
+			return LW_FAILURE;
+		exponent += expsign * expvalue;
+	}
+
+	/* Same terminators as the lexer's DOUBLE rule */
+	if ( ! (*c == ' ' || *c == ',' || *c == ')' || *c == '\t' || *c == '\n' || *c == '\r') )
+		return LW_FAILURE;
+
+	/*
+	* A mantissa below 2^53 and a power of ten below 1e23 are both exact
+	* doubles, so one IEEE operation yields the correctly rounded result,
+	* provided the FPU is not evaluating in extended precision.
+	*/
+	if ( FLT_EVAL_METHOD == 0 && exact && mantissa <= (UINT64_C(1) << 53) &&
+	     exponent >= -22 && exponent <= 22 )
+	{
+		double v = (double)mantissa;
+		if ( exponent < 0 )
+			v /= wkt_fast_pow10[-exponent];
+		else
+			v *= wkt_fast_pow10[exponent];
+		*d = negative ? -v : v;
+	}
+	else
+	{
+		*d = strtod(start, NULL);
+	}
+
+	s->cur = c;
+	return LW_SUCCESS;
+}
+
+/*
+* Read one coordinate into a four-slot buffer, fixing the dimensionality
+* of the whole geometry on the first one and enforcing it on the others.
+*/
+static int
+wkt_fast_coord(wkt_fast_state *s, double *ord)
+{
+	int n = 0;
+
+	while ( n < 4 && (wkt_fast_is_digit(*s->cur) || *s->cur == '-' || *s->cur == '.') )
+	{
+		if ( ! wkt_fast_double(s, &ord[n++]) )
+			return LW_FAILURE;
+		wkt_fast_skip_space(s);
+	}
+
+	if ( n < 2 )
+		return LW_FAILURE;
+
+	if ( ! s->ndims )
+	{
+		if ( s->tagdims && s->tagdims != n )
+			return LW_FAILURE;
+		s->ndims = n;
+		if ( ! s->tagdims )
+		{
+			s->hasz = (n > 2);
+			s->hasm = (n > 3);
+		}
+	}
+	else if ( s->ndims != n )
+	{
+		return LW_FAILURE;
+	}
+
+	return LW_SUCCESS;
+}
+
+/*
+* Read a parenthesized coordinate list into a POINTARRAY that is
+* allocated once, at its final size.
+*/
+static POINTARRAY *
+wkt_fast_ptarray(wkt_fast_state *s)
+{
+	POINTARRAY *pa;
+	const char *c;
+	uint32_t npoints = 1;
+	uint32_t i;
+	double ord[4];
+
+	if ( ! wkt_fast_char(s, '(') )
+		return NULL;
+
+	/* Count the coordinates up to the closing bracket */
+	for ( c = s->cur; *c != ')'; c++ )
+	{
+		if ( *c == ',' )
+			npoints++;
+		else if ( *c == '(' || *c == '\0' )
+			return NULL;
+	}
+
+	if ( ! wkt_fast_coord(s, ord) )
+		return NULL;
+
+	pa = ptarray_construct(s->hasz, s->hasm, npoints);
+	memcpy(getPoint_internal(pa, 0), ord, s->ndims * sizeof(double));
+
+	for ( i = 1; i < npoints; i++ )
+	{
+		if ( ! (wkt_fast_char(s, ',') && wkt_fast_coord(s, ord)) )
+		{
+			ptarray_free(pa);
+			return NULL;
+		}
+		memcpy(getPoint_internal(pa, i), ord, s->ndims * sizeof(double));
+	}
+
+	if ( ! wkt_fast_char(s, ')') )
+	{
+		ptarray_free(pa);
+		return NULL;
+	}
+
+	return pa;
+}
+
+static LWGEOM *
+wkt_fast_linestring(wkt_fast_state *s)
+{
+	POINTARRAY *pa = wkt_fast_ptarray(s);
+
+	if ( ! pa )
+		return NULL;
+
+	if ( (s->check & LW_PARSER_CHECK_MINPOINTS) && pa->npoints < 2 )
+	{
+		ptarray_free(pa);
+		return NULL;
+	}
+
+	return lwline_as_lwgeom(lwline_construct(SRID_UNKNOWN, NULL, pa));
+}
+
+static LWGEOM *
+wkt_fast_polygon(wkt_fast_state *s)
+{
+	LWPOLY *poly = NULL;
+
+	if ( ! wkt_fast_char(s, '(') )
+		return NULL;
+
+	do
+	{
+		POINTARRAY *pa = wkt_fast_ptarray(s);
+
+		if ( ! pa ||
+		     ((s->check & LW_PARSER_CHECK_MINPOINTS) && pa->npoints < 4) ||
+		     ((s->check & LW_PARSER_CHECK_CLOSURE) && ! ptarray_is_closed_2d(pa)) )
+		{
+			if ( pa ) ptarray_free(pa);
+			if ( poly ) lwpoly_free(poly);
+			return NULL;
+		}
+
+		if ( ! poly )
+			poly = lwpoly_construct_empty(SRID_UNKNOWN, s->hasz, s->hasm);
+		lwpoly_add_ring(poly, pa);
+	}
+	while ( wkt_fast_char(s, ',') );
+
+	if ( ! wkt_fast_char(s, ')') )
+	{
+		lwpoly_free(poly);
+		return NULL;
+	}
+
+	return lwpoly_as_lwgeom(poly);
+}
+
+/*
+* Multipoint members come either bare or parenthesized.
+*/
+static LWGEOM *
+wkt_fast_multipoint_member(wkt_fast_state *s)
+{
+	POINTARRAY *pa;
+	double ord[4];
+	int bracketed = wkt_fast_char(s, '(');
+
+	if ( ! wkt_fast_coord(s, ord) )
+		return NULL;
+
+	if ( bracketed && ! wkt_fast_char(s, ')') )
+		return NULL;
+
+	pa = ptarray_construct(s->hasz, s->hasm, 1);
+	memcpy(getPoint_internal(pa, 0), ord, s->ndims * sizeof(double));
+	return lwpoint_as_lwgeom(lwpoint_construct(SRID_UNKNOWN, NULL, pa));
+}
+
+static LWGEOM *
+wkt_fast_multi(wkt_fast_state *s, uint8_t type)
+{
+	LWCOLLECTION *col = NULL;
+
+	if ( ! wkt_fast_char(s, '(') )
+		return NULL;
+
+	do
+	{
+		LWGEOM *geom = NULL;
+
+		switch ( type )
+		{
+			case MULTIPOINTTYPE:
+				geom = wkt_fast_multipoint_member(s);
+				break;
+			case MULTILINETYPE:
+				geom = wkt_fast_linestring(s);
+				break;
+			case MULTIPOLYGONTYPE:
+				geom = wkt_fast_polygon(s);
+				break;
+		}
+
+		if ( ! geom )
+		{
+			if ( col ) lwcollection_free(col);
+			return NULL;
+		}
+
+		if ( ! col )
+			col = lwcollection_construct_empty(type, SRID_UNKNOWN, s->hasz, s->hasm);
+		lwcollection_add_lwgeom(col, geom);
+	}
+	while ( wkt_fast_char(s, ',') );
+
+	if ( ! wkt_fast_char(s, ')') )
+	{
+		lwcollection_free(col);
+		return NULL;
+	}
+
+	return lwcollection_as_lwgeom(col);
+}
+
+/**
+* Parse the common WKT types without going through the grammar.
+* Returns LW_SUCCESS and fills in the parser result when the input was
+* handled, LW_FAILURE (leaving the result untouched) when the caller
+* should fall back to the full parser.
+*/
+int wkt_parser_fast(LWGEOM_PARSER_RESULT *parser_result, char *wktstr, int parser_check_flags)
+{
+	wkt_fast_state s;
+	LWGEOM *geom = NULL;
+	char *sridstr = NULL;
+	int32_t srid = SRID_UNKNOWN;
+	uint8_t type;
+
+	memset(&s, 0, sizeof(wkt_fast_state));
+	s.cur = wktstr;
+	s.check = parser_check_flags;
+
+	wkt_fast_skip_space(&s);
+
+	/* SRID=<number>; prefix */
+	if ( wkt_fast_keyword(&s, "SRID=") )
+	{
+		sridstr = (char*)s.cur - 5;
+		if ( *s.cur == '-' ) s.cur++;
+		if ( ! wkt_fast_is_digit(*s.cur) )
+			return LW_FAILURE;
+		while ( wkt_fast_is_digit(*s.cur) )
+			s.cur++;
+		if ( ! wkt_fast_char(&s, ';') )
+			return LW_FAILURE;
+	}
+
+	/* Longer keywords first, they share prefixes */
+	if ( wkt_fast_keyword(&s, "MULTIPOLYGON") )
+		type = MULTIPOLYGONTYPE;
+	else if ( wkt_fast_keyword(&s, "MULTILINESTRING") )
+		type = MULTILINETYPE;
+	else if ( wkt_fast_keyword(&s, "MULTIPOINT") )
+		type = MULTIPOINTTYPE;
+	else if ( wkt_fast_keyword(&s, "POLYGON") )
+		type = POLYGONTYPE;
+	else if ( wkt_fast_keyword(&s, "LINESTRING") )
+		type = LINETYPE;
+	else if ( wkt_fast_keyword(&s, "POINT") )
+		type = POINTTYPE;
+	else
+		return LW_FAILURE;
+
+	/* Optional Z, M or ZM dimensionality tag */
+	wkt_fast_skip_space(&s);
+	if ( wkt_fast_keyword(&s, "ZM") )
+	{
+		s.hasz = s.hasm = LW_TRUE;
+		s.tagdims = 4;
+	}
+	else if ( wkt_fast_keyword(&s, "Z") )
+	{
+		s.hasz = LW_TRUE;
+		s.tagdims = 3;
+	}
+	else if ( wkt_fast_keyword(&s, "M") )
+	{
+		s.hasm = LW_TRUE;
+		s.tagdims = 3;
+	}
+	wkt_fast_skip_space(&s);
+
+	if ( wkt_fast_keyword(&s, "EMPTY") )
+	{
+		switch ( type )
+		{
+			case POINTTYPE:
+				geom = lwpoint_as_lwgeom(lwpoint_construct_empty(SRID_UNKNOWN, s.hasz, s.hasm));
+				break;
+			case LINETYPE:
+				geom = lwline_as_lwgeom(lwline_construct_empty(SRID_UNKNOWN, s.hasz, s.hasm));
+				break;
+			case POLYGONTYPE:
+				geom = lwpoly_as_lwgeom(lwpoly_construct_empty(SRID_UNKNOWN, s.hasz, s.hasm));
+				break;
+			default:
+				geom = lwcollection_as_lwgeom(lwcollection_construct_empty(type, SRID_UNKNOWN, s.hasz, s.hasm));
+				break;
+		}
+	}
+	else
+	{
+		switch ( type )
+		{
+			case POINTTYPE:
+			{
+				POINTARRAY *pa = wkt_fast_ptarray(&s);
+				if ( pa && pa->npoints != 1 )
+				{
+					ptarray_free(pa);
+					pa = NULL;
+				}
+				if ( pa )
+					geom = lwpoint_as_lwgeom(lwpoint_construct(SRID_UNKNOWN, NULL, pa));
+				break;
+			}
+			case LINETYPE:
+				geom = wkt_fast_linestring(&s);
+				break;
+			case POLYGONTYPE:
+				geom = wkt_fast_polygon(&s);
+				break;
+			default:
+				geom = wkt_fast_multi(&s, type);
+				break;
+		}
+	}
+
+	/* Anything but trailing whitespace is left to the grammar */
+	if ( geom )
+		wkt_fast_skip_space(&s);
+	if ( ! geom || *s.cur != '\0' )
+	{
+		if ( geom ) lwgeom_free(geom);
+		return LW_FAILURE;
+	}
+
+	if ( sridstr )
+		srid = wkt_lexer_read_srid(sridstr);
+	if ( srid != SRID_UNKNOWN && srid <= SRID_MAXIMUM )
+		lwgeom_set_srid(geom, srid);
+	else
+		lwgeom_set_srid(geom, SRID_UNKNOWN);
+
+	lwgeom_parser_result_init(parser_result);
+	parser_result->wkinput = wktstr;
+	parser_result->parser_check_flags = parser_check_flags;
+	parser_result->geom = geom;
+	return LW_SUCCESS;
+}
+
 /*
 * Public function used for easy access to the parser.
 */
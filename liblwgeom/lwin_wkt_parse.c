@@ -123,6 +123,10 @@ int lwgeom_parse_wkt(LWGEOM_PARSER_RESULT *parser_result, char *wktstr, int pars
 {
 	int parse_rv = 0;
 
+	/* Common types are handled without the grammar when possible. */
+	if ( wkt_parser_fast(parser_result, wktstr, parser_check_flags) == LW_SUCCESS )
+		return LW_SUCCESS;
+
 	/* Clean up our global parser result. */
 	lwgeom_parser_result_init(&global_parser_result);
 	/* Work-around possible bug in GNU Bison 3.0.2 resulting in wkt_yylloc
@@ -179,7 +183,7 @@ int lwgeom_parse_wkt(LWGEOM_PARSER_RESULT *parser_result, char *wktstr, int pars
 
 
 
-#line 183 "lwin_wkt_parse.c" /* yacc.c:339  */
+#line 187 "lwin_wkt_parse.c" /* yacc.c:339  */
 
 # ifndef YY_NULLPTR
 #  if defined __cplusplus && 201103L <= __cplusplus
@@ -245,7 +249,7 @@ extern int wkt_yydebug;
 
 union YYSTYPE
 {
-#line 112 "lwin_wkt_parse.y" /* yacc.c:355  */
+#line 116 "lwin_wkt_parse.y" /* yacc.c:355  */
 
 	int integervalue;
 	double doublevalue;
@@ -254,7 +258,7 @@ union YYSTYPE
 	POINT coordinatevalue;
 	POINTARRAY *ptarrayvalue;
 
-#line 258 "lwin_wkt_parse.c" /* yacc.c:355  */
+#line 262 "lwin_wkt_parse.c" /* yacc.c:355  */
 };
 
 typedef union YYSTYPE YYSTYPE;
@@ -285,7 +289,7 @@ int wkt_yyparse (void);
 
 /* Copy the second part of user declarations.  */
 
-#line 289 "lwin_wkt_parse.c" /* yacc.c:358  */
+#line 293 "lwin_wkt_parse.c" /* yacc.c:358  */
 
 #ifdef short
 # undef short
@@ -1366,225 +1370,225 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocatio
   switch (yytype)
     {
           case 28: /* geometry_no_srid  */
-#line 194 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 198 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1372 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1376 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 29: /* geometrycollection  */
-#line 195 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 199 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1378 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1382 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 30: /* geometry_list  */
-#line 196 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 200 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1384 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1388 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 31: /* multisurface  */
-#line 203 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 207 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1390 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1394 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 32: /* surface_list  */
-#line 181 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 185 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1396 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1400 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 33: /* tin  */
-#line 210 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 214 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1402 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1406 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 34: /* polyhedralsurface  */
-#line 209 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 213 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1408 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1412 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 35: /* multipolygon  */
-#line 202 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 206 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1414 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1418 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 36: /* polygon_list  */
-#line 182 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 186 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1420 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1424 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 37: /* patch_list  */
-#line 183 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 187 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1426 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1430 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 38: /* polygon  */
-#line 206 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 210 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1432 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1436 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 39: /* polygon_untagged  */
-#line 208 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 212 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1438 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1442 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 40: /* patch  */
-#line 207 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 211 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1444 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1448 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 41: /* curvepolygon  */
-#line 192 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 196 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1450 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1454 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 42: /* curvering_list  */
-#line 179 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 183 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1456 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1460 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 43: /* curvering  */
-#line 193 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 197 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1462 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1466 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 44: /* patchring_list  */
-#line 189 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 193 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1468 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1472 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 45: /* ring_list  */
-#line 188 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 192 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1474 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1478 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 46: /* patchring  */
-#line 178 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 182 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { ptarray_free(((*yyvaluep).ptarrayvalue)); }
-#line 1480 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1484 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 47: /* ring  */
-#line 177 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 181 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { ptarray_free(((*yyvaluep).ptarrayvalue)); }
-#line 1486 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1490 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 48: /* compoundcurve  */
-#line 191 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 195 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1492 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1496 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 49: /* compound_list  */
-#line 187 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 191 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1498 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1502 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 50: /* multicurve  */
-#line 199 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 203 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1504 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1508 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 51: /* curve_list  */
-#line 186 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 190 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1510 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1514 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 52: /* multilinestring  */
-#line 200 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 204 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1516 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1520 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 53: /* linestring_list  */
-#line 185 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 189 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1522 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1526 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 54: /* circularstring  */
-#line 190 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 194 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1528 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1532 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 55: /* linestring  */
-#line 197 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 201 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1534 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1538 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 56: /* linestring_untagged  */
-#line 198 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 202 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1540 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1544 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 57: /* triangle_list  */
-#line 180 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 184 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1546 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1550 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 58: /* triangle  */
-#line 211 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 215 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1552 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1556 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 59: /* triangle_untagged  */
-#line 212 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 216 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1558 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1562 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 60: /* multipoint  */
-#line 201 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 205 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1564 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1568 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 61: /* point_list  */
-#line 184 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 188 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1570 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1574 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 62: /* point_untagged  */
-#line 205 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 209 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1576 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1580 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 63: /* point  */
-#line 204 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 208 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { lwgeom_free(((*yyvaluep).geometryvalue)); }
-#line 1582 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1586 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
     case 64: /* ptarray  */
-#line 176 "lwin_wkt_parse.y" /* yacc.c:1257  */
+#line 180 "lwin_wkt_parse.y" /* yacc.c:1257  */
       { ptarray_free(((*yyvaluep).ptarrayvalue)); }
-#line 1588 "lwin_wkt_parse.c" /* yacc.c:1257  */
+#line 1592 "lwin_wkt_parse.c" /* yacc.c:1257  */
         break;
 
 
@@ -1870,817 +1874,817 @@ yyreduce:
   switch (yyn)
     {
         case 2:
-#line 218 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 222 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { wkt_parser_geometry_new((yyvsp[0].geometryvalue), SRID_UNKNOWN); WKT_ERROR(); }
-#line 1876 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1880 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 3:
-#line 220 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 224 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { wkt_parser_geometry_new((yyvsp[0].geometryvalue), (yyvsp[-2].integervalue)); WKT_ERROR(); }
-#line 1882 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1886 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 4:
-#line 223 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 227 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1888 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1892 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 5:
-#line 224 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 228 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1894 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1898 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 6:
-#line 225 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 229 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1900 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1904 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 7:
-#line 226 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 230 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1906 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1910 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 8:
-#line 227 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 231 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1912 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1916 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 9:
-#line 228 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 232 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1918 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1922 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 10:
-#line 229 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 233 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1924 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1928 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 11:
-#line 230 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 234 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1930 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1934 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 12:
-#line 231 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 235 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1936 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1940 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 13:
-#line 232 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 236 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1942 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1946 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 14:
-#line 233 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 237 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1948 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1952 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 15:
-#line 234 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 238 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1954 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1958 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 16:
-#line 235 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 239 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1960 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1964 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 17:
-#line 236 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 240 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1966 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1970 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 18:
-#line 237 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 241 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 1972 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1976 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 19:
-#line 241 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 245 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(COLLECTIONTYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
-#line 1978 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1982 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 20:
-#line 243 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 247 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(COLLECTIONTYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 1984 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1988 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 21:
-#line 245 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 249 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(COLLECTIONTYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 1990 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 1994 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 22:
-#line 247 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 251 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(COLLECTIONTYPE, NULL, NULL); WKT_ERROR(); }
-#line 1996 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2000 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 23:
-#line 251 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 255 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2002 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2006 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 24:
-#line 253 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 257 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2008 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2012 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 25:
-#line 257 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 261 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTISURFACETYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
-#line 2014 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2018 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 26:
-#line 259 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 263 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTISURFACETYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 2020 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2024 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 27:
-#line 261 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 265 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTISURFACETYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2026 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2030 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 28:
-#line 263 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 267 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTISURFACETYPE, NULL, NULL); WKT_ERROR(); }
-#line 2032 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2036 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 29:
-#line 267 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 271 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2038 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2042 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 30:
-#line 269 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 273 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2044 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2048 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 31:
-#line 271 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 275 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2050 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2054 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 32:
-#line 273 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 277 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2056 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2060 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 33:
-#line 275 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 279 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2062 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2066 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 34:
-#line 277 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 281 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2068 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2072 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 35:
-#line 281 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 285 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(TINTYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
-#line 2074 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2078 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 36:
-#line 283 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 287 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(TINTYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 2080 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2084 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 37:
-#line 285 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 289 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(TINTYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2086 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2090 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 38:
-#line 287 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 291 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(TINTYPE, NULL, NULL); WKT_ERROR(); }
-#line 2092 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2096 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 39:
-#line 291 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 295 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(POLYHEDRALSURFACETYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
-#line 2098 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2102 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 40:
-#line 293 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 297 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(POLYHEDRALSURFACETYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 2104 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2108 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 41:
-#line 295 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 299 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(POLYHEDRALSURFACETYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2110 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2114 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 42:
-#line 297 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 301 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(POLYHEDRALSURFACETYPE, NULL, NULL); WKT_ERROR(); }
-#line 2116 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2120 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 43:
-#line 301 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 305 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOLYGONTYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
-#line 2122 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2126 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 44:
-#line 303 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 307 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOLYGONTYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 2128 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2132 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 45:
-#line 305 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 309 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOLYGONTYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2134 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2138 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 46:
-#line 307 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 311 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOLYGONTYPE, NULL, NULL); WKT_ERROR(); }
-#line 2140 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2144 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 47:
-#line 311 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 315 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2146 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2150 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 48:
-#line 313 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 317 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2152 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2156 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 49:
-#line 317 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 321 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2158 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2162 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 50:
-#line 319 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 323 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2164 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2168 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 51:
-#line 323 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 327 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_polygon_finalize((yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
-#line 2170 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2174 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 52:
-#line 325 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 329 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_polygon_finalize((yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 2176 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2180 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 53:
-#line 327 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 331 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_polygon_finalize(NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2182 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2186 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 54:
-#line 329 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 333 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_polygon_finalize(NULL, NULL); WKT_ERROR(); }
-#line 2188 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2192 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 55:
-#line 333 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 337 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[-1].geometryvalue); }
-#line 2194 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2198 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 56:
-#line 335 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 339 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_polygon_finalize(NULL, NULL); WKT_ERROR(); }
-#line 2200 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2204 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 57:
-#line 338 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 342 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[-1].geometryvalue); }
-#line 2206 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2210 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 58:
-#line 342 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 346 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_curvepolygon_finalize((yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
-#line 2212 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2216 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 59:
-#line 344 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 348 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_curvepolygon_finalize((yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 2218 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2222 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 60:
-#line 346 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 350 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_curvepolygon_finalize(NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2224 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2228 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 61:
-#line 348 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 352 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_curvepolygon_finalize(NULL, NULL); WKT_ERROR(); }
-#line 2230 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2234 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 62:
-#line 352 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 356 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_curvepolygon_add_ring((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2236 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2240 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 63:
-#line 354 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 358 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_curvepolygon_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2242 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2246 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 64:
-#line 357 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 361 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 2248 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2252 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 65:
-#line 358 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 362 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 2254 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2258 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 66:
-#line 359 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 363 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 2260 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2264 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 67:
-#line 360 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 364 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = (yyvsp[0].geometryvalue); }
-#line 2266 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2270 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 68:
-#line 364 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 368 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_polygon_add_ring((yyvsp[-2].geometryvalue),(yyvsp[0].ptarrayvalue),'Z'); WKT_ERROR(); }
-#line 2272 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2276 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 69:
-#line 366 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 370 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_polygon_new((yyvsp[0].ptarrayvalue),'Z'); WKT_ERROR(); }
-#line 2278 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2282 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 70:
-#line 370 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 374 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_polygon_add_ring((yyvsp[-2].geometryvalue),(yyvsp[0].ptarrayvalue),'2'); WKT_ERROR(); }
-#line 2284 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2288 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 71:
-#line 372 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 376 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_polygon_new((yyvsp[0].ptarrayvalue),'2'); WKT_ERROR(); }
-#line 2290 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2294 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 72:
-#line 375 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 379 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.ptarrayvalue) = (yyvsp[-1].ptarrayvalue); }
-#line 2296 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2300 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 73:
-#line 378 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 382 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.ptarrayvalue) = (yyvsp[-1].ptarrayvalue); }
-#line 2302 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2306 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 74:
-#line 382 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 386 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(COMPOUNDTYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
-#line 2308 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2312 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 75:
-#line 384 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 388 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(COMPOUNDTYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 2314 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2318 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 76:
-#line 386 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 390 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(COMPOUNDTYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2320 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2324 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 77:
-#line 388 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 392 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(COMPOUNDTYPE, NULL, NULL); WKT_ERROR(); }
-#line 2326 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2330 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 78:
-#line 392 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 396 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_compound_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2332 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2336 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 79:
-#line 394 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 398 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_compound_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2338 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2342 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 80:
-#line 396 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 400 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_compound_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2344 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2348 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 81:
-#line 398 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 402 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_compound_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2350 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2354 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 82:
-#line 400 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 404 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_compound_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2356 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2360 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 83:
-#line 402 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 406 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_compound_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2362 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2366 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 84:
-#line 406 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 410 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTICURVETYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
-#line 2368 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2372 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 85:
-#line 408 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 412 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTICURVETYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 2374 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2378 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 86:
-#line 410 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 414 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTICURVETYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2380 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2384 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 87:
-#line 412 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 416 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTICURVETYPE, NULL, NULL); WKT_ERROR(); }
-#line 2386 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2390 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 88:
-#line 416 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 420 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2392 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2396 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 89:
-#line 418 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 422 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2398 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2402 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 90:
-#line 420 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 424 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2404 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2408 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 91:
-#line 422 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 426 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2410 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2414 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 92:
-#line 424 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 428 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2416 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2420 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 93:
-#line 426 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 430 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2422 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2426 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 94:
-#line 428 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 432 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2428 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2432 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 95:
-#line 430 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 434 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2434 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2438 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 96:
-#line 434 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 438 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTILINETYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
-#line 2440 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2444 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 97:
-#line 436 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 440 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTILINETYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 2446 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2450 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 98:
-#line 438 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 442 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTILINETYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2452 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2456 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 99:
-#line 440 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 444 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTILINETYPE, NULL, NULL); WKT_ERROR(); }
-#line 2458 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2462 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 100:
-#line 444 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 448 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2464 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2468 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 101:
-#line 446 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 450 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2470 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2474 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 102:
-#line 450 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 454 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_circularstring_new((yyvsp[-1].ptarrayvalue), NULL); WKT_ERROR(); }
-#line 2476 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2480 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 103:
-#line 452 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 456 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_circularstring_new((yyvsp[-1].ptarrayvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 2482 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2486 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 104:
-#line 454 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 458 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_circularstring_new(NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2488 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2492 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 105:
-#line 456 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 460 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_circularstring_new(NULL, NULL); WKT_ERROR(); }
-#line 2494 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2498 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 106:
-#line 460 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 464 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_linestring_new((yyvsp[-1].ptarrayvalue), NULL); WKT_ERROR(); }
-#line 2500 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2504 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 107:
-#line 462 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 466 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_linestring_new((yyvsp[-1].ptarrayvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 2506 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2510 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 108:
-#line 464 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 468 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_linestring_new(NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2512 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2516 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 109:
-#line 466 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 470 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_linestring_new(NULL, NULL); WKT_ERROR(); }
-#line 2518 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2522 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 110:
-#line 470 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 474 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_linestring_new((yyvsp[-1].ptarrayvalue), NULL); WKT_ERROR(); }
-#line 2524 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2528 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 111:
-#line 472 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 476 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_linestring_new(NULL, NULL); WKT_ERROR(); }
-#line 2530 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2534 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 112:
-#line 476 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 480 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2536 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2540 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 113:
-#line 478 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 482 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2542 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2546 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 114:
-#line 482 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 486 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_triangle_new((yyvsp[-2].ptarrayvalue), NULL); WKT_ERROR(); }
-#line 2548 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2552 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 115:
-#line 484 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 488 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_triangle_new((yyvsp[-2].ptarrayvalue), (yyvsp[-5].stringvalue)); WKT_ERROR(); }
-#line 2554 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2558 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 116:
-#line 486 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 490 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_triangle_new(NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2560 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2564 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 117:
-#line 488 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 492 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_triangle_new(NULL, NULL); WKT_ERROR(); }
-#line 2566 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2570 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 118:
-#line 492 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 496 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_triangle_new((yyvsp[-2].ptarrayvalue), NULL); WKT_ERROR(); }
-#line 2572 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2576 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 119:
-#line 496 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 500 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOINTTYPE, (yyvsp[-1].geometryvalue), NULL); WKT_ERROR(); }
-#line 2578 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2582 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 120:
-#line 498 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 502 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOINTTYPE, (yyvsp[-1].geometryvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 2584 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2588 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 121:
-#line 500 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 504 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOINTTYPE, NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2590 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2594 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 122:
-#line 502 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 506 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_finalize(MULTIPOINTTYPE, NULL, NULL); WKT_ERROR(); }
-#line 2596 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2600 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 123:
-#line 506 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 510 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_add_geom((yyvsp[-2].geometryvalue),(yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2602 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2606 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 124:
-#line 508 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 512 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_collection_new((yyvsp[0].geometryvalue)); WKT_ERROR(); }
-#line 2608 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2612 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 125:
-#line 512 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 516 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_point_new(wkt_parser_ptarray_new((yyvsp[0].coordinatevalue)),NULL); WKT_ERROR(); }
-#line 2614 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2618 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 126:
-#line 514 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 518 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_point_new(wkt_parser_ptarray_new((yyvsp[-1].coordinatevalue)),NULL); WKT_ERROR(); }
-#line 2620 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2624 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 127:
-#line 516 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 520 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_point_new(NULL, NULL); WKT_ERROR(); }
-#line 2626 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2630 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 128:
-#line 520 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 524 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_point_new((yyvsp[-1].ptarrayvalue), NULL); WKT_ERROR(); }
-#line 2632 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2636 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 129:
-#line 522 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 526 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_point_new((yyvsp[-1].ptarrayvalue), (yyvsp[-3].stringvalue)); WKT_ERROR(); }
-#line 2638 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2642 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 130:
-#line 524 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 528 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_point_new(NULL, (yyvsp[-1].stringvalue)); WKT_ERROR(); }
-#line 2644 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2648 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 131:
-#line 526 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 530 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.geometryvalue) = wkt_parser_point_new(NULL,NULL); WKT_ERROR(); }
-#line 2650 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2654 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 132:
-#line 530 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 534 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.ptarrayvalue) = wkt_parser_ptarray_add_coord((yyvsp[-2].ptarrayvalue), (yyvsp[0].coordinatevalue)); WKT_ERROR(); }
-#line 2656 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2660 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 133:
-#line 532 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 536 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.ptarrayvalue) = wkt_parser_ptarray_new((yyvsp[0].coordinatevalue)); WKT_ERROR(); }
-#line 2662 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2666 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 134:
-#line 536 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 540 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.coordinatevalue) = wkt_parser_coord_2((yyvsp[-1].doublevalue), (yyvsp[0].doublevalue)); WKT_ERROR(); }
-#line 2668 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2672 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 135:
-#line 538 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 542 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.coordinatevalue) = wkt_parser_coord_3((yyvsp[-2].doublevalue), (yyvsp[-1].doublevalue), (yyvsp[0].doublevalue)); WKT_ERROR(); }
-#line 2674 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2678 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
   case 136:
-#line 540 "lwin_wkt_parse.y" /* yacc.c:1646  */
+#line 544 "lwin_wkt_parse.y" /* yacc.c:1646  */
     { (yyval.coordinatevalue) = wkt_parser_coord_4((yyvsp[-3].doublevalue), (yyvsp[-2].doublevalue), (yyvsp[-1].doublevalue), (yyvsp[0].doublevalue)); WKT_ERROR(); }
-#line 2680 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2684 "lwin_wkt_parse.c" /* yacc.c:1646  */
     break;
 
 
-#line 2684 "lwin_wkt_parse.c" /* yacc.c:1646  */
+#line 2688 "lwin_wkt_parse.c" /* yacc.c:1646  */
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -2915,6 +2919,6 @@ yyreturn:
 #endif
   return yyresult;
 }
-#line 542 "lwin_wkt_parse.y" /* yacc.c:1906  */
+#line 546 "lwin_wkt_parse.y" /* yacc.c:1906  */
 
 
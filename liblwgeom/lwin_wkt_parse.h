@@ -76,7 +76,7 @@ extern int wkt_yydebug;
 
 union YYSTYPE
 {
-#line 112 "lwin_wkt_parse.y" /* yacc.c:1909  */
+#line 116 "lwin_wkt_parse.y" /* yacc.c:1909  */
 
 	int integervalue;
 	double doublevalue;
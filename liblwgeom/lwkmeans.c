@@ -19,6 +19,13 @@
  */
 #define KMEANS_MAX_ITERATIONS 1000
 
+/*
+ * Distance bounds are widened by this relative amount every time they are
+ * computed or moved, so that floating point rounding can never make a bound
+ * claim more than the exact distances would.
+ */
+#define KMEANS_BOUND_SLACK (1 + 1e-9)
+
 static uint32_t kmeans(POINT4D *objs,
 		       uint32_t *clusters,
 		       uint32_t n,
@@ -144,6 +151,206 @@ update_r(POINT4D *objs, uint32_t *clusters, uint32_t n, POINT4D *centers, double
 	return converged;
 }
 
+/*
+ * State for the bounded assignment step, after Hamerly "Making k-means even
+ * faster" (2010). Every object keeps an upper bound of the distance to its
+ * own center and a lower bound of the distance to any other center. When the
+ * upper bound is below the lower bound (or below half the gap between its
+ * center and the closest other center) the object can not change cluster and
+ * the scan over all centers is skipped. Center coordinates are kept as
+ * separate arrays so the full scan is a plain loop the compiler can vectorize.
+ * All distances here are plain, not squared.
+ */
+typedef struct
+{
+	double *upper;      /* n: upper bound of distance to own center */
+	double *lower;      /* n: lower bound of distance to any other center */
+	double *half_gap;   /* k: half the distance to the nearest other center */
+	double *moved;      /* k: distance the center moved on last update */
+	double *cx, *cy, *cz; /* k: center coordinates */
+	double *dist;       /* k: scratch squared distances of full scan */
+	POINT4D *prev;      /* k: centers before last update */
+	uint32_t k;
+	uint8_t valid;      /* are upper and lower filled in? */
+} KMEANS_BOUNDS;
+
+static void
+kmeans_bounds_init(KMEANS_BOUNDS *b, uint32_t n)
+{
+	memset(b, 0, sizeof(KMEANS_BOUNDS));
+	b->upper = lwalloc(sizeof(double) * n);
+	b->lower = lwalloc(sizeof(double) * n);
+}
+
+static void
+kmeans_bounds_free_centers(KMEANS_BOUNDS *b)
+{
+	if (!b->k)
+		return;
+	lwfree(b->half_gap);
+	lwfree(b->moved);
+	lwfree(b->cx);
+	lwfree(b->cy);
+	lwfree(b->cz);
+	lwfree(b->dist);
+	lwfree(b->prev);
+	b->k = 0;
+}
+
+/* (Re)size per center arrays, invalidating all bounds */
+static void
+kmeans_bounds_reset(KMEANS_BOUNDS *b, uint32_t k)
+{
+	if (b->k != k)
+	{
+		kmeans_bounds_free_centers(b);
+		b->half_gap = lwalloc(sizeof(double) * k);
+		b->moved = lwalloc(sizeof(double) * k);
+		b->cx = lwalloc(sizeof(double) * k);
+		b->cy = lwalloc(sizeof(double) * k);
+		b->cz = lwalloc(sizeof(double) * k);
+		b->dist = lwalloc(sizeof(double) * k);
+		b->prev = lwalloc(sizeof(POINT4D) * k);
+		b->k = k;
+	}
+	b->valid = LW_FALSE;
+}
+
+static void
+kmeans_bounds_free(KMEANS_BOUNDS *b)
+{
+	kmeans_bounds_free_centers(b);
+	lwfree(b->upper);
+	lwfree(b->lower);
+}
+
+/* Squared distances from a point to all centers, into b->dist */
+static void
+kmeans_distances(const KMEANS_BOUNDS *b, const POINT4D *obj, uint32_t k)
+{
+	const double x = obj->x, y = obj->y, z = obj->z;
+	const double *cx = b->cx, *cy = b->cy, *cz = b->cz;
+	double *dist = b->dist;
+
+	/* Same arithmetic as distance3d_sqr_pt4d_pt4d, with no branches */
+	for (uint32_t i = 0; i < k; i++)
+	{
+		double hside = cx[i] - x;
+		double vside = cy[i] - y;
+		double zside = cz[i] - z;
+		dist[i] = hside * hside + vside * vside + zside * zside;
+	}
+}
+
+/* Refresh center coordinate arrays and gaps between centers */
+static void
+kmeans_bounds_centers(KMEANS_BOUNDS *b, const POINT4D *centers, uint32_t k)
+{
+	for (uint32_t i = 0; i < k; i++)
+	{
+		b->cx[i] = centers[i].x;
+		b->cy[i] = centers[i].y;
+		b->cz[i] = centers[i].z;
+	}
+	for (uint32_t i = 0; i < k; i++)
+	{
+		double min_dist = DBL_MAX;
+		kmeans_distances(b, &centers[i], k);
+		for (uint32_t j = 0; j < k; j++)
+			if (j != i && b->dist[j] < min_dist)
+				min_dist = b->dist[j];
+		b->half_gap[i] = (min_dist == DBL_MAX) ? DBL_MAX : sqrt(min_dist) / 2 / KMEANS_BOUND_SLACK;
+	}
+}
+
+/*
+ * Refresh mapping of point to closest cluster, skipping the objects whose
+ * bounds prove they stay where they are. Gives the same assignment as
+ * update_r, but does not measure cluster radii.
+ */
+static uint8_t
+update_r_bounded(POINT4D *objs, uint32_t *clusters, uint32_t n, POINT4D *centers, uint32_t k, KMEANS_BOUNDS *b)
+{
+	uint8_t converged = LW_TRUE;
+
+	kmeans_bounds_centers(b, centers, k);
+
+	for (uint32_t i = 0; i < n; i++)
+	{
+		if (b->valid)
+		{
+			uint32_t cluster = clusters[i];
+			double bound = FP_MAX(b->half_gap[cluster], b->lower[i]);
+			if (b->upper[i] < bound)
+				continue;
+
+			/* Tighten the upper bound and try again */
+			b->upper[i] = sqrt(distance3d_sqr_pt4d_pt4d(&objs[i], &centers[cluster])) * KMEANS_BOUND_SLACK;
+			if (b->upper[i] < bound)
+				continue;
+		}
+
+		/* Full scan, first nearest cluster wins like in update_r */
+		kmeans_distances(b, &objs[i], k);
+		double curr_distance = b->dist[0];
+		double next_distance = DBL_MAX;
+		uint32_t curr_cluster = 0;
+		for (uint32_t cluster = 1; cluster < k; cluster++)
+		{
+			double distance = b->dist[cluster];
+			if (distance < curr_distance)
+			{
+				next_distance = curr_distance;
+				curr_distance = distance;
+				curr_cluster = cluster;
+			}
+			else if (distance < next_distance)
+				next_distance = distance;
+		}
+
+		b->upper[i] = sqrt(curr_distance) * KMEANS_BOUND_SLACK;
+		b->lower[i] = (next_distance == DBL_MAX) ? DBL_MAX : sqrt(next_distance) / KMEANS_BOUND_SLACK;
+		if (clusters[i] != curr_cluster)
+		{
+			converged = LW_FALSE;
+			clusters[i] = curr_cluster;
+		}
+	}
+	b->valid = LW_TRUE;
+	return converged;
+}
+
+/* Loosen the bounds by the distance the centers moved since b->prev */
+static void
+update_bounds(uint32_t *clusters, uint32_t n, POINT4D *centers, uint32_t k, KMEANS_BOUNDS *b)
+{
+	double max_moved = 0, next_moved = 0;
+	uint32_t max_cluster = 0;
+
+	for (uint32_t i = 0; i < k; i++)
+	{
+		double moved = sqrt(distance3d_sqr_pt4d_pt4d(&b->prev[i], &centers[i])) * KMEANS_BOUND_SLACK;
+		b->moved[i] = moved;
+		if (moved > max_moved)
+		{
+			next_moved = max_moved;
+			max_moved = moved;
+			max_cluster = i;
+		}
+		else if (moved > next_moved)
+			next_moved = moved;
+	}
+
+	for (uint32_t i = 0; i < n; i++)
+	{
+		uint32_t cluster = clusters[i];
+		/* Other centers could have approached by at most the largest move among them */
+		double other_moved = (cluster == max_cluster) ? next_moved : max_moved;
+		b->upper[i] = (b->upper[i] + b->moved[cluster]) * KMEANS_BOUND_SLACK;
+		b->lower[i] = (b->lower[i] - other_moved) / KMEANS_BOUND_SLACK;
+	}
+}
+
 /* Refresh cluster centroids based on all of their objects */
 static void
 update_means(POINT4D *objs, uint32_t *clusters, uint32_t n, POINT4D *centers, uint32_t k)
@@ -283,21 +490,34 @@ kmeans(POINT4D *objs,
 {
 	uint8_t converged = LW_FALSE;
 	uint32_t cur_k = min_k;
+	KMEANS_BOUNDS bounds;
 
 	kmeans_init(objs, n, centers, cur_k);
 	/* One iteration of kmeans needs to happen without shortcuts to fully initialize structures */
 	update_r(objs, clusters, n, centers, radii, cur_k);
 	update_means(objs, clusters, n, centers, cur_k);
+	kmeans_bounds_init(&bounds, n);
 	for (uint32_t t = 0; t < KMEANS_MAX_ITERATIONS; t++)
 	{
-		/* Standard KMeans loop */
+		kmeans_bounds_reset(&bounds, cur_k);
+
+		/* Standard KMeans loop, with bounds to skip most of the distance calculations */
 		for (uint32_t i = 0; i < KMEANS_MAX_ITERATIONS; i++)
 		{
 			LW_ON_INTERRUPT(break);
-			converged = update_r(objs, clusters, n, centers, radii, cur_k);
+			converged = update_r_bounded(objs, clusters, n, centers, cur_k, &bounds);
 			if (converged)
-				break;
+			{
+				/* Confirm with a full pass, which also measures cluster radii */
+				converged = update_r(objs, clusters, n, centers, radii, cur_k);
+				if (converged)
+					break;
+				bounds.valid = LW_FALSE;
+			}
+			memcpy(bounds.prev, centers, sizeof(POINT4D) * cur_k);
 			update_means(objs, clusters, n, centers, cur_k);
+			if (bounds.valid)
+				update_bounds(clusters, n, centers, cur_k, &bounds);
 		}
 		if (!converged || !max_radius)
 			break;
@@ -308,6 +528,7 @@ kmeans(POINT4D *objs,
 			break;
 		cur_k = new_k;
 	}
+	kmeans_bounds_free(&bounds);
 
 	if (!converged)
 	{
@@ -722,56 +722,8 @@ asgeojson_geom_buf(const LWGEOM *geom, char *output, GBOX *bbox, int precision)
 static size_t
 pointArray_to_geojson(POINTARRAY *pa, char *output, int precision)
 {
-	char *ptr = output;
-
-	if (!FLAGS_GET_Z(pa->flags))
-	{
-		for (uint32_t i = 0; i < pa->npoints; i++)
-		{
-			if (i)
-			{
-				*ptr = ',';
-				ptr++;
-			}
-			const POINT2D *pt = getPoint2d_cp(pa, i);
-
-			*ptr = '[';
-			ptr++;
-			ptr += lwprint_double(pt->x, precision, ptr);
-			*ptr = ',';
-			ptr++;
-			ptr += lwprint_double(pt->y, precision, ptr);
-			*ptr = ']';
-			ptr++;
-		}
-	}
-	else
-	{
-		for (uint32_t i = 0; i < pa->npoints; i++)
-		{
-			if (i)
-			{
-				*ptr = ',';
-				ptr++;
-			}
-
-			const POINT3D *pt = getPoint3d_cp(pa, i);
-			*ptr = '[';
-			ptr++;
-			ptr += lwprint_double(pt->x, precision, ptr);
-			*ptr = ',';
-			ptr++;
-			ptr += lwprint_double(pt->y, precision, ptr);
-			*ptr = ',';
-			ptr++;
-			ptr += lwprint_double(pt->z, precision, ptr);
-			*ptr = ']';
-			ptr++;
-		}
-	}
-	*ptr = '\0';
-
-	return (ptr-output);
+	uint32_t dims = FLAGS_GET_Z(pa->flags) ? 3 : 2;
+	return lwprint_ptarray(pa, pa->npoints, dims, precision, LWPRINT_ORDSEP_COMMA | LWPRINT_BRACKETS, output);
 }
 
 /**
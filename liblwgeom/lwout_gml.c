@@ -677,43 +677,8 @@ asgml2_collection(const LWCOLLECTION *col, const char *srs, int precision, const
 static size_t
 pointArray_toGML2(POINTARRAY *pa, char *output, int precision)
 {
-	uint32_t i;
-	char *ptr;
-	char x[OUT_DOUBLE_BUFFER_SIZE];
-	char y[OUT_DOUBLE_BUFFER_SIZE];
-	char z[OUT_DOUBLE_BUFFER_SIZE];
-
-	ptr = output;
-
-	if ( ! FLAGS_GET_Z(pa->flags) )
-	{
-		for (i=0; i<pa->npoints; i++)
-		{
-			const POINT2D *pt;
-			pt = getPoint2d_cp(pa, i);
-
-			lwprint_double(pt->x, precision, x);
-			lwprint_double(pt->y, precision, y);
-
-			if ( i ) ptr += sprintf(ptr, " ");
-			ptr += sprintf(ptr, "%s,%s", x, y);
-		}
-	}
-	else
-	{
-		for (i=0; i<pa->npoints; i++)
-		{
-			const POINT3D *pt = getPoint3d_cp(pa, i);
-			lwprint_double(pt->x, precision, x);
-			lwprint_double(pt->y, precision, y);
-			lwprint_double(pt->z, precision, z);
-
-			if ( i ) ptr += sprintf(ptr, " ");
-			ptr += sprintf(ptr, "%s,%s,%s", x, y, z);
-		}
-	}
-
-	return ptr-output;
+	uint32_t dims = FLAGS_GET_Z(pa->flags) ? 3 : 2;
+	return lwprint_ptarray(pa, pa->npoints, dims, precision, LWPRINT_ORDSEP_COMMA | LWPRINT_PTSEP_SPACE, output);
 }
 
 
@@ -1896,49 +1861,13 @@ asgml3_multisurface(const LWMSURFACE *sur, const char *srs, int precision, int o
 static size_t
 pointArray_toGML3(POINTARRAY *pa, char *output, int precision, int opts)
 {
-	uint32_t i;
-	char *ptr;
-	char x[OUT_DOUBLE_BUFFER_SIZE];
-	char y[OUT_DOUBLE_BUFFER_SIZE];
-	char z[OUT_DOUBLE_BUFFER_SIZE];
+	uint32_t dims = FLAGS_GET_Z(pa->flags) ? 3 : 2;
+	int printopts = LWPRINT_PTSEP_SPACE;
 
-	ptr = output;
-
-	if ( ! FLAGS_GET_Z(pa->flags) )
-	{
-		for (i=0; i<pa->npoints; i++)
-		{
-			const POINT2D *pt;
-			pt = getPoint2d_cp(pa, i);
-			lwprint_double(pt->x, precision, x);
-			lwprint_double(pt->y, precision, y);
-
-			if ( i ) ptr += sprintf(ptr, " ");
-			if (IS_DEGREE(opts))
-				ptr += sprintf(ptr, "%s %s", y, x);
-			else
-				ptr += sprintf(ptr, "%s %s", x, y);
-		}
-	}
-	else
-	{
-		for (i=0; i<pa->npoints; i++)
-		{
-			const POINT3D *pt = getPoint3d_cp(pa, i);
-
-			lwprint_double(pt->x, precision, x);
-			lwprint_double(pt->y, precision, y);
-			lwprint_double(pt->z, precision, z);
-
-			if ( i ) ptr += sprintf(ptr, " ");
-			if (IS_DEGREE(opts))
-				ptr += sprintf(ptr, "%s %s %s", y, x, z);
-			else
-				ptr += sprintf(ptr, "%s %s %s", x, y, z);
-		}
-	}
+	if (IS_DEGREE(opts))
+		printopts |= LWPRINT_FLIP_XY;
 
-	return ptr-output;
+	return lwprint_ptarray(pa, pa->npoints, dims, precision, printopts, output);
 }
 
 
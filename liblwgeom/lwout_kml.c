@@ -97,22 +97,8 @@ lwgeom_to_kml2_sb(const LWGEOM *geom, int precision, const char *prefix, stringb
 static int
 ptarray_to_kml2_sb(const POINTARRAY *pa, int precision, stringbuffer_t *sb)
 {
-	uint32_t i, j;
 	uint32_t dims = FLAGS_GET_Z(pa->flags) ? 3 : 2;
-	POINT4D pt;
-	double *d;
-
-	for ( i = 0; i < pa->npoints; i++ )
-	{
-		getPoint4d_p(pa, i, &pt);
-		d = (double*)(&pt);
-		if ( i ) stringbuffer_append_len(sb," ",1);
-		for (j = 0; j < dims; j++)
-		{
-			if ( j ) stringbuffer_append_len(sb,",",1);
-			stringbuffer_append_double(sb, d[j], precision);
-		}
-	}
+	stringbuffer_append_ptarray(sb, pa, pa->npoints, dims, precision, LWPRINT_ORDSEP_COMMA | LWPRINT_PTSEP_SPACE);
 	return LW_SUCCESS;
 }
 
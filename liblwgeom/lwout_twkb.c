@@ -28,13 +28,13 @@
 /*
 * GeometryType, and dimensions
 */
-static uint8_t lwgeom_twkb_type(const LWGEOM *geom)
+static uint8_t lwtype_twkb_type(uint8_t type)
 {
 	uint8_t twkb_type = 0;
 
-	LWDEBUGF(2, "Entered  lwgeom_twkb_type",0);
+	LWDEBUGF(2, "Entered  lwtype_twkb_type",0);
 
-	switch ( geom->type )
+	switch ( type )
 	{
 		case POINTTYPE:
 			twkb_type = WKB_POINT_TYPE;
@@ -60,11 +60,16 @@ static uint8_t lwgeom_twkb_type(const LWGEOM *geom)
 			twkb_type = WKB_GEOMETRYCOLLECTION_TYPE;
 			break;
 		default:
-			lwerror("%s: Unsupported geometry type: %s", __func__, lwtype_name(geom->type));
+			lwerror("%s: Unsupported geometry type: %s", __func__, lwtype_name(type));
 	}
 	return twkb_type;
 }
 
+static uint8_t lwgeom_twkb_type(const LWGEOM *geom)
+{
+	return lwtype_twkb_type(geom->type);
+}
+
 
 /**
 * Calculates the size of the bbox in varints in the form:
@@ -426,34 +431,11 @@ static int lwgeom_to_twkb_buf(const LWGEOM *geom, TWKB_GLOBALS *globals, TWKB_ST
 }
 
 
-static int lwgeom_write_to_buffer(const LWGEOM *geom, TWKB_GLOBALS *globals, TWKB_STATE *parent_state)
+/**
+* Sets the factors that scale each dimension to the requested precision
+*/
+static void twkb_set_factors(TWKB_GLOBALS *globals, int has_z, int has_m)
 {
-	int i, is_empty, has_z = 0, has_m = 0, ndims;
-	size_t bbox_size = 0, optional_precision_byte = 0;
-	uint8_t flag = 0, type_prec = 0;
-	bytebuffer_t header_bytebuffer, geom_bytebuffer;
-
-	TWKB_STATE child_state;
-	memset(&child_state, 0, sizeof(TWKB_STATE));
-	child_state.header_buf = &header_bytebuffer;
-	child_state.geom_buf = &geom_bytebuffer;
-	child_state.idlist = parent_state->idlist;
-
-	bytebuffer_init_with_size(child_state.header_buf, 16);
-	bytebuffer_init_with_size(child_state.geom_buf, 64);
-
-	/* Read dimensionality from input */
-	ndims = lwgeom_ndims(geom);
-	is_empty = lwgeom_is_empty(geom);
-	if ( ndims > 2 )
-	{
-		has_z = lwgeom_has_z(geom);
-		has_m = lwgeom_has_m(geom);
-	}
-
-	/* Do we need extended precision? If we have a Z or M we do. */
-	optional_precision_byte = (has_z || has_m);
-
 	/* Both X and Y dimension use the same precision */
 	globals->factor[0] = pow(10, globals->prec_xy);
 	globals->factor[1] = globals->factor[0];
@@ -463,27 +445,29 @@ static int lwgeom_write_to_buffer(const LWGEOM *geom, TWKB_GLOBALS *globals, TWK
 		globals->factor[2] = pow(10, globals->prec_z);
 	if ( has_m )
 		globals->factor[2 + has_z] = pow(10, globals->prec_m);
+}
 
-	/* Reset stats */
-	for ( i = 0; i < MAX_N_DIMS; i++ )
-	{
-		/* Reset bbox calculation */
-		child_state.bbox_max[i] = INT64_MIN;
-		child_state.bbox_min[i] = INT64_MAX;
-		/* Reset acumulated delta values to get absolute values on next point */
-		child_state.accum_rels[i] = 0;
-	}
+/**
+* Writes the type/precision byte, the metadata byte and, if there are
+* higher dimensions, the extended precision byte of a TWKB header
+*/
+static void twkb_write_header(bytebuffer_t *b, const TWKB_GLOBALS *globals, uint8_t twkb_type, int has_z, int has_m, int is_empty, int has_idlist)
+{
+	uint8_t flag = 0, type_prec = 0;
+
+	/* Do we need extended precision? If we have a Z or M we do. */
+	int optional_precision_byte = (has_z || has_m);
 
 	/* TYPE/PRECISION BYTE */
 	if ( abs(globals->prec_xy) > 7 )
 		lwerror("%s: X/Z precision cannot be greater than 7 or less than -7", __func__);
 
 	/* Read the TWKB type number from the geometry */
-	TYPE_PREC_SET_TYPE(type_prec, lwgeom_twkb_type(geom));
+	TYPE_PREC_SET_TYPE(type_prec, twkb_type);
 	/* Zig-zag the precision value before encoding it since it is a signed value */
 	TYPE_PREC_SET_PREC(type_prec, zigzag8(globals->prec_xy));
 	/* Write the type and precision byte */
-	bytebuffer_append_byte(child_state.header_buf, type_prec);
+	bytebuffer_append_byte(b, type_prec);
 
 	/* METADATA BYTE */
 	/* Set first bit if we are going to store bboxes */
@@ -491,13 +475,13 @@ static int lwgeom_write_to_buffer(const LWGEOM *geom, TWKB_GLOBALS *globals, TWK
 	/* Set second bit if we are going to store resulting size */
 	FIRST_BYTE_SET_SIZES(flag, globals->variant & TWKB_SIZE);
 	/* There will be no ID-list (for now) */
-	FIRST_BYTE_SET_IDLIST(flag, parent_state->idlist && ! is_empty);
+	FIRST_BYTE_SET_IDLIST(flag, has_idlist && ! is_empty);
 	/* Are there higher dimensions */
 	FIRST_BYTE_SET_EXTENDED(flag, optional_precision_byte);
 	/* Empty? */
 	FIRST_BYTE_SET_EMPTY(flag, is_empty);
 	/* Write the header byte */
-	bytebuffer_append_byte(child_state.header_buf, flag);
+	bytebuffer_append_byte(b, flag);
 
 	/* EXTENDED PRECISION BYTE (OPTIONAL) */
 	/* If needed, write the extended dim byte */
@@ -515,9 +499,74 @@ static int lwgeom_write_to_buffer(const LWGEOM *geom, TWKB_GLOBALS *globals, TWK
 		HIGHER_DIM_SET_HASM(flag, has_m);
 		HIGHER_DIM_SET_PRECZ(flag, globals->prec_z);
 		HIGHER_DIM_SET_PRECM(flag, globals->prec_m);
-		bytebuffer_append_byte(child_state.header_buf, flag);
+		bytebuffer_append_byte(b, flag);
+	}
+}
+
+/**
+* Writes the optional size and bounding box that close a TWKB header,
+* given the length of the body that will follow them
+*/
+static void twkb_write_header_tail(TWKB_STATE *ts, const TWKB_GLOBALS *globals, int ndims, size_t body_size)
+{
+	/* Did we have a box? If so, how big? */
+	size_t bbox_size = 0;
+	if( globals->variant & TWKB_BBOX )
+	{
+		LWDEBUG(4,"We want boxes and will calculate required size");
+		bbox_size = sizeof_bbox(ts, ndims);
+	}
+
+	/* Write the size if wanted */
+	if( globals->variant & TWKB_SIZE )
+	{
+		/* Here we have to add what we know will be written to header */
+		/* buffer after size value is written */
+		bytebuffer_append_uvarint(ts->header_buf, body_size + bbox_size);
 	}
 
+	if( globals->variant & TWKB_BBOX )
+		write_bbox(ts, ndims);
+}
+
+static int lwgeom_write_to_buffer(const LWGEOM *geom, TWKB_GLOBALS *globals, TWKB_STATE *parent_state)
+{
+	int i, is_empty, has_z = 0, has_m = 0, ndims;
+	bytebuffer_t header_bytebuffer, geom_bytebuffer;
+
+	TWKB_STATE child_state;
+	memset(&child_state, 0, sizeof(TWKB_STATE));
+	child_state.header_buf = &header_bytebuffer;
+	child_state.geom_buf = &geom_bytebuffer;
+	child_state.idlist = parent_state->idlist;
+
+	bytebuffer_init_with_size(child_state.header_buf, 16);
+	bytebuffer_init_with_size(child_state.geom_buf, 64);
+
+	/* Read dimensionality from input */
+	ndims = lwgeom_ndims(geom);
+	is_empty = lwgeom_is_empty(geom);
+	if ( ndims > 2 )
+	{
+		has_z = lwgeom_has_z(geom);
+		has_m = lwgeom_has_m(geom);
+	}
+
+	twkb_set_factors(globals, has_z, has_m);
+
+	/* Reset stats */
+	for ( i = 0; i < MAX_N_DIMS; i++ )
+	{
+		/* Reset bbox calculation */
+		child_state.bbox_max[i] = INT64_MIN;
+		child_state.bbox_min[i] = INT64_MAX;
+		/* Reset acumulated delta values to get absolute values on next point */
+		child_state.accum_rels[i] = 0;
+	}
+
+	twkb_write_header(child_state.header_buf, globals, lwgeom_twkb_type(geom),
+	                  has_z, has_m, is_empty, parent_state->idlist != NULL);
+
 	/* It the geometry is empty, we're almost done */
 	if ( is_empty )
 	{
@@ -551,26 +600,8 @@ static int lwgeom_write_to_buffer(const LWGEOM *geom, TWKB_GLOBALS *globals, TWK
 		}
 	}
 
-	/* Did we have a box? If so, how big? */
-	bbox_size = 0;
-	if( globals->variant & TWKB_BBOX )
-	{
-		LWDEBUG(4,"We want boxes and will calculate required size");
-		bbox_size = sizeof_bbox(&child_state, ndims);
-	}
-
-	/* Write the size if wanted */
-	if( globals->variant & TWKB_SIZE )
-	{
-		/* Here we have to add what we know will be written to header */
-		/* buffer after size value is written */
-		size_t size_to_register = bytebuffer_getlength(child_state.geom_buf);
-		size_to_register += bbox_size;
-		bytebuffer_append_uvarint(child_state.header_buf, size_to_register);
-	}
-
-	if( globals->variant & TWKB_BBOX )
-		write_bbox(&child_state, ndims);
+	/* Write the size and box now that we know the body */
+	twkb_write_header_tail(&child_state, globals, ndims, bytebuffer_getlength(child_state.geom_buf));
 
 	bytebuffer_append_bytebuffer(parent_state->geom_buf,child_state.header_buf);
 	bytebuffer_append_bytebuffer(parent_state->geom_buf,child_state.geom_buf);
@@ -639,3 +670,527 @@ lwgeom_to_twkb(const LWGEOM *geom, uint8_t variant, int8_t precision_xy, int8_t
 }
 
 
+
+
+/******************************************************************
+* Streamed TWKB collections
+*******************************************************************/
+
+static void twkb_agg_reset_body(TWKB_AGG_STATE *s)
+{
+	int i;
+	s->geom_buf.writecursor = s->geom_buf.readcursor = s->geom_buf.buf_start;
+	s->first_coord = SIZE_MAX;
+	for ( i = 0; i < MAX_N_DIMS; i++ )
+	{
+		s->ts.bbox_max[i] = INT64_MIN;
+		s->ts.bbox_min[i] = INT64_MAX;
+		s->ts.accum_rels[i] = 0;
+	}
+}
+
+static void twkb_agg_start(TWKB_AGG_STATE *s, uint8_t type, int has_z, int has_m)
+{
+	s->type = type;
+	s->has_z = has_z;
+	s->has_m = has_m;
+	s->is_collection = ! (type == POINTTYPE || type == LINETYPE || type == POLYGONTYPE);
+	twkb_set_factors(&s->globals, has_z, has_m);
+}
+
+TWKB_AGG_STATE *
+twkb_agg_init(uint8_t variant, int8_t precision_xy, int8_t precision_z, int8_t precision_m)
+{
+	TWKB_AGG_STATE *s = lwalloc(sizeof(TWKB_AGG_STATE));
+	memset(s, 0, sizeof(TWKB_AGG_STATE));
+
+	s->globals.variant = variant;
+	s->globals.prec_xy = precision_xy;
+	s->globals.prec_z = precision_z;
+	s->globals.prec_m = precision_m;
+
+	bytebuffer_init_with_size(&s->id_buf, 0);
+	bytebuffer_init_with_size(&s->geom_buf, 0);
+
+	/* Collection members merge their boxes into ours only when the */
+	/* parent has a header buffer; it is never written to */
+	s->ts.geom_buf = &s->geom_buf;
+	s->ts.header_buf = &s->geom_buf;
+	twkb_agg_reset_body(s);
+	return s;
+}
+
+void
+twkb_agg_free(TWKB_AGG_STATE *s)
+{
+	if ( ! s ) return;
+	bytebuffer_destroy_buffer(&s->id_buf);
+	bytebuffer_destroy_buffer(&s->geom_buf);
+	if ( s->empty_points )
+		lwfree(s->empty_points);
+	lwfree(s);
+}
+
+/**
+* Empty points cannot be represented inside a multipoint, so we only
+* note where they were, to skip their ids or bring them back later
+*/
+static void twkb_agg_set_empty_point(TWKB_AGG_STATE *s, uint32_t n, uint32_t pos)
+{
+	if ( n >= s->empty_points_size )
+	{
+		s->empty_points_size = s->empty_points_size ? 2 * s->empty_points_size : 8;
+		while ( n >= s->empty_points_size )
+			s->empty_points_size *= 2;
+		if ( s->empty_points )
+			s->empty_points = lwrealloc(s->empty_points, s->empty_points_size * sizeof(uint32_t));
+		else
+			s->empty_points = lwalloc(s->empty_points_size * sizeof(uint32_t));
+	}
+	s->empty_points[n] = pos;
+}
+
+/**
+* Finds the first coordinate written by a multi-geometry member that
+* starts at the given offset of the body, SIZE_MAX if it has none
+*/
+static size_t twkb_agg_first_coord(const TWKB_AGG_STATE *s, size_t offset)
+{
+	const uint8_t *start = s->geom_buf.buf_start;
+	const uint8_t *end = s->geom_buf.writecursor;
+	const uint8_t *ptr = start + offset;
+	uint64_t i, nrings = 1;
+	size_t size;
+
+	if ( ptr >= end )
+		return SIZE_MAX;
+
+	if ( s->type == POINTTYPE )
+		return offset;
+
+	if ( s->type == POLYGONTYPE )
+	{
+		nrings = varint_u64_decode(ptr, end, &size);
+		ptr += size;
+	}
+
+	for ( i = 0; i < nrings && ptr < end; i++ )
+	{
+		uint64_t npoints = varint_u64_decode(ptr, end, &size);
+		ptr += size;
+		if ( npoints )
+			return ptr - start;
+	}
+	return SIZE_MAX;
+}
+
+/**
+* Rewrites a multi-geometry body as geometry collection members,
+* once an input of another type shows up
+*/
+static void twkb_agg_to_collection(TWKB_AGG_STATE *s)
+{
+	LWCOLLECTION *col = NULL;
+	uint32_t i, j = 0, k = 0;
+	int is_multipoint = (s->type == POINTTYPE);
+	uint32_t nmembers = is_multipoint ? s->ngeoms - s->nempty : s->ngeoms;
+
+	if ( s->is_collection )
+		return;
+
+	/* Read back what we wrote, the coordinates are already on the grid */
+	if ( nmembers )
+	{
+		TWKB_GLOBALS globals = s->globals;
+		bytebuffer_t twkb;
+
+		globals.variant = 0;
+		bytebuffer_init_with_size(&twkb, bytebuffer_getlength(&s->geom_buf) + 16);
+		twkb_write_header(&twkb, &globals, lwtype_twkb_type(lwtype_get_collectiontype(s->type)),
+		                  s->has_z, s->has_m, LW_FALSE, LW_FALSE);
+		bytebuffer_append_uvarint(&twkb, nmembers);
+		bytebuffer_append_bytebuffer(&twkb, &s->geom_buf);
+		col = (LWCOLLECTION*)lwgeom_from_twkb(twkb.buf_start, bytebuffer_getlength(&twkb), LW_PARSER_CHECK_NONE);
+		bytebuffer_destroy_buffer(&twkb);
+		if ( ! col || col->ngeoms != nmembers )
+			lwerror("%s: unable to read back the streamed members", __func__);
+	}
+
+	/* And write it again, each member with its own header */
+	twkb_agg_reset_body(s);
+	s->is_collection = LW_TRUE;
+	for ( i = 0; i < s->ngeoms; i++ )
+	{
+		if ( is_multipoint && k < s->nempty && s->empty_points[k] == i )
+		{
+			LWPOINT *pt = lwpoint_construct_empty(SRID_UNKNOWN, s->has_z, s->has_m);
+			lwgeom_write_to_buffer(lwpoint_as_lwgeom(pt), &s->globals, &s->ts);
+			lwpoint_free(pt);
+			k++;
+		}
+		else
+		{
+			lwgeom_write_to_buffer(col->geoms[j++], &s->globals, &s->ts);
+		}
+	}
+
+	if ( col )
+		lwcollection_free(col);
+	if ( s->empty_points )
+		lwfree(s->empty_points);
+	s->empty_points = NULL;
+	s->empty_points_size = 0;
+}
+
+int
+twkb_agg_add(TWKB_AGG_STATE *s, const LWGEOM *geom, int64_t id)
+{
+	int has_z, has_m, is_empty;
+
+	if ( ! geom )
+	{
+		lwerror("Cannot convert NULL into TWKB");
+		return LW_FAILURE;
+	}
+
+	has_z = lwgeom_has_z(geom);
+	has_m = lwgeom_has_m(geom);
+	is_empty = lwgeom_is_empty(geom);
+
+	if ( s->ngeoms == 0 )
+	{
+		twkb_agg_start(s, geom->type, has_z, has_m);
+	}
+	else
+	{
+		if ( has_z != s->has_z || has_m != s->has_m )
+		{
+			lwerror("Geometries have different dimensionality");
+			return LW_FAILURE;
+		}
+		if ( geom->type != s->type )
+			twkb_agg_to_collection(s);
+	}
+
+	if ( s->globals.variant & TWKB_ID )
+		bytebuffer_append_varint(&s->id_buf, id);
+
+	if ( s->is_collection )
+	{
+		lwgeom_write_to_buffer(geom, &s->globals, &s->ts);
+	}
+	else if ( s->type == POINTTYPE && is_empty )
+	{
+		twkb_agg_set_empty_point(s, s->nempty, s->ngeoms);
+	}
+	else
+	{
+		size_t offset = bytebuffer_getlength(&s->geom_buf);
+		lwgeom_to_twkb_buf(geom, &s->globals, &s->ts);
+		if ( s->first_coord == SIZE_MAX )
+			s->first_coord = twkb_agg_first_coord(s, offset);
+	}
+
+	s->ngeoms++;
+	if ( is_empty )
+		s->nempty++;
+	return LW_SUCCESS;
+}
+
+TWKB_AGG_STATE *
+twkb_agg_combine(TWKB_AGG_STATE *s1, TWKB_AGG_STATE *s2)
+{
+	const uint8_t *start, *end;
+	size_t offset;
+	uint32_t i;
+	int ndims;
+
+	if ( ! s2 || s2->ngeoms == 0 )
+		return s1;
+	if ( ! s1 )
+		return s2;
+
+	if ( s1->ngeoms == 0 )
+	{
+		twkb_agg_start(s1, s2->type, s2->has_z, s2->has_m);
+		s1->is_collection = s2->is_collection;
+	}
+	else if ( s1->has_z != s2->has_z || s1->has_m != s2->has_m )
+	{
+		lwerror("Geometries have different dimensionality");
+		return NULL;
+	}
+
+	/* Mixed types can only go into a geometry collection */
+	if ( s1->is_collection || s2->is_collection || s1->type != s2->type )
+	{
+		twkb_agg_to_collection(s1);
+		twkb_agg_to_collection(s2);
+	}
+
+	ndims = 2 + s1->has_z + s1->has_m;
+	start = s2->geom_buf.buf_start;
+	end = s2->geom_buf.writecursor;
+	offset = bytebuffer_getlength(&s1->geom_buf);
+
+	if ( s1->is_collection || s2->first_coord == SIZE_MAX || s1->first_coord == SIZE_MAX )
+	{
+		/* Nothing to rebase: members are independent, or one side has no coordinates */
+		bytebuffer_append_bulk(&s1->geom_buf, start, end - start);
+		if ( ! s1->is_collection && s2->first_coord != SIZE_MAX )
+		{
+			s1->first_coord = offset + s2->first_coord;
+			memcpy(s1->ts.accum_rels, s2->ts.accum_rels, sizeof(s1->ts.accum_rels));
+		}
+	}
+	else
+	{
+		/* The first coordinate of state2 is absolute, make it */
+		/* relative to the last coordinate of state1 */
+		const uint8_t *ptr = start + s2->first_coord;
+		bytebuffer_append_bulk(&s1->geom_buf, start, s2->first_coord);
+		for ( i = 0; i < (uint32_t)ndims; i++ )
+		{
+			size_t size;
+			int64_t val = varint_s64_decode(ptr, end, &size);
+			ptr += size;
+			bytebuffer_append_varint(&s1->geom_buf, val - s1->ts.accum_rels[i]);
+		}
+		bytebuffer_append_bulk(&s1->geom_buf, ptr, end - ptr);
+		memcpy(s1->ts.accum_rels, s2->ts.accum_rels, sizeof(s1->ts.accum_rels));
+	}
+
+	for ( i = 0; i < MAX_N_DIMS; i++ )
+	{
+		if ( s2->ts.bbox_min[i] < s1->ts.bbox_min[i] )
+			s1->ts.bbox_min[i] = s2->ts.bbox_min[i];
+		if ( s2->ts.bbox_max[i] > s1->ts.bbox_max[i] )
+			s1->ts.bbox_max[i] = s2->ts.bbox_max[i];
+	}
+
+	/* Empty points of state2 move along with its inputs */
+	if ( ! s1->is_collection && s1->type == POINTTYPE )
+	{
+		for ( i = 0; i < s2->nempty; i++ )
+			twkb_agg_set_empty_point(s1, s1->nempty + i, s1->ngeoms + s2->empty_points[i]);
+	}
+
+	bytebuffer_append_bytebuffer(&s1->id_buf, &s2->id_buf);
+	s1->ngeoms += s2->ngeoms;
+	s1->nempty += s2->nempty;
+	return s1;
+}
+
+lwvarlena_t *
+twkb_agg_finalize(const TWKB_AGG_STATE *s)
+{
+	TWKB_STATE ts;
+	bytebuffer_t out, ids;
+	const bytebuffer_t *id_buf;
+	uint8_t buf[16];
+	uint32_t nmembers;
+	int is_empty, has_idlist, ndims;
+	uint8_t twkb_type;
+	lwvarlena_t *v;
+
+	if ( ! s || s->ngeoms == 0 )
+		return NULL;
+
+	id_buf = &s->id_buf;
+	nmembers = s->ngeoms;
+
+	is_empty = (s->nempty == s->ngeoms);
+	has_idlist = (s->globals.variant & TWKB_ID) && ! is_empty;
+	ndims = 2 + s->has_z + s->has_m;
+	if ( s->is_collection )
+		twkb_type = WKB_GEOMETRYCOLLECTION_TYPE;
+	else
+		twkb_type = lwtype_twkb_type(lwtype_get_collectiontype(s->type));
+
+	bytebuffer_init_with_size(&out, bytebuffer_getlength(&s->geom_buf) + bytebuffer_getlength(&s->id_buf) + 64);
+	twkb_write_header(&out, &s->globals, twkb_type, s->has_z, s->has_m, is_empty, has_idlist);
+
+	if ( is_empty )
+	{
+		if ( s->globals.variant & TWKB_SIZE )
+			bytebuffer_append_byte(&out, 0);
+		v = bytebuffer_get_buffer_varlena(&out);
+		bytebuffer_destroy_buffer(&out);
+		return v;
+	}
+
+	/* Multipoints hold no empty members, drop their ids too */
+	if ( ! s->is_collection && s->type == POINTTYPE && s->nempty )
+	{
+		nmembers -= s->nempty;
+		if ( has_idlist )
+		{
+			const uint8_t *ptr = s->id_buf.buf_start;
+			const uint8_t *end = s->id_buf.writecursor;
+			uint32_t i, k = 0;
+
+			bytebuffer_init_with_size(&ids, bytebuffer_getlength(&s->id_buf));
+			for ( i = 0; i < s->ngeoms; i++ )
+			{
+				size_t size = varint_size(ptr, end);
+				if ( k < s->nempty && s->empty_points[k] == i )
+					k++;
+				else
+					bytebuffer_append_bulk(&ids, ptr, size);
+				ptr += size;
+			}
+			id_buf = &ids;
+		}
+	}
+
+	memcpy(&ts, &s->ts, sizeof(TWKB_STATE));
+	ts.header_buf = &out;
+	twkb_write_header_tail(&ts, &s->globals, ndims,
+	                       varint_u64_encode_buf(nmembers, buf) +
+	                       (has_idlist ? bytebuffer_getlength(id_buf) : 0) +
+	                       bytebuffer_getlength(&s->geom_buf));
+
+	bytebuffer_append_uvarint(&out, nmembers);
+	if ( has_idlist )
+		bytebuffer_append_bulk(&out, id_buf->buf_start, bytebuffer_getlength(id_buf));
+	bytebuffer_append_bulk(&out, s->geom_buf.buf_start, bytebuffer_getlength(&s->geom_buf));
+
+	if ( id_buf == &ids )
+		bytebuffer_destroy_buffer(&ids);
+
+	v = bytebuffer_get_buffer_varlena(&out);
+	bytebuffer_destroy_buffer(&out);
+	return v;
+}
+
+/*
+* Serialized state layout, in machine byte order:
+* variant, prec_xy, prec_z, prec_m, type, is_collection, has_z, has_m,
+* ngeoms, nempty, first_coord, bbox_min[4], bbox_max[4], accum_rels[4],
+* empty point positions, id_buf length, id_buf, geom_buf length, geom_buf
+*/
+
+lwvarlena_t *
+twkb_agg_serialize(const TWKB_AGG_STATE *s)
+{
+	bytebuffer_t b;
+	uint64_t len, first_coord = s->first_coord;
+	uint32_t nempty_points = (! s->is_collection && s->type == POINTTYPE) ? s->nempty : 0;
+	int8_t prec[3];
+	uint8_t flags[5];
+	lwvarlena_t *v;
+
+	prec[0] = s->globals.prec_xy;
+	prec[1] = s->globals.prec_z;
+	prec[2] = s->globals.prec_m;
+	flags[0] = s->globals.variant;
+	flags[1] = s->type;
+	flags[2] = s->is_collection;
+	flags[3] = s->has_z;
+	flags[4] = s->has_m;
+
+	bytebuffer_init_with_size(&b, 128 + bytebuffer_getlength(&s->id_buf) + bytebuffer_getlength(&s->geom_buf));
+	bytebuffer_append_bulk(&b, flags, 1);
+	bytebuffer_append_bulk(&b, prec, 3);
+	bytebuffer_append_bulk(&b, flags + 1, 4);
+	bytebuffer_append_bulk(&b, &s->ngeoms, sizeof(uint32_t));
+	bytebuffer_append_bulk(&b, &s->nempty, sizeof(uint32_t));
+	bytebuffer_append_bulk(&b, &first_coord, sizeof(uint64_t));
+	bytebuffer_append_bulk(&b, s->ts.bbox_min, sizeof(s->ts.bbox_min));
+	bytebuffer_append_bulk(&b, s->ts.bbox_max, sizeof(s->ts.bbox_max));
+	bytebuffer_append_bulk(&b, s->ts.accum_rels, sizeof(s->ts.accum_rels));
+	if ( nempty_points )
+		bytebuffer_append_bulk(&b, s->empty_points, nempty_points * sizeof(uint32_t));
+	len = bytebuffer_getlength(&s->id_buf);
+	bytebuffer_append_bulk(&b, &len, sizeof(uint64_t));
+	bytebuffer_append_bulk(&b, s->id_buf.buf_start, len);
+	len = bytebuffer_getlength(&s->geom_buf);
+	bytebuffer_append_bulk(&b, &len, sizeof(uint64_t));
+	bytebuffer_append_bulk(&b, s->geom_buf.buf_start, len);
+
+	v = bytebuffer_get_buffer_varlena(&b);
+	bytebuffer_destroy_buffer(&b);
+	return v;
+}
+
+static int twkb_agg_read(const uint8_t **ptr, const uint8_t *end, void *dst, size_t size)
+{
+	if ( (size_t)(end - *ptr) < size )
+		return LW_FAILURE;
+	memcpy(dst, *ptr, size);
+	*ptr += size;
+	return LW_SUCCESS;
+}
+
+TWKB_AGG_STATE *
+twkb_agg_deserialize(const uint8_t *buf, size_t size)
+{
+	const uint8_t *ptr = buf, *end = buf + size;
+	TWKB_AGG_STATE *s;
+	uint64_t len, first_coord;
+	uint32_t i, ngeoms, nempty, nempty_points;
+	int8_t prec[3];
+	uint8_t flags[5];
+
+	if ( ! twkb_agg_read(&ptr, end, flags, 1) ||
+	     ! twkb_agg_read(&ptr, end, prec, 3) ||
+	     ! twkb_agg_read(&ptr, end, flags + 1, 4) ||
+	     ! twkb_agg_read(&ptr, end, &ngeoms, sizeof(uint32_t)) ||
+	     ! twkb_agg_read(&ptr, end, &nempty, sizeof(uint32_t)) ||
+	     ! twkb_agg_read(&ptr, end, &first_coord, sizeof(uint64_t)) )
+	{
+		lwerror("%s: truncated TWKB state", __func__);
+		return NULL;
+	}
+
+	s = twkb_agg_init(flags[0], prec[0], prec[1], prec[2]);
+	if ( ngeoms )
+	{
+		twkb_agg_start(s, flags[1], flags[3], flags[4]);
+		s->is_collection = flags[2];
+	}
+	s->ngeoms = ngeoms;
+	s->first_coord = first_coord == UINT64_MAX ? SIZE_MAX : (size_t)first_coord;
+
+	if ( ! twkb_agg_read(&ptr, end, s->ts.bbox_min, sizeof(s->ts.bbox_min)) ||
+	     ! twkb_agg_read(&ptr, end, s->ts.bbox_max, sizeof(s->ts.bbox_max)) ||
+	     ! twkb_agg_read(&ptr, end, s->ts.accum_rels, sizeof(s->ts.accum_rels)) )
+	{
+		twkb_agg_free(s);
+		lwerror("%s: truncated TWKB state", __func__);
+		return NULL;
+	}
+
+	s->nempty = nempty;
+	nempty_points = (! s->is_collection && s->type == POINTTYPE) ? nempty : 0;
+	for ( i = 0; i < nempty_points; i++ )
+	{
+		uint32_t pos;
+		if ( ! twkb_agg_read(&ptr, end, &pos, sizeof(uint32_t)) )
+		{
+			twkb_agg_free(s);
+			lwerror("%s: truncated TWKB state", __func__);
+			return NULL;
+		}
+		twkb_agg_set_empty_point(s, i, pos);
+	}
+
+	if ( ! twkb_agg_read(&ptr, end, &len, sizeof(uint64_t)) || (uint64_t)(end - ptr) < len )
+	{
+		twkb_agg_free(s);
+		lwerror("%s: truncated TWKB state", __func__);
+		return NULL;
+	}
+	bytebuffer_append_bulk(&s->id_buf, ptr, len);
+	ptr += len;
+
+	if ( ! twkb_agg_read(&ptr, end, &len, sizeof(uint64_t)) || (uint64_t)(end - ptr) < len )
+	{
+		twkb_agg_free(s);
+		lwerror("%s: truncated TWKB state", __func__);
+		return NULL;
+	}
+	bytebuffer_append_bulk(&s->geom_buf, ptr, len);
+
+	return s;
+}
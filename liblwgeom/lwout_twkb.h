@@ -95,6 +95,30 @@ typedef struct
 	int64_t accum_rels[MAX_N_DIMS]; /*Holds the acculmulated relative values*/
 } TWKB_STATE;
 
+/**
+* Running state of a TWKB collection built one geometry at a time.
+* While all inputs are points, lines or polygons of the same type they
+* are written straight into the body of a multi-geometry, carrying the
+* coordinate deltas from one input to the next. Anything else turns the
+* output into a geometry collection whose members have their own headers.
+*/
+struct TWKB_AGG_STATE
+{
+	TWKB_GLOBALS globals;
+	TWKB_STATE ts;          /* Box and delta state of the body */
+	uint8_t type;           /* Type of the first input */
+	uint8_t is_collection;  /* Are members written with their own headers? */
+	uint8_t has_z;
+	uint8_t has_m;
+	uint32_t ngeoms;        /* Number of inputs, empties included */
+	uint32_t nempty;        /* Number of empty inputs */
+	uint32_t *empty_points; /* Positions of the empty inputs of a multipoint */
+	uint32_t empty_points_size;
+	size_t first_coord;     /* Offset of the first coordinate in geom_buf, SIZE_MAX if none */
+	bytebuffer_t id_buf;
+	bytebuffer_t geom_buf;
+};
+
 static int lwgeom_to_twkb_buf(const LWGEOM *geom, TWKB_GLOBALS *global_values, TWKB_STATE *ts);
 
 static int lwpoint_to_twkb_buf(const LWPOINT *line, TWKB_GLOBALS *global_values, TWKB_STATE *ts);
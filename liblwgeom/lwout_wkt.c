@@ -76,19 +76,6 @@ static void empty_to_wkt_sb(stringbuffer_t *sb)
 	stringbuffer_append_len(sb, "EMPTY", 5);
 }
 
-inline static void
-coordinate_to_wkt_sb(double *coords, stringbuffer_t *sb, uint32_t dimensions, int precision)
-{
-	uint32_t d = 0;
-	stringbuffer_append_double(sb, coords[d], precision);
-
-	for (d = 1; d < dimensions; d++)
-	{
-		stringbuffer_append_len(sb, " ", 1);
-		stringbuffer_append_double(sb, coords[d], precision);
-	}
-}
-
 /*
 * Point array is a list of coordinates. Depending on output mode,
 * we may suppress some dimensions. ISO and Extended formats include
@@ -103,26 +90,13 @@ static void ptarray_to_wkt_sb(const POINTARRAY *ptarray, stringbuffer_t *sb, int
 	if ( variant & ( WKT_ISO | WKT_EXTENDED ) )
 		dimensions = FLAGS_NDIMS(ptarray->flags);
 
-	stringbuffer_makeroom(sb, 2 + ((OUT_MAX_BYTES_DOUBLE + 1) * dimensions * ptarray->npoints));
+	stringbuffer_makeroom(sb, 2 + OUT_MAX_BYTES_PTARRAY(ptarray->npoints, dimensions));
 	/* Opening paren? */
 	if ( ! (variant & WKT_NO_PARENS) )
 		stringbuffer_append_len(sb, "(", 1);
 
 	/* Digits and commas */
-	if (ptarray->npoints)
-	{
-		uint32_t i = 0;
-
-		double *dbl_ptr = (double *)getPoint_internal(ptarray, i);
-		coordinate_to_wkt_sb(dbl_ptr, sb, dimensions, precision);
-
-		for (i = 1; i < ptarray->npoints; i++)
-		{
-			stringbuffer_append_len(sb, ",", 1);
-			dbl_ptr = (double *)getPoint_internal(ptarray, i);
-			coordinate_to_wkt_sb(dbl_ptr, sb, dimensions, precision);
-		}
-	}
+	stringbuffer_append_ptarray(sb, ptarray, ptarray->npoints, dimensions, precision, 0);
 
 	/* Closing paren? */
 	if ( ! (variant & WKT_NO_PARENS) )
@@ -510,56 +510,17 @@ asx3d3_collection_sb(const LWCOLLECTION *col, int precision, int opts, const cha
 static int
 ptarray_to_x3d3_sb(POINTARRAY *pa, int precision, int opts, int is_closed, stringbuffer_t *sb )
 {
-	uint32_t i;
-	char x[OUT_DOUBLE_BUFFER_SIZE];
-	char y[OUT_DOUBLE_BUFFER_SIZE];
-	char z[OUT_DOUBLE_BUFFER_SIZE];
-
-	if ( ! FLAGS_GET_Z(pa->flags) )
-	{
-		for (i=0; i<pa->npoints; i++)
-		{
-			/** Only output the point if it is not the last point of a closed object or it is a non-closed type **/
-			if ( !is_closed || i < (pa->npoints - 1) )
-			{
-				POINT2D pt;
-				getPoint2d_p(pa, i, &pt);
+	uint32_t dims = FLAGS_GET_Z(pa->flags) ? 3 : 2;
+	uint32_t npoints = pa->npoints;
+	int printopts = LWPRINT_PTSEP_SPACE;
 
-				lwprint_double(pt.x, precision, x);
-				lwprint_double(pt.y, precision, y);
+	/** Only output the last point if it is a non-closed type **/
+	if ( is_closed && npoints )
+		npoints--;
 
-				if ( i ) stringbuffer_append_len(sb," ",1);
-
-				if ( ( opts & LW_X3D_FLIP_XY) )
-					stringbuffer_aprintf(sb, "%s %s", y, x);
-				else
-					stringbuffer_aprintf(sb, "%s %s", x, y);
-			}
-		}
-	}
-	else
-	{
-		for (i=0; i<pa->npoints; i++)
-		{
-			/** Only output the point if it is not the last point of a closed object or it is a non-closed type **/
-			if ( !is_closed || i < (pa->npoints - 1) )
-			{
-				POINT4D pt;
-				getPoint4d_p(pa, i, &pt);
-
-				lwprint_double(pt.x, precision, x);
-				lwprint_double(pt.y, precision, y);
-				lwprint_double(pt.z, precision, z);
-
-				if ( i ) stringbuffer_append_len(sb," ",1);
-
-				if ( ( opts & LW_X3D_FLIP_XY) )
-					stringbuffer_aprintf(sb, "%s %s %s", y, x, z);
-				else
-					stringbuffer_aprintf(sb, "%s %s %s", x, y, z);
-			}
-		}
-	}
+	if ( ( opts & LW_X3D_FLIP_XY) )
+		printopts |= LWPRINT_FLIP_XY;
 
+	stringbuffer_append_ptarray(sb, pa, npoints, dims, precision, printopts);
 	return LW_SUCCESS;
 }
@@ -470,3 +470,106 @@ lwprint_double(double d, int maxdd, char *buf)
 
 	return length;
 }
+
+/*
+ * Integral values in [1, OUT_MAX_DOUBLE) print the same at any precision,
+ * so their digits can be written directly without going through ryu.
+ * Returns the number of bytes written, or 0 if the value is not such an
+ * integer.
+ */
+static inline int
+lwprint_integral_double(double d, char *buf)
+{
+	char digits[16];
+	uint64_t u;
+	int n = 0, len = 0;
+	double ad = fabs(d);
+
+	if (!(ad >= 1 && ad < OUT_MAX_DOUBLE))
+		return 0;
+	u = (uint64_t)ad;
+	if ((double)u != ad)
+		return 0;
+
+	if (d < 0)
+		buf[len++] = '-';
+	do
+	{
+		digits[n++] = '0' + (u % 10);
+		u /= 10;
+	}
+	while (u);
+	while (n)
+		buf[len++] = digits[--n];
+
+	return len;
+}
+
+/*
+ * Print the first **npoints** points of a point array, **dims** ordinates
+ * each, straight into **buf** using at most **maxdd** decimal digits.
+ * This is the same text lwprint_double would produce for every ordinate,
+ * without the per-value temporary buffers and string copies.
+ *
+ * **opts** is a mask of LWPRINT_* layout flags. By default ordinates are
+ * separated by a space and points by a comma, as in WKT.
+ *
+ * The caller must provide OUT_MAX_BYTES_PTARRAY(npoints, dims) bytes.
+ * It returns the number of bytes written (excluding the final NULL)
+ */
+size_t
+lwprint_ptarray(const POINTARRAY *pa, uint32_t npoints, uint32_t dims, int maxdd, int opts, char *buf)
+{
+	char *ptr = buf;
+	const char ordsep = (opts & LWPRINT_ORDSEP_COMMA) ? ',' : ' ';
+	const char ptsep = (opts & LWPRINT_PTSEP_SPACE) ? ' ' : ',';
+	const int brackets = opts & LWPRINT_BRACKETS;
+	const uint32_t stride = FLAGS_NDIMS(pa->flags);
+	const double *d = (const double *)pa->serialized_pointlist;
+	int precision = FP_MAX(0, maxdd);
+	uint32_t order[4] = {0, 1, 2, 3};
+	uint32_t i, j;
+
+	assert(dims <= stride);
+	assert(npoints <= pa->npoints);
+
+	if (opts & LWPRINT_FLIP_XY)
+	{
+		order[0] = 1;
+		order[1] = 0;
+	}
+
+	for (i = 0; i < npoints; i++, d += stride)
+	{
+		if (i)
+			*ptr++ = ptsep;
+		if (brackets)
+			*ptr++ = '[';
+
+		for (j = 0; j < dims; j++)
+		{
+			double v = d[order[j]];
+			double av = fabs(v);
+			int len;
+
+			if (j)
+				*ptr++ = ordsep;
+
+			len = lwprint_integral_double(v, ptr);
+			if (!len)
+			{
+				if (av <= OUT_MIN_DOUBLE || av >= OUT_MAX_DOUBLE)
+					len = d2sexp_buffered_n(v, precision, ptr);
+				else
+					len = d2sfixed_buffered_n(v, precision, ptr);
+			}
+			ptr += len;
+		}
+
+		if (brackets)
+			*ptr++ = ']';
+	}
+	*ptr = '\0';
+
+	return ptr - buf;
+}
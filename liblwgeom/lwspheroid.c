@@ -66,6 +66,30 @@ static double spheroid_big_b(double u2)
 
 #ifdef PROJ_GEODESIC
 
+/**
+* Returns a geodesic initialized for the spheroid. Setting one up costs
+* about as much as solving a short inverse problem, and callers nearly
+* always work on one spheroid at a time, so the last one is kept around.
+* (The SPHEROID itself cannot carry it, as it is also the fixed size
+* on-disk representation of the spheroid SQL type.)
+*/
+static const struct geod_geodesic *
+spheroid_geodesic(const SPHEROID *spheroid)
+{
+	static struct geod_geodesic gd;
+	static double gd_a = 0.0, gd_f = 0.0;
+	static int gd_init = LW_FALSE;
+
+	if (!gd_init || spheroid->a != gd_a || spheroid->f != gd_f)
+	{
+		geod_init(&gd, spheroid->a, spheroid->f);
+		gd_a = spheroid->a;
+		gd_f = spheroid->f;
+		gd_init = LW_TRUE;
+	}
+	return &gd;
+}
+
 /**
 * Computes the shortest distance along the surface of the spheroid
 * between two points, using the inverse geodesic problem from
@@ -78,17 +102,41 @@ static double spheroid_big_b(double u2)
 */
 double spheroid_distance(const GEOGRAPHIC_POINT *a, const GEOGRAPHIC_POINT *b, const SPHEROID *spheroid)
 {
-	struct geod_geodesic gd;
-	geod_init(&gd, spheroid->a, spheroid->f);
+	const struct geod_geodesic *gd = spheroid_geodesic(spheroid);
 	double lat1 = a->lat * 180.0 / M_PI;
 	double lon1 = a->lon * 180.0 / M_PI;
 	double lat2 = b->lat * 180.0 / M_PI;
 	double lon2 = b->lon * 180.0 / M_PI;
 	double s12 = 0.0; /* return distance */
-	geod_inverse(&gd, lat1, lon1, lat2, lon2, &s12, 0, 0);
+	geod_inverse(gd, lat1, lon1, lat2, lon2, &s12, 0, 0);
 	return s12;
 }
 
+/**
+* Computes the spheroidal distances between the pairs of points
+* a[i] and b[i], sharing the geodesic setup between all of them.
+*
+* @param a - first points of the pairs
+* @param b - second points of the pairs
+* @param n - number of pairs
+* @param s - spheroid to calculate on
+* @param distances - output, n distances in spheroid units
+*/
+void spheroid_distances(const GEOGRAPHIC_POINT *a, const GEOGRAPHIC_POINT *b, uint32_t n, const SPHEROID *spheroid, double *distances)
+{
+	const struct geod_geodesic *gd = spheroid_geodesic(spheroid);
+	uint32_t i;
+
+	for (i = 0; i < n; i++)
+	{
+		distances[i] = 0.0;
+		geod_inverse(gd,
+			a[i].lat * 180.0 / M_PI, a[i].lon * 180.0 / M_PI,
+			b[i].lat * 180.0 / M_PI, b[i].lon * 180.0 / M_PI,
+			&distances[i], 0, 0);
+	}
+}
+
 /**
 * Computes the forward azimuth of the geodesic joining two points on
 * the spheroid, using the inverse geodesic problem (Karney 2013).
@@ -99,14 +147,13 @@ double spheroid_distance(const GEOGRAPHIC_POINT *a, const GEOGRAPHIC_POINT *b, c
 */
 double spheroid_direction(const GEOGRAPHIC_POINT *a, const GEOGRAPHIC_POINT *b, const SPHEROID *spheroid)
 {
-	struct geod_geodesic gd;
-	geod_init(&gd, spheroid->a, spheroid->f);
+	const struct geod_geodesic *gd = spheroid_geodesic(spheroid);
 	double lat1 = a->lat * 180.0 / M_PI;
 	double lon1 = a->lon * 180.0 / M_PI;
 	double lat2 = b->lat * 180.0 / M_PI;
 	double lon2 = b->lon * 180.0 / M_PI;
 	double azi1; /* return azimuth */
-	geod_inverse(&gd, lat1, lon1, lat2, lon2, 0, &azi1, 0);
+	geod_inverse(gd, lat1, lon1, lat2, lon2, 0, &azi1, 0);
 	return azi1 * M_PI / 180.0;
 }
 
@@ -122,12 +169,11 @@ double spheroid_direction(const GEOGRAPHIC_POINT *a, const GEOGRAPHIC_POINT *b,
 */
 int spheroid_project(const GEOGRAPHIC_POINT *r, const SPHEROID *spheroid, double distance, double azimuth, GEOGRAPHIC_POINT *g)
 {
-	struct geod_geodesic gd;
-	geod_init(&gd, spheroid->a, spheroid->f);
+	const struct geod_geodesic *gd = spheroid_geodesic(spheroid);
 	double lat1 = r->lat * 180.0 / M_PI;
 	double lon1 = r->lon * 180.0 / M_PI;
 	double lat2, lon2; /* return projected position */
-	geod_direct(&gd, lat1, lon1, azimuth * 180.0 / M_PI, distance, &lat2, &lon2, 0);
+	geod_direct(gd, lat1, lon1, azimuth * 180.0 / M_PI, distance, &lat2, &lon2, 0);
 	g->lat = lat2 * M_PI / 180.0;
 	g->lon = lon2 * M_PI / 180.0;
 	return LW_SUCCESS;
@@ -140,8 +186,7 @@ static double ptarray_area_spheroid(const POINTARRAY *pa, const SPHEROID *sphero
 	if ( ! pa || pa->npoints < 4 )
 		return 0.0;
 
-	struct geod_geodesic gd;
-	geod_init(&gd, spheroid->a, spheroid->f);
+	const struct geod_geodesic *gd = spheroid_geodesic(spheroid);
 	struct geod_polygon poly;
 	geod_polygon_init(&poly, 0);
 	uint32_t i;
@@ -152,10 +197,10 @@ static double ptarray_area_spheroid(const POINTARRAY *pa, const SPHEROID *sphero
 	for ( i = 0; i < pa->npoints - 1; i++ )
 	{
 		getPoint2d_p(pa, i, &p);
-		geod_polygon_addpoint(&gd, &poly, p.y, p.x);
+		geod_polygon_addpoint(gd, &poly, p.y, p.x);
 		LWDEBUGF(4, "geod_polygon_addpoint %d: %.12g %.12g", i, p.y, p.x);
 	}
-	i = geod_polygon_compute(&gd, &poly, 0, 1, &area, 0);
+	i = geod_polygon_compute(gd, &poly, 0, 1, &area, 0);
 	if ( i != pa->npoints - 1 )
 	{
 		lwerror("ptarray_area_spheroid: different number of points %d vs %d",
@@ -266,6 +311,23 @@ double spheroid_distance(const GEOGRAPHIC_POINT *a, const GEOGRAPHIC_POINT *b, c
 	return distance;
 }
 
+/**
+* Computes the spheroidal distances between the pairs of points
+* a[i] and b[i].
+*
+* @param a - first points of the pairs
+* @param b - second points of the pairs
+* @param n - number of pairs
+* @param s - spheroid to calculate on
+* @param distances - output, n distances in spheroid units
+*/
+void spheroid_distances(const GEOGRAPHIC_POINT *a, const GEOGRAPHIC_POINT *b, uint32_t n, const SPHEROID *spheroid, double *distances)
+{
+	uint32_t i;
+	for (i = 0; i < n; i++)
+		distances[i] = spheroid_distance(&a[i], &b[i], spheroid);
+}
+
 /**
 * Computes the direction of the geodesic joining two points on
 * the spheroid. Based on Vincenty's formula for the geodetic
@@ -61,23 +61,76 @@ rect_node_cmp(const void *pn1, const void *pn2)
 	return h1 < h2 ? -1 : (h1 > h2 ? 1 : 0);
 }
 
+/*
+* All the nodes of a tree are carved out of one block, sized
+* up front from the input geometry, so building a tree is a single
+* allocation and freeing it is another. Slot zero is kept for the
+* root, which is only known once the merge is done, so that the
+* root pointer is also the pointer to the block.
+*/
+typedef struct
+{
+	RECT_NODE *nodes;
+	uint32_t num_nodes;
+	uint32_t max_nodes;
+} RECT_NODE_ARENA;
+
+static void
+rect_node_arena_init(RECT_NODE_ARENA *arena, uint32_t max_nodes)
+{
+	arena->max_nodes = max_nodes + 1;
+	arena->num_nodes = 1;
+	arena->nodes = lwalloc(sizeof(RECT_NODE) * arena->max_nodes);
+}
+
+static RECT_NODE *
+rect_node_arena_alloc(RECT_NODE_ARENA *arena)
+{
+	if (arena->num_nodes >= arena->max_nodes)
+	{
+		lwerror("%s: node arena exhausted", __func__);
+		return NULL;
+	}
+	return &(arena->nodes[arena->num_nodes++]);
+}
+
+static RECT_NODE *
+rect_node_arena_finish(RECT_NODE_ARENA *arena, const RECT_NODE *tree)
+{
+	if (!tree)
+	{
+		lwfree(arena->nodes);
+		return NULL;
+	}
+	/* Nothing points at the root, so it can move to slot zero */
+	arena->nodes[0] = *tree;
+	return arena->nodes;
+}
+
+/*
+* Number of internal nodes rect_nodes_merge() will need
+* to join num_nodes nodes into one tree.
+*/
+static uint32_t
+rect_nodes_merge_count(uint32_t num_nodes)
+{
+	uint32_t count = 0;
+	while (num_nodes > 1)
+	{
+		num_nodes = (num_nodes + RECT_NODE_SIZE - 1) / RECT_NODE_SIZE;
+		count += num_nodes;
+	}
+	return count;
+}
+
 /**
-* Recurse from top of node tree and free all children.
-* does not free underlying point array.
+* Free the tree, which lives in a single block headed
+* by the root node. Does not free underlying point array.
 */
 void
 rect_tree_free(RECT_NODE *node)
 {
-	int i;
 	if (!node) return;
-	if (!rect_node_is_leaf(node))
-	{
-		for (i = 0; i < node->i.num_nodes; i++)
-		{
-			rect_tree_free(node->i.nodes[i]);
-			node->i.nodes[i] = NULL;
-		}
-	}
 	lwfree(node);
 }
 
@@ -487,7 +540,7 @@ static RECT_NODE_SEG_TYPE lwgeomTypeArc[] =
 * Create a new leaf node.
 */
 static RECT_NODE *
-rect_node_leaf_new(const POINTARRAY *pa, int seg_num, int geom_type)
+rect_node_leaf_new(RECT_NODE_ARENA *arena, const POINTARRAY *pa, int seg_num, int geom_type)
 {
 	const POINT2D *p1, *p2, *p3;
 	RECT_NODE *node;
@@ -538,7 +591,7 @@ rect_node_leaf_new(const POINTARRAY *pa, int seg_num, int geom_type)
 		}
 	}
 
-	node = lwalloc(sizeof(RECT_NODE));
+	node = rect_node_arena_alloc(arena);
 	node->type = RECT_NODE_LEAF_TYPE;
 	node->geom_type = geom_type;
 	node->xmin = gbox.xmin;
@@ -567,9 +620,9 @@ rect_node_internal_add_node(RECT_NODE *node, RECT_NODE *add)
 
 
 static RECT_NODE *
-rect_node_internal_new(const RECT_NODE *seed)
+rect_node_internal_new(RECT_NODE_ARENA *arena, const RECT_NODE *seed)
 {
-	RECT_NODE *node = lwalloc(sizeof(RECT_NODE));
+	RECT_NODE *node = rect_node_arena_alloc(arena);
 	node->xmin = seed->xmin;
 	node->xmax = seed->xmax;
 	node->ymin = seed->ymin;
@@ -593,7 +646,7 @@ rect_node_internal_new(const RECT_NODE *seed)
 * spatially coherent structure.
 */
 static RECT_NODE *
-rect_nodes_merge(RECT_NODE ** nodes, uint32_t num_nodes)
+rect_nodes_merge(RECT_NODE_ARENA *arena, RECT_NODE ** nodes, uint32_t num_nodes)
 {
 	if (num_nodes < 1)
 	{
@@ -607,7 +660,7 @@ rect_nodes_merge(RECT_NODE ** nodes, uint32_t num_nodes)
 		for (i = 0; i < num_nodes; i++)
 		{
 			if (!node)
-				node = rect_node_internal_new(nodes[i]);
+				node = rect_node_internal_new(arena, nodes[i]);
 
 			rect_node_internal_add_node(node, nodes[i]);
 
@@ -625,11 +678,33 @@ rect_nodes_merge(RECT_NODE ** nodes, uint32_t num_nodes)
 	return nodes[0];
 }
 
+/*
+* Number of edges in a point array, and so the
+* number of leaf nodes it can contribute.
+*/
+static uint32_t
+rect_tree_ptarray_num_edges(const POINTARRAY *pa, int geom_type)
+{
+	if (pa->npoints < 1)
+		return 0;
+	switch(lwgeomTypeArc[geom_type])
+	{
+		case RECT_NODE_SEG_POINT:
+			return 1;
+		case RECT_NODE_SEG_LINEAR:
+			return pa->npoints - 1;
+		case RECT_NODE_SEG_CIRCULAR:
+			return (pa->npoints - 1)/2;
+		default:
+			return 0;
+	}
+}
+
 /*
 * Build a tree of nodes from a point array, one node per edge.
 */
-RECT_NODE *
-rect_tree_from_ptarray(const POINTARRAY *pa, int geom_type)
+static RECT_NODE *
+rect_tree_from_ptarray_arena(RECT_NODE_ARENA *arena, const POINTARRAY *pa, int geom_type)
 {
 	int num_edges = 0, i = 0, j = 0;
 	RECT_NODE_SEG_TYPE seg_type = lwgeomTypeArc[geom_type];
@@ -644,13 +719,11 @@ rect_tree_from_ptarray(const POINTARRAY *pa, int geom_type)
 	switch(seg_type)
 	{
 		case RECT_NODE_SEG_POINT:
-			return rect_node_leaf_new(pa, 0, geom_type);
+			return rect_node_leaf_new(arena, pa, 0, geom_type);
 			break;
 		case RECT_NODE_SEG_LINEAR:
-			num_edges = pa->npoints - 1;
-			break;
 		case RECT_NODE_SEG_CIRCULAR:
-			num_edges = (pa->npoints - 1)/2;
+			num_edges = rect_tree_ptarray_num_edges(pa, geom_type);
 			break;
 		default:
 			lwerror("%s: unsupported seg_type - %d", __func__, seg_type);
@@ -660,13 +733,13 @@ rect_tree_from_ptarray(const POINTARRAY *pa, int geom_type)
 	nodes = lwalloc(sizeof(RECT_NODE*) * num_edges);
 	for (i = 0; i < num_edges; i++)
 	{
-		RECT_NODE *node = rect_node_leaf_new(pa, i, geom_type);
+		RECT_NODE *node = rect_node_leaf_new(arena, pa, i, geom_type);
 		if (node) /* Not zero length? */
 			nodes[j++] = node;
 	}
 
 	/* Merge the list into a tree */
-	tree = rect_nodes_merge(nodes, j);
+	tree = rect_nodes_merge(arena, nodes, j);
 
 	/* Free the old list structure, leaving the tree in place */
 	lwfree(nodes);
@@ -675,6 +748,15 @@ rect_tree_from_ptarray(const POINTARRAY *pa, int geom_type)
 	return tree;
 }
 
+RECT_NODE *
+rect_tree_from_ptarray(const POINTARRAY *pa, int geom_type)
+{
+	RECT_NODE_ARENA arena;
+	uint32_t num_edges = rect_tree_ptarray_num_edges(pa, geom_type);
+	rect_node_arena_init(&arena, num_edges + rect_nodes_merge_count(num_edges));
+	return rect_node_arena_finish(&arena, rect_tree_from_ptarray_arena(&arena, pa, geom_type));
+}
+
 LWGEOM *
 rect_tree_to_lwgeom(const RECT_NODE *node)
 {
@@ -727,22 +809,24 @@ rect_tree_printf(const RECT_NODE *node, int depth)
 	}
 }
 
+static RECT_NODE * rect_tree_from_lwgeom_arena(RECT_NODE_ARENA *arena, const LWGEOM *lwgeom);
+
 static RECT_NODE *
-rect_tree_from_lwpoint(const LWGEOM *lwgeom)
+rect_tree_from_lwpoint(RECT_NODE_ARENA *arena, const LWGEOM *lwgeom)
 {
 	const LWPOINT *lwpt = (const LWPOINT*)lwgeom;
-	return rect_tree_from_ptarray(lwpt->point, lwgeom->type);
+	return rect_tree_from_ptarray_arena(arena, lwpt->point, lwgeom->type);
 }
 
 static RECT_NODE *
-rect_tree_from_lwline(const LWGEOM *lwgeom)
+rect_tree_from_lwline(RECT_NODE_ARENA *arena, const LWGEOM *lwgeom)
 {
 	const LWLINE *lwline = (const LWLINE*)lwgeom;
-	return rect_tree_from_ptarray(lwline->points, lwgeom->type);
+	return rect_tree_from_ptarray_arena(arena, lwline->points, lwgeom->type);
 }
 
 static RECT_NODE *
-rect_tree_from_lwpoly(const LWGEOM *lwgeom)
+rect_tree_from_lwpoly(RECT_NODE_ARENA *arena, const LWGEOM *lwgeom)
 {
 	RECT_NODE **nodes;
 	RECT_NODE *tree;
@@ -755,21 +839,21 @@ rect_tree_from_lwpoly(const LWGEOM *lwgeom)
 	nodes = lwalloc(sizeof(RECT_NODE*) * lwpoly->nrings);
 	for (i = 0; i < lwpoly->nrings; i++)
 	{
-		RECT_NODE *node = rect_tree_from_ptarray(lwpoly->rings[i], lwgeom->type);
+		RECT_NODE *node = rect_tree_from_ptarray_arena(arena, lwpoly->rings[i], lwgeom->type);
 		if (node)
 		{
 			node->i.ring_type = i ? RECT_NODE_RING_INTERIOR : RECT_NODE_RING_EXTERIOR;
 			nodes[j++] = node;
 		}
 	}
-	tree = rect_nodes_merge(nodes, j);
+	tree = rect_nodes_merge(arena, nodes, j);
 	tree->geom_type = lwgeom->type;
 	lwfree(nodes);
 	return tree;
 }
 
 static RECT_NODE *
-rect_tree_from_lwcurvepoly(const LWGEOM *lwgeom)
+rect_tree_from_lwcurvepoly(RECT_NODE_ARENA *arena, const LWGEOM *lwgeom)
 {
 	RECT_NODE **nodes;
 	RECT_NODE *tree;
@@ -782,7 +866,7 @@ rect_tree_from_lwcurvepoly(const LWGEOM *lwgeom)
 	nodes = lwalloc(sizeof(RECT_NODE*) * lwcol->nrings);
 	for (i = 0; i < lwcol->nrings; i++)
 	{
-		RECT_NODE *node = rect_tree_from_lwgeom(lwcol->rings[i]);
+		RECT_NODE *node = rect_tree_from_lwgeom_arena(arena, lwcol->rings[i]);
 		if (node)
 		{
 			/*
@@ -793,7 +877,7 @@ rect_tree_from_lwcurvepoly(const LWGEOM *lwgeom)
 			*/
 			if (node->type == RECT_NODE_LEAF_TYPE)
 			{
-				RECT_NODE *internal = rect_node_internal_new(node);
+				RECT_NODE *internal = rect_node_internal_new(arena, node);
 				rect_node_internal_add_node(internal, node);
 				node = internal;
 			}
@@ -806,7 +890,7 @@ rect_tree_from_lwcurvepoly(const LWGEOM *lwgeom)
 	/* tree after node merge */
 	qsort(nodes, j, sizeof(RECT_NODE*), rect_node_cmp);
 
-	tree = rect_nodes_merge(nodes, j);
+	tree = rect_nodes_merge(arena, nodes, j);
 
 	tree->geom_type = lwgeom->type;
 	lwfree(nodes);
@@ -815,7 +899,7 @@ rect_tree_from_lwcurvepoly(const LWGEOM *lwgeom)
 }
 
 static RECT_NODE *
-rect_tree_from_lwcollection(const LWGEOM *lwgeom)
+rect_tree_from_lwcollection(RECT_NODE_ARENA *arena, const LWGEOM *lwgeom)
 {
 	RECT_NODE **nodes;
 	RECT_NODE *tree;
@@ -831,7 +915,7 @@ rect_tree_from_lwcollection(const LWGEOM *lwgeom)
 	nodes = lwalloc(sizeof(RECT_NODE*) * lwcol->ngeoms);
 	for (i = 0; i < lwcol->ngeoms; i++)
 	{
-		RECT_NODE *node = rect_tree_from_lwgeom(lwcol->geoms[i]);
+		RECT_NODE *node = rect_tree_from_lwgeom_arena(arena, lwcol->geoms[i]);
 		if (node)
 		{
 			/* Curvepolygons are collections where the sub-geometries */
@@ -850,28 +934,28 @@ rect_tree_from_lwcollection(const LWGEOM *lwgeom)
 	if (lwgeom->type != COMPOUNDTYPE)
 		qsort(nodes, j, sizeof(RECT_NODE*), rect_node_cmp);
 
-	tree = rect_nodes_merge(nodes, j);
+	tree = rect_nodes_merge(arena, nodes, j);
 
 	tree->geom_type = lwgeom->type;
 	lwfree(nodes);
 	return tree;
 }
 
-RECT_NODE *
-rect_tree_from_lwgeom(const LWGEOM *lwgeom)
+static RECT_NODE *
+rect_tree_from_lwgeom_arena(RECT_NODE_ARENA *arena, const LWGEOM *lwgeom)
 {
 	switch(lwgeom->type)
 	{
 		case POINTTYPE:
-			return rect_tree_from_lwpoint(lwgeom);
+			return rect_tree_from_lwpoint(arena, lwgeom);
 		case TRIANGLETYPE:
 		case CIRCSTRINGTYPE:
 		case LINETYPE:
-			return rect_tree_from_lwline(lwgeom);
+			return rect_tree_from_lwline(arena, lwgeom);
 		case POLYGONTYPE:
-			return rect_tree_from_lwpoly(lwgeom);
+			return rect_tree_from_lwpoly(arena, lwgeom);
 		case CURVEPOLYTYPE:
-			return rect_tree_from_lwcurvepoly(lwgeom);
+			return rect_tree_from_lwcurvepoly(arena, lwgeom);
 		case COMPOUNDTYPE:
 		case MULTICURVETYPE:
 		case MULTISURFACETYPE:
@@ -881,7 +965,7 @@ rect_tree_from_lwgeom(const LWGEOM *lwgeom)
 		case POLYHEDRALSURFACETYPE:
 		case TINTYPE:
 		case COLLECTIONTYPE:
-			return rect_tree_from_lwcollection(lwgeom);
+			return rect_tree_from_lwcollection(arena, lwgeom);
 		default:
 			lwerror("%s: Unknown geometry type: %s", __func__, lwtype_name(lwgeom->type));
 			return NULL;
@@ -889,6 +973,71 @@ rect_tree_from_lwgeom(const LWGEOM *lwgeom)
 	return NULL;
 }
 
+/*
+* Upper bound on the number of nodes rect_tree_from_lwgeom_arena()
+* will allocate for a geometry, following the same type dispatch.
+* Zero-length edges are counted though they get no node.
+*/
+static uint32_t
+rect_tree_num_nodes(const LWGEOM *lwgeom)
+{
+	uint32_t i, n = 0;
+	switch(lwgeom->type)
+	{
+		case POINTTYPE:
+			n = rect_tree_ptarray_num_edges(((const LWPOINT*)lwgeom)->point, lwgeom->type);
+			return n + rect_nodes_merge_count(n);
+		case TRIANGLETYPE:
+		case CIRCSTRINGTYPE:
+		case LINETYPE:
+			n = rect_tree_ptarray_num_edges(((const LWLINE*)lwgeom)->points, lwgeom->type);
+			return n + rect_nodes_merge_count(n);
+		case POLYGONTYPE:
+		{
+			const LWPOLY *lwpoly = (const LWPOLY*)lwgeom;
+			for (i = 0; i < lwpoly->nrings; i++)
+			{
+				uint32_t num_edges = rect_tree_ptarray_num_edges(lwpoly->rings[i], lwgeom->type);
+				n += num_edges + rect_nodes_merge_count(num_edges);
+			}
+			return n + rect_nodes_merge_count(lwpoly->nrings);
+		}
+		case CURVEPOLYTYPE:
+		{
+			/* One extra node per ring, in case it needs wrapping */
+			const LWCURVEPOLY *lwcol = (const LWCURVEPOLY*)lwgeom;
+			for (i = 0; i < lwcol->nrings; i++)
+				n += rect_tree_num_nodes(lwcol->rings[i]) + 1;
+			return n + rect_nodes_merge_count(lwcol->nrings);
+		}
+		case COMPOUNDTYPE:
+		case MULTICURVETYPE:
+		case MULTISURFACETYPE:
+		case MULTIPOINTTYPE:
+		case MULTILINETYPE:
+		case MULTIPOLYGONTYPE:
+		case POLYHEDRALSURFACETYPE:
+		case TINTYPE:
+		case COLLECTIONTYPE:
+		{
+			const LWCOLLECTION *lwcol = (const LWCOLLECTION*)lwgeom;
+			for (i = 0; i < lwcol->ngeoms; i++)
+				n += rect_tree_num_nodes(lwcol->geoms[i]);
+			return n + rect_nodes_merge_count(lwcol->ngeoms);
+		}
+		default:
+			return 0;
+	}
+}
+
+RECT_NODE *
+rect_tree_from_lwgeom(const LWGEOM *lwgeom)
+{
+	RECT_NODE_ARENA arena;
+	rect_node_arena_init(&arena, rect_tree_num_nodes(lwgeom));
+	return rect_node_arena_finish(&arena, rect_tree_from_lwgeom_arena(&arena, lwgeom));
+}
+
 /*
 * Get an actual coordinate point from a tree to use
 * for point-in-polygon testing.
@@ -1286,69 +1435,107 @@ rect_tree_node_sort(RECT_NODE *n1, RECT_NODE *n2)
 	}
 }
 
-static double
-rect_tree_distance_tree_recursive(RECT_NODE *n1, RECT_NODE *n2, RECT_TREE_DISTANCE_STATE *state)
+/*
+* Pairs of nodes still to be visited by the distance search.
+* Every expansion pops one pair and pushes at most
+* RECT_NODE_SIZE*RECT_NODE_SIZE, so the stack only gets as
+* deep as that times the summed depth of the trees.
+*/
+typedef struct
 {
-	double min, max;
+	RECT_NODE *n1;
+	RECT_NODE *n2;
+} RECT_NODE_PAIR;
 
-	/* Short circuit if we've already hit the minimum */
-	if (state->min_dist < state->threshold || state->min_dist == 0.0)
-		return state->min_dist;
+typedef struct
+{
+	RECT_NODE_PAIR *pairs;
+	uint32_t num_pairs;
+	uint32_t max_pairs;
+} RECT_NODE_STACK;
 
-	/* If your minimum is greater than anyone's maximum, you can't hold the winner */
-	min = rect_node_min_distance(n1, n2);
-	if (min > state->max_dist)
+static inline void
+rect_node_stack_push(RECT_NODE_STACK *stack, RECT_NODE *n1, RECT_NODE *n2)
+{
+	if (stack->num_pairs >= stack->max_pairs)
 	{
-		//lwnotice("pruning pair %p, %p", n1, n2);
-		LWDEBUGF(4, "pruning pair %p, %p", n1, n2);
-		return FLT_MAX;
+		stack->max_pairs *= 2;
+		stack->pairs = lwrealloc(stack->pairs, sizeof(RECT_NODE_PAIR) * stack->max_pairs);
 	}
+	stack->pairs[stack->num_pairs].n1 = n1;
+	stack->pairs[stack->num_pairs].n2 = n2;
+	stack->num_pairs++;
+}
 
-	/* If your maximum is a new low, we'll use that as our new global tolerance */
-	max = rect_node_max_distance(n1, n2);
-	if (max < state->max_dist)
-		state->max_dist = max;
+/*
+* Depth-first walk of the pairs of nodes, in the same order the
+* recursive formulation would take: children are pushed in
+* reverse so the nearest pairs come off the stack first.
+*/
+static double
+rect_tree_distance_tree_search(RECT_NODE *n1, RECT_NODE *n2, RECT_TREE_DISTANCE_STATE *state)
+{
+	RECT_NODE_STACK stack;
+	stack.max_pairs = 4 * RECT_NODE_SIZE * RECT_NODE_SIZE;
+	stack.num_pairs = 0;
+	stack.pairs = lwalloc(sizeof(RECT_NODE_PAIR) * stack.max_pairs);
 
-	/* Both leaf nodes, do a real distance calculation */
-	if (rect_node_is_leaf(n1) && rect_node_is_leaf(n2))
+	rect_node_stack_push(&stack, n1, n2);
+	while (stack.num_pairs > 0)
 	{
-		return rect_leaf_node_distance(&n1->l, &n2->l, state);
-	}
-	/* Recurse into nodes */
-	else
-	{
-		int i, j;
-		double d_min = FLT_MAX;
-		rect_tree_node_sort(n1, n2);
-		if (rect_node_is_leaf(n1) && !rect_node_is_leaf(n2))
+		double min, max;
+		stack.num_pairs--;
+		n1 = stack.pairs[stack.num_pairs].n1;
+		n2 = stack.pairs[stack.num_pairs].n2;
+
+		/* Short circuit if we've already hit the minimum */
+		if (state->min_dist < state->threshold || state->min_dist == 0.0)
+			break;
+
+		/* If your minimum is greater than anyone's maximum, you can't hold the winner */
+		min = rect_node_min_distance(n1, n2);
+		if (min > state->max_dist)
 		{
-			for (i = 0; i < n2->i.num_nodes; i++)
-			{
-				min = rect_tree_distance_tree_recursive(n1, n2->i.nodes[i], state);
-				d_min = FP_MIN(d_min, min);
-			}
+			LWDEBUGF(4, "pruning pair %p, %p", n1, n2);
+			continue;
 		}
-		else if (rect_node_is_leaf(n2) && !rect_node_is_leaf(n1))
+
+		/* If your maximum is a new low, we'll use that as our new global tolerance */
+		max = rect_node_max_distance(n1, n2);
+		if (max < state->max_dist)
+			state->max_dist = max;
+
+		/* Both leaf nodes, do a real distance calculation */
+		if (rect_node_is_leaf(n1) && rect_node_is_leaf(n2))
 		{
-			for (i = 0; i < n1->i.num_nodes; i++)
-			{
-				min = rect_tree_distance_tree_recursive(n1->i.nodes[i], n2, state);
-				d_min = FP_MIN(d_min, min);
-			}
+			rect_leaf_node_distance(&n1->l, &n2->l, state);
 		}
+		/* Queue up the child pairs */
 		else
 		{
-			for (i = 0; i < n1->i.num_nodes; i++)
+			int i, j;
+			rect_tree_node_sort(n1, n2);
+			if (rect_node_is_leaf(n1) && !rect_node_is_leaf(n2))
 			{
-				for (j = 0; j < n2->i.num_nodes; j++)
-				{
-					min = rect_tree_distance_tree_recursive(n1->i.nodes[i], n2->i.nodes[j], state);
-					d_min = FP_MIN(d_min, min);
-				}
+				for (i = n2->i.num_nodes - 1; i >= 0; i--)
+					rect_node_stack_push(&stack, n1, n2->i.nodes[i]);
+			}
+			else if (rect_node_is_leaf(n2) && !rect_node_is_leaf(n1))
+			{
+				for (i = n1->i.num_nodes - 1; i >= 0; i--)
+					rect_node_stack_push(&stack, n1->i.nodes[i], n2);
+			}
+			else
+			{
+				for (i = n1->i.num_nodes - 1; i >= 0; i--)
+					for (j = n2->i.num_nodes - 1; j >= 0; j--)
+						rect_node_stack_push(&stack, n1->i.nodes[i], n2->i.nodes[j]);
 			}
 		}
-		return d_min;
 	}
+
+	lwfree(stack.pairs);
+	return state->min_dist;
 }
 
 double rect_tree_distance_tree(RECT_NODE *n1, RECT_NODE *n2, double threshold)
@@ -1377,7 +1564,7 @@ double rect_tree_distance_tree(RECT_NODE *n1, RECT_NODE *n2, double threshold)
 	state.threshold = threshold;
 	state.min_dist = FLT_MAX;
 	state.max_dist = FLT_MAX;
-	distance = rect_tree_distance_tree_recursive(n1, n2, &state);
+	distance = rect_tree_distance_tree_search(n1, n2, &state);
 	// *p1 = state.p1;
 	// *p2 = state.p2;
 	return distance;
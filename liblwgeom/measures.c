@@ -1122,6 +1122,67 @@ lw_dist2d_curvepoly_curvepoly(LWCURVEPOLY *poly1, LWCURVEPOLY *poly2, DISTPTS *d
 	return LW_FALSE;
 }
 
+/**
+ * Number of segments the brute force point array scans look at in one go
+ * before deciding whether any of them can improve the current answer.
+ */
+#define DIST2D_BLOCK_SIZE 64
+
+/**
+ * Slack on block lower bounds. The bounds and the exact path round
+ * differently, so a block is only skipped when it loses by more than
+ * a few thousand ulps of the magnitudes involved.
+ */
+#define DIST2D_BLOCK_SLACK 1e-12
+
+/**
+ * Lower bounds on the distance from p to each block of segments of pa,
+ * from the gap between p and the box of the block. This is a plain
+ * scan over the raw coordinates with no division and no DISTPTS
+ * bookkeeping, that the compiler can keep in registers and vectorise.
+ * It also returns in *ub the distance to the closest first vertex of a
+ * block, an upper bound on the answer, and in *scale the largest coordinate magnitude,
+ * to bound the rounding error of the bounds.
+ */
+static void
+lw_dist2d_pt_blocks(const POINT2D *p, const POINTARRAY *pa, uint32_t nblocks, double *lb, double *ub, double *scale)
+{
+	const double *c = (const double *)getPoint_internal(pa, 0);
+	const size_t stride = FLAGS_NDIMS(pa->flags);
+	const double px = p->x, py = p->y;
+	double d2min = FLT_MAX, smax = 0.0;
+
+	for (uint32_t b = 0; b < nblocks; b++)
+	{
+		uint32_t v0 = b * DIST2D_BLOCK_SIZE;
+		uint32_t v1 = FP_MIN(v0 + DIST2D_BLOCK_SIZE, pa->npoints - 1);
+		double xmin = c[v0 * stride], xmax = xmin;
+		double ymin = c[v0 * stride + 1], ymax = ymin;
+		double dx, dy;
+
+		for (uint32_t v = v0 + 1; v <= v1; v++)
+		{
+			const double x = c[v * stride], y = c[v * stride + 1];
+			xmin = x < xmin ? x : xmin;
+			xmax = x > xmax ? x : xmax;
+			ymin = y < ymin ? y : ymin;
+			ymax = y > ymax ? y : ymax;
+		}
+
+		/* First vertex of the block, for the upper bound */
+		dx = c[v0 * stride] - px;
+		dy = c[v0 * stride + 1] - py;
+		d2min = FP_MIN(d2min, dx * dx + dy * dy);
+
+		dx = FP_MAX(0.0, FP_MAX(xmin - px, px - xmax));
+		dy = FP_MAX(0.0, FP_MAX(ymin - py, py - ymax));
+		lb[b] = sqrt(dx * dx + dy * dy);
+		smax = FP_MAX(smax, FP_MAX(FP_MAX(fabs(xmin), fabs(xmax)), FP_MAX(fabs(ymin), fabs(ymax))));
+	}
+	*ub = sqrt(d2min);
+	*scale = smax + fabs(px) + fabs(py);
+}
+
 /**
  * search all the segments of pointarray to see which one is closest to p1
  * Returns minimum distance between point and pointarray
@@ -1131,24 +1192,68 @@ lw_dist2d_pt_ptarray(const POINT2D *p, POINTARRAY *pa, DISTPTS *dl)
 {
 	const POINT2D *start, *end;
 	int twist = dl->twisted;
+	uint32_t b, nblocks = 0;
+	double *lb = NULL;
+	double ub = FLT_MAX, slack = 0.0;
 
 	start = getPoint2d_cp(pa, 0);
 
 	if (!lw_dist2d_pt_pt(p, start, dl))
 		return LW_FALSE;
 
-	for (uint32_t t = 1; t < pa->npoints; t++)
+	if (pa->npoints < 2)
+		return LW_TRUE;
+
+	/*
+	 * For min distance on long arrays, bound every block of segments
+	 * first. A block whose lower bound is beyond both the upper bound from
+	 * the block vertices and the tolerance can neither hold the answer nor
+	 * stop the scan, so it is skipped. The other blocks are walked segment
+	 * by segment as before, so the result and the closest points are
+	 * unchanged.
+	 */
+	nblocks = (pa->npoints - 2) / DIST2D_BLOCK_SIZE + 1;
+	if (dl->mode == DIST_MIN && nblocks > 1)
 	{
-		dl->twisted = twist;
-		end = getPoint2d_cp(pa, t);
-		if (!lw_dist2d_pt_seg(p, start, end, dl))
-			return LW_FALSE;
+		double scale;
+		lb = lwalloc(sizeof(double) * nblocks);
+		lw_dist2d_pt_blocks(p, pa, nblocks, lb, &ub, &scale);
+		ub = FP_MAX(ub, dl->tolerance);
+		slack = DIST2D_BLOCK_SLACK * (scale + ub);
+	}
 
-		if (dl->distance <= dl->tolerance && dl->mode == DIST_MIN)
-			return LW_TRUE; /*just a check if the answer is already given*/
-		start = end;
+	for (b = 0; b < nblocks; b++)
+	{
+		uint32_t t0 = b * DIST2D_BLOCK_SIZE + 1;
+		uint32_t t1 = FP_MIN(t0 + DIST2D_BLOCK_SIZE, pa->npoints);
+
+		if (lb && lb[b] > FP_MIN(ub, dl->distance) + slack)
+			continue;
+
+		start = getPoint2d_cp(pa, t0 - 1);
+		for (uint32_t t = t0; t < t1; t++)
+		{
+			dl->twisted = twist;
+			end = getPoint2d_cp(pa, t);
+			if (!lw_dist2d_pt_seg(p, start, end, dl))
+			{
+				if (lb)
+					lwfree(lb);
+				return LW_FALSE;
+			}
+
+			if (dl->distance <= dl->tolerance && dl->mode == DIST_MIN)
+			{
+				if (lb)
+					lwfree(lb);
+				return LW_TRUE; /*just a check if the answer is already given*/
+			}
+			start = end;
+		}
 	}
 
+	if (lb)
+		lwfree(lb);
 	return LW_TRUE;
 }
 
@@ -1208,10 +1313,11 @@ lw_dist2d_pt_ptarrayarc(const POINT2D *p, const POINTARRAY *pa, DISTPTS *dl)
 int
 lw_dist2d_ptarray_ptarray(POINTARRAY *l1, POINTARRAY *l2, DISTPTS *dl)
 {
-	uint32_t t, u;
+	uint32_t t, u, b, nblocks;
 	const POINT2D *start, *end;
 	const POINT2D *start2, *end2;
 	int twist = dl->twisted;
+	GBOX *boxes = NULL;
 
 	LWDEBUGF(2, "lw_dist2d_ptarray_ptarray called (points: %d-%d)", l1->npoints, l2->npoints);
 
@@ -1228,26 +1334,82 @@ lw_dist2d_ptarray_ptarray(POINTARRAY *l1, POINTARRAY *l2, DISTPTS *dl)
 				lw_dist2d_pt_pt(start, start2, dl);
 			}
 		}
+		return LW_TRUE;
 	}
-	else
+
+	if (l2->npoints < 2)
+		return LW_TRUE;
+
+	/*
+	 * Cut L2 into blocks of segments and box each block once, so each
+	 * segment of L1 can skip whole blocks that lie further away than the
+	 * current answer. Only worth it when there is more than one block.
+	 */
+	nblocks = (l2->npoints - 2) / DIST2D_BLOCK_SIZE + 1;
+	if (nblocks > 1)
 	{
-		start = getPoint2d_cp(l1, 0);
-		for (t = 1; t < l1->npoints; t++) /*for each segment in L1 */
+		boxes = lwalloc(sizeof(GBOX) * nblocks);
+		for (b = 0; b < nblocks; b++)
 		{
-			end = getPoint2d_cp(l1, t);
-			start2 = getPoint2d_cp(l2, 0);
-			for (u = 1; u < l2->npoints; u++) /*for each segment in L2 */
+			uint32_t u0 = b * DIST2D_BLOCK_SIZE;
+			uint32_t u1 = FP_MIN(u0 + DIST2D_BLOCK_SIZE, l2->npoints - 1);
+			start2 = getPoint2d_cp(l2, u0);
+			boxes[b].xmin = boxes[b].xmax = start2->x;
+			boxes[b].ymin = boxes[b].ymax = start2->y;
+			for (u = u0 + 1; u <= u1; u++)
+			{
+				end2 = getPoint2d_cp(l2, u);
+				boxes[b].xmin = FP_MIN(boxes[b].xmin, end2->x);
+				boxes[b].xmax = FP_MAX(boxes[b].xmax, end2->x);
+				boxes[b].ymin = FP_MIN(boxes[b].ymin, end2->y);
+				boxes[b].ymax = FP_MAX(boxes[b].ymax, end2->y);
+			}
+		}
+	}
+
+	start = getPoint2d_cp(l1, 0);
+	for (t = 1; t < l1->npoints; t++) /*for each segment in L1 */
+	{
+		end = getPoint2d_cp(l1, t);
+		for (b = 0; b < nblocks; b++)
+		{
+			uint32_t u0 = b * DIST2D_BLOCK_SIZE;
+			uint32_t u1 = FP_MIN(u0 + DIST2D_BLOCK_SIZE, l2->npoints - 1);
+
+			if (boxes)
+			{
+				/* Gap between the box of the segment and the box of the block */
+				double dx = FP_MAX(0.0, FP_MAX(boxes[b].xmin - FP_MAX(start->x, end->x),
+				                               FP_MIN(start->x, end->x) - boxes[b].xmax));
+				double dy = FP_MAX(0.0, FP_MAX(boxes[b].ymin - FP_MAX(start->y, end->y),
+				                               FP_MIN(start->y, end->y) - boxes[b].ymax));
+				double scale = fabs(start->x) + fabs(start->y) + fabs(end->x) + fabs(end->y) +
+				               FP_MAX(fabs(boxes[b].xmin), fabs(boxes[b].xmax)) +
+				               FP_MAX(fabs(boxes[b].ymin), fabs(boxes[b].ymax));
+				if (sqrt(dx * dx + dy * dy) > dl->distance + DIST2D_BLOCK_SLACK * (scale + dl->distance))
+					continue;
+			}
+
+			start2 = getPoint2d_cp(l2, u0);
+			for (u = u0 + 1; u <= u1; u++) /*for each segment in L2 */
 			{
 				end2 = getPoint2d_cp(l2, u);
 				dl->twisted = twist;
 				lw_dist2d_seg_seg(start, end, start2, end2, dl);
 				if (dl->distance <= dl->tolerance && dl->mode == DIST_MIN)
+				{
+					if (boxes)
+						lwfree(boxes);
 					return LW_TRUE; /*just a check if the answer is already given*/
+				}
 				start2 = end2;
 			}
-			start = end;
 		}
+		start = end;
 	}
+
+	if (boxes)
+		lwfree(boxes);
 	return LW_TRUE;
 }
 
@@ -112,4 +112,14 @@ stringbuffer_append_double(stringbuffer_t *s, double d, int precision)
 	stringbuffer_makeroom(s, OUT_MAX_BYTES_DOUBLE);
 	s->str_end += lwprint_double(d, precision, s->str_end);
 }
+
+/**
+ * Append the first npoints points of a POINTARRAY, see lwprint_ptarray.
+ */
+inline static void
+stringbuffer_append_ptarray(stringbuffer_t *s, const POINTARRAY *pa, uint32_t npoints, uint32_t dims, int precision, int opts)
+{
+	stringbuffer_makeroom(s, OUT_MAX_BYTES_PTARRAY(npoints, dims));
+	s->str_end += lwprint_ptarray(pa, npoints, dims, precision, opts, s->str_end);
+}
 #endif /* _STRINGBUFFER_H */
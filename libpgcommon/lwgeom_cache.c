@@ -195,6 +195,24 @@ GetGeomCache(FunctionCallInfo fcinfo,
 	return NULL;
 }
 
+void *
+GetCacheEntry(FunctionCallInfo fcinfo, uint32_t entry_number, size_t size)
+{
+	GenericCacheCollection* generic_cache = GetGenericCacheCollection(fcinfo);
+	GenericCache* cache;
+
+	Assert(entry_number < NUM_CACHE_ENTRIES);
+
+	cache = generic_cache->entry[entry_number];
+	if (!cache)
+	{
+		cache = MemoryContextAllocZero(PostgisCacheContext(fcinfo), size);
+		cache->type = entry_number;
+		generic_cache->entry[entry_number] = cache;
+	}
+	return cache;
+}
+
 /******************************************************************************/
 
 inline static ToastCache*
@@ -85,6 +85,13 @@ GeomCache *GetGeomCache(FunctionCallInfo fcinfo,
 			SHARED_GSERIALIZED *g1,
 			SHARED_GSERIALIZED *g2);
 
+/**
+* Get the slot for a cache type that keeps its own structure
+* instead of a GeomCache, allocating it zeroed on first use.
+* The structure must start with an int type member.
+*/
+void *GetCacheEntry(FunctionCallInfo fcinfo, uint32_t entry_number, size_t size);
+
 /******************************************************************************/
 
 #define ToastCacheSize 2
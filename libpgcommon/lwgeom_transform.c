@@ -47,6 +47,12 @@
 /* Global to hold the Proj object cache */
 PROJSRSCache *PROJ_CACHE = NULL;
 
+/* GUC postgis.proj_cache_size */
+int postgis_proj_cache_size = PROJ_CACHE_ITEMS;
+
+/* GUC postgis.proj_prewarm, "from:to,from:to,..." SRID pairs */
+char *postgis_proj_prewarm = NULL;
+
 
 /**
  * Utility structure to get many potential string representations
@@ -58,9 +64,15 @@ typedef struct {
 	char* proj4text;
 } PjStrs;
 
+/* Entry of the SRID to definition strings hash */
+typedef struct {
+	int32_t srid;
+	PjStrs strs;
+} PjStrsCacheEntry;
+
 /* Internal Cache API */
 static LWPROJ *
-AddToPROJSRSCache(PROJSRSCache *PROJCache, int32_t srid_from, int32_t srid_to);
+AddToPROJSRSCache(PROJSRSCache *PROJCache, int32_t srid_from, int32_t srid_to, int elevel);
 static void DeleteFromPROJSRSCache(PROJSRSCache *PROJCache, uint32_t position);
 
 static void
@@ -126,9 +138,23 @@ GetPROJSRSCache()
 		if (!cache)
 			elog(ERROR, "Unable to allocate space for PROJSRSCache in context %p", context);
 
+		cache->PROJSRSCacheSize = postgis_proj_cache_size;
+		cache->PROJSRSCache = MemoryContextAllocZero(context, sizeof(PROJSRSCacheItem) * cache->PROJSRSCacheSize);
 		cache->PROJSRSCacheCount = 0;
+		cache->PROJSRSCacheClock = 0;
+		cache->PROJSRSCachePrewarmed = false;
 		cache->PROJSRSCacheContext = context;
 
+		HASHCTL ctl;
+		memset(&ctl, 0, sizeof(ctl));
+		ctl.keysize = sizeof(int32_t);
+		ctl.entrysize = sizeof(PjStrsCacheEntry);
+		ctl.hcxt = context;
+		cache->PROJSRSStrings = hash_create("PostGIS PROJ strings",
+						    PROJ_BACKEND_HASH_SIZE,
+						    &ctl,
+						    HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+
 		/* Use this to clean up PROJSRSCache in event of MemoryContext reset */
 		MemoryContextCallback* callback = MemoryContextAlloc(context, sizeof(MemoryContextCallback));
 		callback->func = PROJSRSDestroyPortalCache;
@@ -154,7 +180,7 @@ GetProjectionFromPROJCache(PROJSRSCache *cache, int32_t srid_from, int32_t srid_
 		if (cache->PROJSRSCache[i].srid_from == srid_from &&
 		    cache->PROJSRSCache[i].srid_to == srid_to)
 		{
-			cache->PROJSRSCache[i].hits++;
+			cache->PROJSRSCache[i].last_used = ++cache->PROJSRSCacheClock;
 			return cache->PROJSRSCache[i].projection;
 		}
 	}
@@ -162,6 +188,17 @@ GetProjectionFromPROJCache(PROJSRSCache *cache, int32_t srid_from, int32_t srid_
 	return NULL;
 }
 
+static int
+pjstrs_has_entry(const PjStrs *strs)
+{
+	if ((strs->proj4text && strlen(strs->proj4text)) ||
+		(strs->authtext && strlen(strs->authtext)) ||
+		(strs->srtext && strlen(strs->srtext)))
+		return 1;
+	else
+		return 0;
+}
+
 static char*
 SPI_pstrdup(const char* str)
 {
@@ -175,7 +212,7 @@ SPI_pstrdup(const char* str)
 }
 
 static PjStrs
-GetProjStringsSPI(int32_t srid)
+GetProjStringsSPI(int32_t srid, int elevel)
 {
 	int spi_result;
 	char proj_spi_buffer[spibufferlen];
@@ -228,10 +265,13 @@ GetProjStringsSPI(int32_t srid)
 		char* srtext = SPI_getvalue(tuple, tupdesc, 4);
 		if (srtext && strlen(srtext))
 			strs.srtext = SPI_pstrdup(srtext);
+
+		if (!pjstrs_has_entry(&strs))
+			elog(elevel, "got NULL for SRID (%d)", srid);
 	}
 	else
 	{
-		elog(ERROR, "Cannot find SRID (%d) in spatial_ref_sys", srid);
+		elog(elevel, "Cannot find SRID (%d) in spatial_ref_sys", srid);
 	}
 
 	spi_result = SPI_finish();
@@ -249,9 +289,11 @@ GetProjStringsSPI(int32_t srid)
  *  If the integer is one of the "well known" projections we support
  *  (WGS84 UTM N/S, Polar Stereographic N/S - see SRID_* macros),
  *  return the proj4text for those.
+ *  An unknown SRID is reported at elevel, and gives empty strings
+ *  when that is below ERROR.
  */
 static PjStrs
-GetProjStrings(int32_t srid)
+GetProjStrings(int32_t srid, int elevel)
 {
 	PjStrs strs;
 	memset(&strs, 0, sizeof(strs));
@@ -259,7 +301,7 @@ GetProjStrings(int32_t srid)
 	/* SRIDs in SPATIAL_REF_SYS */
 	if ( srid < SRID_RESERVE_OFFSET )
 	{
-		return GetProjStringsSPI(srid);
+		return GetProjStringsSPI(srid, elevel);
 	}
 	/* Automagic SRIDs */
 	else
@@ -328,7 +370,9 @@ GetProjStrings(int32_t srid)
 		}
 		else
 		{
-			elog(ERROR, "Invalid reserved SRID (%d)", srid);
+			elog(elevel, "Invalid reserved SRID (%d)", srid);
+			pfree(strs.proj4text);
+			strs.proj4text = NULL;
 			return strs;
 		}
 
@@ -337,17 +381,6 @@ GetProjStrings(int32_t srid)
 	}
 }
 
-static int
-pjstrs_has_entry(const PjStrs *strs)
-{
-	if ((strs->proj4text && strlen(strs->proj4text)) ||
-		(strs->authtext && strlen(strs->authtext)) ||
-		(strs->srtext && strlen(strs->srtext)))
-		return 1;
-	else
-		return 0;
-}
-
 static void
 pjstrs_pfree(PjStrs *strs)
 {
@@ -359,6 +392,41 @@ pjstrs_pfree(PjStrs *strs)
 		pfree(strs->srtext);
 }
 
+static char *
+pjstrs_strdup(MemoryContext context, const char *str)
+{
+	return str ? MemoryContextStrdup(context, str) : NULL;
+}
+
+/**
+ * Look up the definition strings of an SRID, reading them only
+ * once per backend. The returned strings belong to the cache.
+ * Failures are reported at elevel.
+ */
+static PjStrs
+GetProjStringsCached(PROJSRSCache *PROJCache, int32_t srid, int elevel)
+{
+	PjStrsCacheEntry *entry;
+	PjStrs strs;
+	bool found;
+
+	entry = hash_search(PROJCache->PROJSRSStrings, &srid, HASH_FIND, NULL);
+	if (entry)
+		return entry->strs;
+
+	/* Nothing usable was found, and that has been reported */
+	strs = GetProjStrings(srid, elevel);
+	if (!pjstrs_has_entry(&strs))
+		return strs;
+
+	entry = hash_search(PROJCache->PROJSRSStrings, &srid, HASH_ENTER, &found);
+	entry->strs.authtext = pjstrs_strdup(PROJCache->PROJSRSCacheContext, strs.authtext);
+	entry->strs.srtext = pjstrs_strdup(PROJCache->PROJSRSCacheContext, strs.srtext);
+	entry->strs.proj4text = pjstrs_strdup(PROJCache->PROJSRSCacheContext, strs.proj4text);
+	pjstrs_pfree(&strs);
+	return entry->strs;
+}
+
 #if POSTGIS_PROJ_VERSION >= 61
 static char*
 pgstrs_get_entry(const PjStrs *strs, int n)
@@ -388,7 +456,7 @@ GetProj4String(int32_t srid)
 	PjStrs strs;
 	char *proj4str;
 	memset(&strs, 0, sizeof(strs));
-	strs = GetProjStringsSPI(srid);
+	strs = GetProjStringsSPI(srid, ERROR);
 	proj4str = pstrdup(strs.proj4text);
 	pjstrs_pfree(&strs);
 	return proj4str;
@@ -396,12 +464,12 @@ GetProj4String(int32_t srid)
 #endif
 
 /**
- * Add an entry to the local PROJ SRS cache. If we need to wrap around then
- * we must make sure the entry we choose to delete does not contain other_srid
- * which is the definition for the other half of the transformation.
+ * Add an entry to the local PROJ SRS cache. If the cache is full the
+ * least recently used entry is evicted. Failures are reported at elevel,
+ * and give NULL when that is below ERROR.
  */
 static LWPROJ *
-AddToPROJSRSCache(PROJSRSCache *PROJCache, int32_t srid_from, int32_t srid_to)
+AddToPROJSRSCache(PROJSRSCache *PROJCache, int32_t srid_from, int32_t srid_to, int elevel)
 {
 	MemoryContext oldContext;
 
@@ -412,12 +480,12 @@ AddToPROJSRSCache(PROJSRSCache *PROJCache, int32_t srid_from, int32_t srid_to)
 	** Turn the SRID number into a proj4 string, by reading from spatial_ref_sys
 	** or instantiating a magical value from a negative srid.
 	*/
-	from_strs = GetProjStrings(srid_from);
+	from_strs = GetProjStringsCached(PROJCache, srid_from, elevel);
 	if (!pjstrs_has_entry(&from_strs))
-		elog(ERROR, "got NULL for SRID (%d)", srid_from);
-	to_strs = GetProjStrings(srid_to);
+		return NULL;
+	to_strs = GetProjStringsCached(PROJCache, srid_to, elevel);
 	if (!pjstrs_has_entry(&to_strs))
-		elog(ERROR, "got NULL for SRID (%d)", srid_to);
+		return NULL;
 
 	oldContext = MemoryContextSwitchTo(PROJCache->PROJSRSCacheContext);
 
@@ -428,15 +496,19 @@ AddToPROJSRSCache(PROJSRSCache *PROJCache, int32_t srid_from, int32_t srid_to)
 	projection->pj_from = projpj_from_string(pj_from_str);
 	projection->pj_to = projpj_from_string(pj_to_str);
 
-	if (!projection->pj_from)
-		elog(ERROR,
-		    "could not form projection from 'srid=%d' to 'srid=%d'",
-		    srid_from, srid_to);
-
-	if (!projection->pj_to)
-		elog(ERROR,
+	if (!projection->pj_from || !projection->pj_to)
+	{
+		elog(elevel,
 		    "could not form projection from 'srid=%d' to 'srid=%d'",
 		    srid_from, srid_to);
+		if (projection->pj_from)
+			pj_free(projection->pj_from);
+		if (projection->pj_to)
+			pj_free(projection->pj_to);
+		pfree(projection);
+		MemoryContextSwitchTo(oldContext);
+		return NULL;
+	}
 #else
 
 	LWPROJ *projection = NULL;
@@ -458,37 +530,43 @@ AddToPROJSRSCache(PROJSRSCache *PROJCache, int32_t srid_from, int32_t srid_to)
 	}
 	if (!projection)
 	{
-		elog(ERROR, "could not form projection (LWPROJ) from 'srid=%d' to 'srid=%d'", srid_from, srid_to);
+		elog(elevel, "could not form projection (LWPROJ) from 'srid=%d' to 'srid=%d'", srid_from, srid_to);
+		MemoryContextSwitchTo(oldContext);
 		return NULL;
 	}
 #endif
 
-	/* If the cache is already full then find the least used element and delete it */
-	uint32_t cache_position = PROJCache->PROJSRSCacheCount;
-	uint32_t hits = 1;
-	if (cache_position == PROJ_CACHE_ITEMS)
+	/* The size limit may have been raised since the cache was created */
+	uint32_t max_items = postgis_proj_cache_size;
+	if (max_items > PROJCache->PROJSRSCacheSize)
+	{
+		PROJCache->PROJSRSCache = repalloc(PROJCache->PROJSRSCache, sizeof(PROJSRSCacheItem) * max_items);
+		memset(PROJCache->PROJSRSCache + PROJCache->PROJSRSCacheSize,
+		       0,
+		       sizeof(PROJSRSCacheItem) * (max_items - PROJCache->PROJSRSCacheSize));
+		PROJCache->PROJSRSCacheSize = max_items;
+	}
+
+	/* If the cache is already full then delete the least recently used elements */
+	while (PROJCache->PROJSRSCacheCount >= max_items)
 	{
-		cache_position = 0;
-		hits = PROJCache->PROJSRSCache[0].hits;
-		for (uint32_t i = 1; i < PROJ_CACHE_ITEMS; i++)
+		uint32_t lru_position = 0;
+		uint64_t last_used = PROJCache->PROJSRSCache[0].last_used;
+		for (uint32_t i = 1; i < PROJCache->PROJSRSCacheCount; i++)
 		{
-			if (PROJCache->PROJSRSCache[i].hits < hits)
+			if (PROJCache->PROJSRSCache[i].last_used < last_used)
 			{
-				cache_position = i;
-				hits = PROJCache->PROJSRSCache[i].hits;
+				lru_position = i;
+				last_used = PROJCache->PROJSRSCache[i].last_used;
 			}
 		}
-		DeleteFromPROJSRSCache(PROJCache, cache_position);
-		/* To avoid the element we are introduced now being evicted next (as
-		 * it would have 1 hit, being most likely the lower one) we reuse the
-		 * hits from the evicted position and add some extra buffer
-		 */
-		hits += 5;
-	}
-	else
-	{
-		PROJCache->PROJSRSCacheCount++;
+		DeleteFromPROJSRSCache(PROJCache, lru_position);
+
+		/* Keep the entries packed */
+		PROJCache->PROJSRSCacheCount--;
+		PROJCache->PROJSRSCache[lru_position] = PROJCache->PROJSRSCache[PROJCache->PROJSRSCacheCount];
 	}
+	uint32_t cache_position = PROJCache->PROJSRSCacheCount++;
 
 	POSTGIS_DEBUGF(3,
 		       "adding transform %d => %d aka \"%s\" => \"%s\" to query cache at index %d",
@@ -498,15 +576,11 @@ AddToPROJSRSCache(PROJSRSCache *PROJCache, int32_t srid_from, int32_t srid_to)
 		       pj_to_str,
 		       cache_position);
 
-	/* Free the projection strings */
-	pjstrs_pfree(&from_strs);
-	pjstrs_pfree(&to_strs);
-
 	/* Store everything in new cache entry */
 	PROJCache->PROJSRSCache[cache_position].srid_from = srid_from;
 	PROJCache->PROJSRSCache[cache_position].srid_to = srid_to;
 	PROJCache->PROJSRSCache[cache_position].projection = projection;
-	PROJCache->PROJSRSCache[cache_position].hits = hits;
+	PROJCache->PROJSRSCache[cache_position].last_used = ++PROJCache->PROJSRSCacheClock;
 
 	MemoryContextSwitchTo(oldContext);
 	return projection;
@@ -530,6 +604,95 @@ DeleteFromPROJSRSCache(PROJSRSCache *PROJCache, uint32_t position)
 	PROJCache->PROJSRSCache[position].srid_to = SRID_UNKNOWN;
 }
 
+/**
+ * Parse a postgis.proj_prewarm value, a comma separated list of
+ * "srid_from:srid_to" pairs. Returns the number of pairs, storing
+ * up to max_pairs of them in pairs, or -1 on a syntax error.
+ */
+static int
+ParseProjPrewarmPairs(const char *str, int32_t *pairs, int max_pairs)
+{
+	int npairs = 0;
+	const char *p = str;
+
+	if (!p)
+		return 0;
+
+	while (*p)
+	{
+		char *end;
+		long srid_from, srid_to;
+
+		while (*p == ' ')
+			p++;
+		if (!*p)
+			break;
+
+		srid_from = strtol(p, &end, 10);
+		if (end == p || *end != ':')
+			return -1;
+		p = end + 1;
+		srid_to = strtol(p, &end, 10);
+		if (end == p || srid_from <= 0 || srid_to <= 0 || srid_from > INT32_MAX || srid_to > INT32_MAX)
+			return -1;
+		p = end;
+
+		while (*p == ' ')
+			p++;
+		if (*p == ',')
+			p++;
+		else if (*p)
+			return -1;
+
+		if (pairs && npairs < max_pairs)
+		{
+			pairs[2 * npairs] = srid_from;
+			pairs[2 * npairs + 1] = srid_to;
+		}
+		npairs++;
+	}
+	return npairs;
+}
+
+bool
+postgis_proj_prewarm_check(char **newval, void **extra, GucSource source)
+{
+	if (ParseProjPrewarmPairs(*newval, NULL, 0) < 0)
+	{
+		GUC_check_errdetail("Expected a comma separated list of srid_from:srid_to pairs.");
+		return false;
+	}
+	return true;
+}
+
+/**
+ * Build the transformations listed in postgis.proj_prewarm,
+ * up to the size of the cache. This runs inside whatever query
+ * first transforms, so a pair that cannot be built is skipped
+ * with a warning instead of failing that query.
+ */
+static void
+PrewarmPROJSRSCache(PROJSRSCache *PROJCache)
+{
+	int npairs = ParseProjPrewarmPairs(postgis_proj_prewarm, NULL, 0);
+	int32_t *pairs;
+
+	if (npairs <= 0)
+		return;
+
+	npairs = Min(npairs, postgis_proj_cache_size);
+	pairs = palloc(sizeof(int32_t) * 2 * npairs);
+	ParseProjPrewarmPairs(postgis_proj_prewarm, pairs, npairs);
+	for (int i = 0; i < npairs; i++)
+	{
+		int32_t srid_from = pairs[2 * i];
+		int32_t srid_to = pairs[2 * i + 1];
+		if (!GetProjectionFromPROJCache(PROJCache, srid_from, srid_to) &&
+		    !AddToPROJSRSCache(PROJCache, srid_from, srid_to, WARNING))
+			elog(WARNING, "postgis.proj_prewarm: skipping %d:%d", srid_from, srid_to);
+	}
+	pfree(pairs);
+}
 
 int
 GetLWPROJ(int32_t srid_from, int32_t srid_to, LWPROJ **pj)
@@ -540,11 +703,19 @@ GetLWPROJ(int32_t srid_from, int32_t srid_to, LWPROJ **pj)
 		return LW_FAILURE;
 
 	postgis_initialize_cache();
+
+	/* Build the configured transformations on first use in this backend */
+	if (!proj_cache->PROJSRSCachePrewarmed)
+	{
+		/* Mark first, so a failing entry is not retried on every call */
+		proj_cache->PROJSRSCachePrewarmed = true;
+		PrewarmPROJSRSCache(proj_cache);
+	}
 	/* Add the output srid to the cache if it's not already there */
 	*pj = GetProjectionFromPROJCache(proj_cache, srid_from, srid_to);
 	if (*pj == NULL)
 	{
-		*pj = AddToPROJSRSCache(proj_cache, srid_from, srid_to);
+		*pj = AddToPROJSRSCache(proj_cache, srid_from, srid_to, ERROR);
 	}
 
 	return pj != NULL;
@@ -10,6 +10,8 @@
  **********************************************************************/
 
 #include "postgres.h"
+#include "utils/guc.h"
+#include "utils/hsearch.h"
 #include "lwgeom_log.h"
 #include "liblwgeom.h"
 #include "lwgeom_pg.h"
@@ -27,7 +29,7 @@ typedef struct struct_PROJSRSCacheItem
 {
 	int32_t srid_from;
 	int32_t srid_to;
-	uint64_t hits;
+	uint64_t last_used;
 	LWPROJ *projection;
 }
 PROJSRSCacheItem;
@@ -36,18 +38,30 @@ PROJSRSCacheItem;
 #define PROJ_CACHE_ITEMS 128
 
 /*
-* The proj4 cache holds a fixed number of reprojection
-* entries. In normal usage we don't expect it to have
+* The proj4 cache holds up to postgis.proj_cache_size
+* reprojection entries, evicting the least recently used
+* one when full. In normal usage we don't expect it to have
 * many entries, so we always linearly scan the list.
+* The definition strings read for each SRID are kept too,
+* so new pairs involving a known SRID skip the SPI lookup.
 */
 typedef struct struct_PROJSRSCache
 {
-	PROJSRSCacheItem PROJSRSCache[PROJ_CACHE_ITEMS];
+	PROJSRSCacheItem *PROJSRSCache;
+	uint32_t PROJSRSCacheSize;
 	uint32_t PROJSRSCacheCount;
+	uint64_t PROJSRSCacheClock;
+	HTAB *PROJSRSStrings;
+	bool PROJSRSCachePrewarmed;
 	MemoryContext PROJSRSCacheContext;
 }
 PROJSRSCache;
 
+/* GUC variables */
+extern int postgis_proj_cache_size;
+extern char *postgis_proj_prewarm;
+bool postgis_proj_prewarm_check(char **newval, void **extra, GucSource source);
+
 
 typedef struct srs_precision
 {
@@ -268,6 +268,8 @@ void flatgeobuf_check_magicbytes(struct flatgeobuf_decode_ctx *ctx)
 	uint8_t *buf = ctx->ctx->buf + ctx->ctx->offset;
 	uint32_t i;
 
+	if (ctx->ctx->size < ctx->ctx->offset + FLATGEOBUF_MAGICBYTES_SIZE)
+		elog(ERROR, "Data is not FlatGeobuf");
 	for (i = 0; i < FLATGEOBUF_MAGICBYTES_SIZE / 2; i++)
 		if (buf[i] != flatgeobuf_magicbytes[i])
 			elog(ERROR, "Data is not FlatGeobuf");
@@ -451,19 +453,80 @@ static void decode_properties(struct flatgeobuf_decode_ctx *ctx, Datum *values,
 
 }
 
+/**
+ * Restrict decoding to the features whose bounding box intersects
+ * bbox. Must be called right after the header is decoded. When the
+ * data carries a spatial index only the matching features are read.
+ */
+void flatgeobuf_decode_filter(struct flatgeobuf_decode_ctx *ctx, const GBOX *bbox)
+{
+	ctx->has_bbox = true;
+	ctx->bbox = *bbox;
+	/* Feature boxes are computed planar, compare like with like */
+	ctx->bbox.flags = 0;
+	ctx->search_index = 0;
+	if (ctx->ctx->index_offset > 0) {
+		if (flatgeobuf_index_search(ctx->ctx, bbox->xmin, bbox->ymin, bbox->xmax, bbox->ymax))
+			elog(ERROR, "flatgeobuf_index_search: %s", ctx->ctx->search_error);
+		POSTGIS_DEBUGF(2, "index search found %ld features", ctx->ctx->search_result_len);
+	}
+}
+
+/**
+ * Move to the next feature to return and decode it.
+ * Returns false when there are no more features.
+ */
+static bool decode_next_feature(struct flatgeobuf_decode_ctx *ctx)
+{
+	flatgeobuf_ctx *fctx = ctx->ctx;
+	bool indexed = ctx->has_bbox && fctx->index_offset > 0;
+
+	while (true) {
+		if (indexed) {
+			flatgeobuf_search_item *item;
+			if (ctx->search_index >= fctx->search_result_len)
+				return false;
+			item = &fctx->search_result[ctx->search_index++];
+			fctx->offset = fctx->feature_offset + item->offset;
+			ctx->fid = item->index;
+		} else if (fctx->offset >= fctx->size) {
+			return false;
+		}
+
+		if (flatgeobuf_decode_feature(fctx))
+			elog(ERROR, "flatgeobuf_decode_feature: unsuccessful");
+
+		if (!ctx->has_bbox)
+			return true;
+		if (fctx->lwgeom != NULL && !lwgeom_is_empty(fctx->lwgeom) &&
+		    gbox_overlaps_2d(lwgeom_get_bbox(fctx->lwgeom), &ctx->bbox))
+			return true;
+
+		POSTGIS_DEBUGF(3, "skipping fid %d outside of bbox", ctx->fid);
+		if (fctx->lwgeom != NULL)
+			lwgeom_free(fctx->lwgeom);
+		ctx->fid++;
+	}
+}
+
 void flatgeobuf_decode_row(struct flatgeobuf_decode_ctx *ctx)
 {
 	HeapTuple heapTuple;
 	uint32_t natts = ctx->tupdesc->natts;
+	Datum *values;
+	bool *isnull;
+
+	if (!decode_next_feature(ctx)) {
+		POSTGIS_DEBUGF(3, "reached end at %ld", ctx->ctx->offset);
+		ctx->done = true;
+		return;
+	}
 
-	Datum *values = palloc0(natts * sizeof(Datum *));
-	bool *isnull = palloc0(natts * sizeof(bool *));
+	values = palloc0(natts * sizeof(Datum *));
+	isnull = palloc0(natts * sizeof(bool *));
 
 	values[0] = Int32GetDatum(ctx->fid);
 
-	if (flatgeobuf_decode_feature(ctx->ctx))
-		elog(ERROR, "flatgeobuf_decode_feature: unsuccessful");
-
 	if (ctx->ctx->lwgeom != NULL) {
 		values[1] = PointerGetDatum(geometry_serialize(ctx->ctx->lwgeom));
 	} else {
@@ -479,11 +542,6 @@ void flatgeobuf_decode_row(struct flatgeobuf_decode_ctx *ctx)
 	ctx->fid++;
 
 	POSTGIS_DEBUGF(3, "fid now %d", ctx->fid);
-
-	if (ctx->ctx->offset == ctx->ctx->size) {
-		POSTGIS_DEBUGF(3, "reached end at %ld", ctx->ctx->offset);
-		ctx->done = true;
-	}
 }
 
 /**
@@ -65,9 +65,13 @@ typedef struct flatgeobuf_decode_ctx
 	Datum geom;
 	int fid;
 	bool done;
+	bool has_bbox;
+	GBOX bbox;
+	uint64_t search_index;
 } flatgeobuf_decode_ctx;
 
 void flatgeobuf_check_magicbytes(struct flatgeobuf_decode_ctx *ctx);
+void flatgeobuf_decode_filter(struct flatgeobuf_decode_ctx *ctx, const GBOX *bbox);
 void flatgeobuf_decode_row(struct flatgeobuf_decode_ctx *ctx);
 
 #endif
@@ -25,6 +25,8 @@
 
 #include "postgres.h"
 #include "catalog/pg_type.h" /* for CSTRINGOID */
+#include "funcapi.h"
+#include "utils/array.h"
 
 #include "../postgis_config.h"
 
@@ -52,6 +54,9 @@ Datum geography_distance(PG_FUNCTION_ARGS);
 Datum geography_distance_uncached(PG_FUNCTION_ARGS);
 Datum geography_distance_knn(PG_FUNCTION_ARGS);
 Datum geography_distance_tree(PG_FUNCTION_ARGS);
+Datum geography_circ_tree(PG_FUNCTION_ARGS);
+Datum geography_distance_circ_tree(PG_FUNCTION_ARGS);
+Datum geography_dwithin_pairs(PG_FUNCTION_ARGS);
 Datum geography_dwithin(PG_FUNCTION_ARGS);
 Datum geography_dwithin_uncached(PG_FUNCTION_ARGS);
 Datum geography_area(PG_FUNCTION_ARGS);
@@ -377,6 +382,262 @@ Datum geography_distance_tree(PG_FUNCTION_ARGS)
 	PG_RETURN_FLOAT8(distance);
 }
 
+/*
+** geography_circ_tree(GSERIALIZED *g)
+** returns the circular tree of g, flattened into a bytea
+*/
+PG_FUNCTION_INFO_V1(geography_circ_tree);
+Datum geography_circ_tree(PG_FUNCTION_ARGS)
+{
+	GSERIALIZED *g = PG_GETARG_GSERIALIZED_P(0);
+	LWGEOM *lwgeom = lwgeom_from_gserialized(g);
+	CIRC_NODE *tree = lwgeom_calculate_circ_tree(lwgeom);
+	uint8_t *bytes;
+	size_t size;
+	bytea *result;
+
+	/* EMPTY things have no tree */
+	if ( ! tree )
+	{
+		lwgeom_free(lwgeom);
+		PG_FREE_IF_COPY(g, 0);
+		PG_RETURN_NULL();
+	}
+
+	bytes = circ_tree_to_bytes(tree, gserialized_payload_hash(g), &size);
+	result = palloc(size + VARHDRSZ);
+	SET_VARSIZE(result, size + VARHDRSZ);
+	memcpy(VARDATA(result), bytes, size);
+
+	lwfree(bytes);
+	circ_tree_free(tree);
+	lwgeom_free(lwgeom);
+	PG_FREE_IF_COPY(g, 0);
+	PG_RETURN_BYTEA_P(result);
+}
+
+/*
+* Read the tree of a geography argument from its companion bytea
+* argument, or build it from the geography when that one is NULL.
+* A stored tree must have been built from this same geography, which
+* is checked against the hash of its serialized coordinates, so the
+* geography is only deserialized when there is no stored tree.
+*/
+static CIRC_NODE *
+geography_circ_tree_arg(FunctionCallInfo fcinfo, int tree_argno, const GSERIALIZED *g,
+                        LWGEOM **lwgeom, POINTARRAY **pa)
+{
+	*pa = NULL;
+	*lwgeom = NULL;
+	if ( ! PG_ARGISNULL(tree_argno) )
+	{
+		bytea *b = PG_GETARG_BYTEA_PP(tree_argno);
+		return circ_tree_from_bytes((uint8_t*)VARDATA_ANY(b), VARSIZE_ANY_EXHDR(b),
+		                            gserialized_payload_hash(g), pa);
+	}
+	*lwgeom = lwgeom_from_gserialized(g);
+	return lwgeom_calculate_circ_tree(*lwgeom);
+}
+
+/*
+** geography_distance_circ_tree(GSERIALIZED *g1, bytea *tree1, GSERIALIZED *g2, bytea *tree2, double tolerance, boolean use_spheroid)
+** returns double distance in meters, using the stored trees where given
+*/
+PG_FUNCTION_INFO_V1(geography_distance_circ_tree);
+Datum geography_distance_circ_tree(PG_FUNCTION_ARGS)
+{
+	GSERIALIZED *g1 = NULL;
+	GSERIALIZED *g2 = NULL;
+	LWGEOM *lwgeom1, *lwgeom2;
+	POINTARRAY *pa1, *pa2;
+	CIRC_NODE *tree1, *tree2;
+	double tolerance = 0.0;
+	double distance;
+	bool use_spheroid = true;
+	SPHEROID s;
+
+	if ( PG_ARGISNULL(0) || PG_ARGISNULL(2) )
+		PG_RETURN_NULL();
+
+	/* Get our geometry objects loaded into memory. */
+	g1 = PG_GETARG_GSERIALIZED_P(0);
+	g2 = PG_GETARG_GSERIALIZED_P(2);
+
+	gserialized_error_if_srid_mismatch(g1, g2, __func__);
+
+	/* Return NULL on empty arguments. */
+	if ( gserialized_is_empty(g1) || gserialized_is_empty(g2) )
+	{
+		PG_FREE_IF_COPY(g1, 0);
+		PG_FREE_IF_COPY(g2, 2);
+		PG_RETURN_NULL();
+	}
+
+	/* Read our tolerance value. */
+	if ( PG_NARGS() > 4 && ! PG_ARGISNULL(4) )
+		tolerance = PG_GETARG_FLOAT8(4);
+
+	/* Read our calculation type. */
+	if ( PG_NARGS() > 5 && ! PG_ARGISNULL(5) )
+		use_spheroid = PG_GETARG_BOOL(5);
+
+	/* Initialize spheroid */
+	spheroid_init_from_srid(gserialized_get_srid(g1), &s);
+
+	/* Set to sphere if requested */
+	if ( ! use_spheroid )
+		s.a = s.b = s.radius;
+
+	tree1 = geography_circ_tree_arg(fcinfo, 1, g1, &lwgeom1, &pa1);
+	tree2 = geography_circ_tree_arg(fcinfo, 3, g2, &lwgeom2, &pa2);
+
+	if ( geography_tree_distance_trees(g1, tree1, g2, tree2, &s, tolerance, &distance) == LW_FAILURE )
+	{
+		elog(ERROR, "geography_distance_circ_tree failed!");
+		PG_RETURN_NULL();
+	}
+	/* Knock off any funny business at the nanometer level, ticket #2168 */
+	distance = round(distance * INVMINDIST) / INVMINDIST;
+
+	circ_tree_free(tree1);
+	circ_tree_free(tree2);
+	if ( pa1 ) ptarray_free(pa1);
+	if ( pa2 ) ptarray_free(pa2);
+	if ( lwgeom1 ) lwgeom_free(lwgeom1);
+	if ( lwgeom2 ) lwgeom_free(lwgeom2);
+	PG_FREE_IF_COPY(g1, 0);
+	PG_FREE_IF_COPY(g2, 2);
+
+	PG_RETURN_FLOAT8(distance);
+}
+
+/*
+* Pull the elements of a geography[] argument into a plain array,
+* keeping NULLs as NULL so positions line up with the SQL array.
+* Sets *nvalues to the number of non-NULL elements.
+*/
+static const GSERIALIZED **
+geography_array_elements(ArrayType *array, uint32_t *nelems, uint32_t *nvalues, int32_t *srid, bool *gotsrid)
+{
+	ArrayIterator iterator;
+	Datum value;
+	bool isnull;
+	uint32_t i = 0;
+	const GSERIALIZED **g;
+
+	*nvalues = 0;
+	*nelems = ArrayGetNItems(ARR_NDIM(array), ARR_DIMS(array));
+	g = palloc(sizeof(GSERIALIZED*) * (*nelems ? *nelems : 1));
+
+	iterator = array_create_iterator(array, 0, NULL);
+	while (array_iterate(iterator, &value, &isnull))
+	{
+		g[i] = isnull ? NULL : (GSERIALIZED *)DatumGetPointer(value);
+		if ( g[i] )
+		{
+			(*nvalues)++;
+			if ( ! *gotsrid )
+			{
+				*srid = gserialized_get_srid(g[i]);
+				*gotsrid = true;
+			}
+			else
+				gserialized_error_if_srid_mismatch_reference(g[i], *srid, __func__);
+		}
+		i++;
+	}
+	array_free_iterator(iterator);
+	return g;
+}
+
+typedef struct
+{
+	uint32_t *pairs;
+	uint32_t num_pairs;
+	uint32_t next;
+} DWithinPairsState;
+
+/*
+** geography_dwithin_pairs(GSERIALIZED[] g1, GSERIALIZED[] g2, double tolerance, boolean use_spheroid)
+** returns the one based (idx1, idx2) positions of every pair within tolerance meters
+*/
+PG_FUNCTION_INFO_V1(geography_dwithin_pairs);
+Datum geography_dwithin_pairs(PG_FUNCTION_ARGS)
+{
+	FuncCallContext *funcctx;
+	DWithinPairsState *state;
+	Datum values[2];
+	bool nulls[2] = {false, false};
+	HeapTuple tuple;
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		MemoryContext oldcontext;
+		ArrayType *array1, *array2;
+		const GSERIALIZED **g1, **g2;
+		uint32_t n1, n2, nvalues1, nvalues2;
+		int32_t srid = SRID_UNKNOWN;
+		bool gotsrid = false;
+		double tolerance;
+		bool use_spheroid = true;
+		SPHEROID s;
+
+		funcctx = SRF_FIRSTCALL_INIT();
+		oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		array1 = PG_GETARG_ARRAYTYPE_P(0);
+		array2 = PG_GETARG_ARRAYTYPE_P(1);
+		tolerance = PG_GETARG_FLOAT8(2);
+		if ( PG_NARGS() > 3 && ! PG_ARGISNULL(3) )
+			use_spheroid = PG_GETARG_BOOL(3);
+
+		if ( tolerance < 0 )
+			elog(ERROR, "Tolerance cannot be less than zero\n");
+
+		g1 = geography_array_elements(array1, &n1, &nvalues1, &srid, &gotsrid);
+		g2 = geography_array_elements(array2, &n2, &nvalues2, &srid, &gotsrid);
+
+		state = palloc0(sizeof(DWithinPairsState));
+
+		/* Nothing to pair up, and maybe no SRID to pick a spheroid from */
+		if ( nvalues1 && nvalues2 )
+		{
+			/* Initialize spheroid */
+			spheroid_init_from_srid(srid, &s);
+
+			/* Set to sphere if requested */
+			if ( ! use_spheroid )
+				s.a = s.b = s.radius;
+
+			state->num_pairs = geography_tree_dwithin_pairs(g1, n1, g2, n2, &s, tolerance, &(state->pairs));
+		}
+		funcctx->user_fctx = state;
+
+		/* get tuple description for return type */
+		if (get_call_result_type(fcinfo, 0, &funcctx->tuple_desc) != TYPEFUNC_COMPOSITE)
+		{
+			ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				errmsg("set-valued function called in context that cannot accept a set")));
+		}
+		BlessTupleDesc(funcctx->tuple_desc);
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	/* stuff done on every call of the function */
+	funcctx = SRF_PERCALL_SETUP();
+	state = funcctx->user_fctx;
+
+	if (state->next >= state->num_pairs)
+		SRF_RETURN_DONE(funcctx);
+
+	values[0] = Int32GetDatum(state->pairs[2 * state->next] + 1);
+	values[1] = Int32GetDatum(state->pairs[2 * state->next + 1] + 1);
+	state->next++;
+
+	tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+	SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+}
+
 
 
 /*
@@ -290,14 +290,43 @@ geography_tree_distance(const GSERIALIZED* g1, const GSERIALIZED* g2, const SPHE
 	CIRC_NODE* circ_tree2 = NULL;
 	LWGEOM* lwgeom1 = NULL;
 	LWGEOM* lwgeom2 = NULL;
-	POINT4D pt1, pt2;
+	int rv;
 
 	lwgeom1 = lwgeom_from_gserialized(g1);
 	lwgeom2 = lwgeom_from_gserialized(g2);
 	circ_tree1 = lwgeom_calculate_circ_tree(lwgeom1);
 	circ_tree2 = lwgeom_calculate_circ_tree(lwgeom2);
-	lwgeom_startpoint(lwgeom1, &pt1);
-	lwgeom_startpoint(lwgeom2, &pt2);
+
+	rv = geography_tree_distance_trees(g1, circ_tree1, g2, circ_tree2, s, tolerance, distance);
+
+	circ_tree_free(circ_tree1);
+	circ_tree_free(circ_tree2);
+	lwgeom_free(lwgeom1);
+	lwgeom_free(lwgeom2);
+	return rv;
+}
+
+/**
+* Tree/tree distance for callers that already hold both trees, for
+* example rebuilt from a stored ST_CircTree() value. Only the type and
+* box of the serialized inputs are read, the geometries are not parsed.
+*/
+int
+geography_tree_distance_trees(const GSERIALIZED* g1, const CIRC_NODE* circ_tree1,
+                              const GSERIALIZED* g2, const CIRC_NODE* circ_tree2,
+                              const SPHEROID* s, double tolerance, double* distance)
+{
+	POINT2D p2d;
+	POINT4D pt1, pt2;
+
+	circ_tree_get_point(circ_tree1, &p2d);
+	pt1.x = p2d.x;
+	pt1.y = p2d.y;
+	pt1.z = pt1.m = 0.0;
+	circ_tree_get_point(circ_tree2, &p2d);
+	pt2.x = p2d.x;
+	pt2.y = p2d.y;
+	pt2.z = pt2.m = 0.0;
 
 	if ( CircTreePIP(circ_tree1, g1, &pt2) || CircTreePIP(circ_tree2, g2, &pt1) )
 	{
@@ -308,10 +337,143 @@ geography_tree_distance(const GSERIALIZED* g1, const GSERIALIZED* g2, const SPHE
 		/* Calculate tree/tree distance */
 		*distance = circ_tree_distance_tree(circ_tree1, circ_tree2, s, tolerance);
 	}
-
-	circ_tree_free(circ_tree1);
-	circ_tree_free(circ_tree2);
-	lwgeom_free(lwgeom1);
-	lwgeom_free(lwgeom2);
 	return LW_SUCCESS;
 }
+
+/*
+* One member of an input set of geography_tree_dwithin_pairs, with its tree
+* built once up front.
+*/
+typedef struct {
+	const GSERIALIZED *g;
+	LWGEOM *lwgeom;
+	CIRC_NODE *tree;
+	uint32_t idx;
+} GeogTreeItem;
+
+static int
+geog_tree_item_cmp(const void *a, const void *b)
+{
+	double lat_a = ((const GeogTreeItem*)a)->tree->center.lat;
+	double lat_b = ((const GeogTreeItem*)b)->tree->center.lat;
+	return lat_a < lat_b ? -1 : (lat_a > lat_b ? 1 : 0);
+}
+
+static uint32_t
+geog_tree_items_build(const GSERIALIZED **g, uint32_t n, GeogTreeItem *items)
+{
+	uint32_t i, j = 0;
+	for ( i = 0; i < n; i++ )
+	{
+		if ( ! g[i] || gserialized_is_empty(g[i]) )
+			continue;
+		items[j].g = g[i];
+		items[j].lwgeom = lwgeom_from_gserialized(g[i]);
+		items[j].tree = lwgeom_calculate_circ_tree(items[j].lwgeom);
+		if ( ! items[j].tree )
+		{
+			lwgeom_free(items[j].lwgeom);
+			continue;
+		}
+		items[j].idx = i;
+		j++;
+	}
+	return j;
+}
+
+static void
+geog_tree_items_free(GeogTreeItem *items, uint32_t n)
+{
+	uint32_t i;
+	for ( i = 0; i < n; i++ )
+	{
+		circ_tree_free(items[i].tree);
+		lwgeom_free(items[i].lwgeom);
+	}
+	pfree(items);
+}
+
+/*
+* Sphere and spheroid distances differ by well under this factor, so
+* root circles further apart than tolerance times this cannot match.
+*/
+#define DWITHIN_PAIRS_MARGIN 1.01
+
+/**
+* Find every pair of members of g1 and g2 that are within tolerance of
+* each other. Each tree is built once for the whole call instead of once
+* per pair. Candidates come from a sweep over the latitudes of the root
+* circles of g2, then a root circle test, and only the survivors run the
+* tree distance. NULL and empty members never match.
+* Returns the number of pairs, with *pairs holding the zero based
+* (g1, g2) index of each pair one after the other.
+*/
+uint32_t
+geography_tree_dwithin_pairs(const GSERIALIZED **g1, uint32_t n1,
+                             const GSERIALIZED **g2, uint32_t n2,
+                             const SPHEROID *s, double tolerance, uint32_t **pairs)
+{
+	GeogTreeItem *items1 = palloc(sizeof(GeogTreeItem) * (n1 ? n1 : 1));
+	GeogTreeItem *items2 = palloc(sizeof(GeogTreeItem) * (n2 ? n2 : 1));
+	uint32_t num_pairs = 0, max_pairs = 64;
+	uint32_t i, j;
+	double tol_radians = DWITHIN_PAIRS_MARGIN * tolerance / s->radius;
+	double max_radius2 = 0.0;
+
+	*pairs = palloc(sizeof(uint32_t) * 2 * max_pairs);
+
+	n1 = geog_tree_items_build(g1, n1, items1);
+	n2 = geog_tree_items_build(g2, n2, items2);
+
+	/* Sort the second set on the latitude of its root circles */
+	qsort(items2, n2, sizeof(GeogTreeItem), geog_tree_item_cmp);
+	for ( j = 0; j < n2; j++ )
+		max_radius2 = FP_MAX(max_radius2, items2[j].tree->radius);
+
+	for ( i = 0; i < n1; i++ )
+	{
+		const CIRC_NODE *t1 = items1[i].tree;
+		/* A latitude difference is never more than the distance */
+		double reach = t1->radius + max_radius2 + tol_radians;
+		double lat_min = t1->center.lat - reach;
+		double lat_max = t1->center.lat + reach;
+		uint32_t lo = 0, hi = n2;
+
+		/* First candidate at or above lat_min */
+		while ( lo < hi )
+		{
+			uint32_t mid = lo + (hi - lo) / 2;
+			if ( items2[mid].tree->center.lat < lat_min )
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+
+		for ( j = lo; j < n2 && items2[j].tree->center.lat <= lat_max; j++ )
+		{
+			const CIRC_NODE *t2 = items2[j].tree;
+			double distance;
+
+			/* Root circles too far apart? */
+			if ( sphere_distance(&(t1->center), &(t2->center)) - t1->radius - t2->radius > tol_radians )
+				continue;
+
+			geography_tree_distance_trees(items1[i].g, t1, items2[j].g, t2, s, tolerance, &distance);
+			if ( distance > tolerance + FP_TOLERANCE )
+				continue;
+
+			if ( num_pairs == max_pairs )
+			{
+				max_pairs *= 2;
+				*pairs = repalloc(*pairs, sizeof(uint32_t) * 2 * max_pairs);
+			}
+			(*pairs)[2 * num_pairs] = items1[i].idx;
+			(*pairs)[2 * num_pairs + 1] = items2[j].idx;
+			num_pairs++;
+		}
+	}
+
+	geog_tree_items_free(items1, n1);
+	geog_tree_items_free(items2, n2);
+	return num_pairs;
+}
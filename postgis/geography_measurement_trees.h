@@ -38,3 +38,9 @@ int geography_distance_cache(FunctionCallInfo fcinfo,
 			     const SPHEROID *s,
 			     double *distance);
 int geography_tree_distance(const GSERIALIZED* g1, const GSERIALIZED* g2, const SPHEROID* s, double tolerance, double* distance);
+int geography_tree_distance_trees(const GSERIALIZED* g1, const CIRC_NODE* circ_tree1,
+                                  const GSERIALIZED* g2, const CIRC_NODE* circ_tree2,
+                                  const SPHEROID* s, double tolerance, double* distance);
+uint32_t geography_tree_dwithin_pairs(const GSERIALIZED **g1, uint32_t n1,
+                                      const GSERIALIZED **g2, uint32_t n2,
+                                      const SPHEROID *s, double tolerance, uint32_t **pairs);
@@ -116,6 +116,7 @@ Datum ST_CollectionExtract(PG_FUNCTION_ARGS);
 Datum ST_CollectionHomogenize(PG_FUNCTION_ARGS);
 Datum ST_IsCollection(PG_FUNCTION_ARGS);
 Datum ST_QuantizeCoordinates(PG_FUNCTION_ARGS);
+Datum ST_CompactStorage(PG_FUNCTION_ARGS);
 Datum ST_WrapX(PG_FUNCTION_ARGS);
 Datum ST_Scroll(PG_FUNCTION_ARGS);
 Datum LWGEOM_FilterByM(PG_FUNCTION_ARGS);
@@ -3220,6 +3221,50 @@ Datum ST_QuantizeCoordinates(PG_FUNCTION_ARGS)
 	PG_RETURN_POINTER(result);
 }
 
+/*
+ * ST_CompactStorage(g geometry, prec_xy int, prec_z int, prec_m int)
+ * Returns g snapped to a decimal grid and serialized with integer
+ * delta encoded ordinates, which any function reads transparently.
+ */
+PG_FUNCTION_INFO_V1(ST_CompactStorage);
+Datum ST_CompactStorage(PG_FUNCTION_ARGS)
+{
+	GSERIALIZED *input;
+	GSERIALIZED *result;
+	LWGEOM *g;
+	size_t size;
+	int32_t prec_xy;
+	int32_t prec_z;
+	int32_t prec_m;
+
+	if (PG_ARGISNULL(0))
+		PG_RETURN_NULL();
+	if (PG_ARGISNULL(1))
+	{
+		lwpgerror("Must specify precision");
+		PG_RETURN_NULL();
+	}
+	prec_xy = PG_GETARG_INT32(1);
+	prec_z = PG_ARGISNULL(2) ? prec_xy : PG_GETARG_INT32(2);
+	prec_m = PG_ARGISNULL(3) ? prec_xy : PG_GETARG_INT32(3);
+
+	if (prec_xy < -7 || prec_xy > 15 || prec_z < -7 || prec_z > 15 || prec_m < -7 || prec_m > 15)
+	{
+		lwpgerror("Precision must be between -7 and 15");
+		PG_RETURN_NULL();
+	}
+
+	input = PG_GETARG_GSERIALIZED_P(0);
+	g = lwgeom_from_gserialized(input);
+
+	result = gserialized_from_lwgeom_quantized(g, prec_xy, prec_z, prec_m, &size);
+	SET_VARSIZE(result, size);
+
+	lwgeom_free(g);
+	PG_FREE_IF_COPY(input, 0);
+	PG_RETURN_POINTER(result);
+}
+
 /*
  * ST_FilterByM(in geometry, val double precision)
  */
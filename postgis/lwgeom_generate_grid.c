@@ -30,6 +30,7 @@
 #include "../postgis_config.h"
 #include "lwgeom_pg.h"
 #include "liblwgeom.h"
+#include "lwtree.h"
 
 #include <math.h>
 #include <float.h>
@@ -40,6 +41,7 @@
 Datum ST_Hexagon(PG_FUNCTION_ARGS);
 Datum ST_Square(PG_FUNCTION_ARGS);
 Datum ST_ShapeGrid(PG_FUNCTION_ARGS);
+Datum ST_TileCover(PG_FUNCTION_ARGS);
 
 /* ********* ********* ********* ********* ********* ********* ********* ********* */
 
@@ -416,3 +418,296 @@ Datum ST_Square(PG_FUNCTION_ARGS)
 	PG_FREE_IF_COPY(gorigin, 3);
 	PG_RETURN_POINTER(gsqr);
 }
+
+/* ********* ********* ********* ********* ********* ********* ********* ********* */
+
+typedef struct
+{
+	int32_t zoom, x, y;
+}
+TileCoverTile;
+
+/*
+* Walks the tile quadtree depth-first from the tiles of zoom_min
+* that touch the geometry bounds, only descending into tiles that
+* actually interact with the geometry.
+*/
+typedef struct TileCoverState
+{
+	LWGEOM *geom;
+	RECT_NODE *tree;
+	GBOX gbox;
+	GBOX bounds;
+	/* margin of the returned tiles, and of the walk which is never negative */
+	double margin, walk_margin;
+	int32_t srid;
+	int32_t zoom_min, zoom_max;
+	/* range of tiles touching the geometry bounds, per zoom level */
+	int32_t *x_min, *x_max, *y_min, *y_max;
+	/* next tile of zoom_min to visit */
+	int32_t x, y;
+	bool top_done;
+	/* pending tiles of the depth-first walk */
+	TileCoverTile *stack;
+	uint32_t nstack;
+}
+TileCoverState;
+
+static void
+tile_cover_bbox(const TileCoverState *state, const TileCoverTile *t, double margin, GBOX *box)
+{
+	uint32_t world = 0x01u << t->zoom;
+	double tile_x = (state->bounds.xmax - state->bounds.xmin) / world;
+	double tile_y = (state->bounds.ymax - state->bounds.ymin) / world;
+
+	box->flags = 0;
+	box->xmin = state->bounds.xmin + tile_x * (t->x - margin);
+	box->xmax = state->bounds.xmin + tile_x * (t->x + 1 + margin);
+	box->ymin = state->bounds.ymax - tile_y * (t->y + 1 + margin);
+	box->ymax = state->bounds.ymax - tile_y * (t->y - margin);
+}
+
+static bool
+tile_cover_intersects(const TileCoverState *state, const TileCoverTile *t, double margin)
+{
+	GBOX box;
+	LWGEOM *tile;
+	RECT_NODE *tile_tree;
+	int rv;
+
+	tile_cover_bbox(state, t, margin, &box);
+
+	/* Tile holds the whole geometry? */
+	if (gbox_contains_2d(&box, &(state->gbox)))
+		return true;
+
+	/* Points are covered by the walk ranges already */
+	if (state->geom->type == POINTTYPE && margin == state->walk_margin)
+		return true;
+
+	tile = lwpoly_as_lwgeom(lwpoly_construct_envelope(state->srid, box.xmin, box.ymin, box.xmax, box.ymax));
+	tile_tree = rect_tree_from_lwgeom(tile);
+	rv = rect_tree_intersects_tree(state->tree, tile_tree);
+	rect_tree_free(tile_tree);
+	lwgeom_free(tile);
+	return rv;
+}
+
+static int32_t
+tile_cover_clamp(double tile, uint32_t world)
+{
+	if (tile < 0)
+		return 0;
+	if (tile > world - 1)
+		return (int32_t)(world - 1);
+	return (int32_t)tile;
+}
+
+static TileCoverState *
+tile_cover_state(LWGEOM *geom, const GBOX *bounds, double margin, int32_t zoom_min, int32_t zoom_max)
+{
+	TileCoverState *state = palloc0(sizeof(TileCoverState));
+	uint32_t nzooms = zoom_max - zoom_min + 1;
+	int32_t z;
+
+	state->geom = geom;
+	state->tree = rect_tree_from_lwgeom(geom);
+	lwgeom_calculate_gbox(geom, &(state->gbox));
+	state->bounds = *bounds;
+	state->margin = margin;
+	/* A shrunken tile does not cover its children, so walk unshrunken ones */
+	state->walk_margin = margin > 0 ? margin : 0;
+	margin = state->walk_margin;
+	state->srid = geom->srid;
+	state->zoom_min = zoom_min;
+	state->zoom_max = zoom_max;
+
+	state->x_min = palloc(sizeof(int32_t) * nzooms);
+	state->x_max = palloc(sizeof(int32_t) * nzooms);
+	state->y_min = palloc(sizeof(int32_t) * nzooms);
+	state->y_max = palloc(sizeof(int32_t) * nzooms);
+
+	/*
+	* Tiles are closed boxes grown by the margin, so tile x touches
+	* the geometry bounds when x - margin <= gxmax and
+	* x + 1 + margin >= gxmin, in tile units. Same for y, which
+	* counts down from the top of the bounds.
+	*/
+	for (z = zoom_min; z <= zoom_max; z++)
+	{
+		uint32_t world = 0x01u << z;
+		double tile_x = (bounds->xmax - bounds->xmin) / world;
+		double tile_y = (bounds->ymax - bounds->ymin) / world;
+		double x1 = ceil((state->gbox.xmin - bounds->xmin) / tile_x - 1 - margin);
+		double x2 = floor((state->gbox.xmax - bounds->xmin) / tile_x + margin);
+		double y1 = ceil((bounds->ymax - state->gbox.ymax) / tile_y - 1 - margin);
+		double y2 = floor((bounds->ymax - state->gbox.ymin) / tile_y + margin);
+		uint32_t i = z - zoom_min;
+
+		state->x_min[i] = tile_cover_clamp(x1, world);
+		state->x_max[i] = tile_cover_clamp(x2, world);
+		state->y_min[i] = tile_cover_clamp(y1, world);
+		state->y_max[i] = tile_cover_clamp(y2, world);
+		/* Empty range when the geometry misses the bounds on one side */
+		if (x1 > world - 1 || x2 < 0 || y1 > world - 1 || y2 < 0)
+		{
+			state->x_min[i] = state->y_min[i] = 1;
+			state->x_max[i] = state->y_max[i] = 0;
+		}
+	}
+
+	/* Geometry entirely outside the bounds */
+	if (state->x_min[0] > state->x_max[0] || state->y_min[0] > state->y_max[0])
+		state->top_done = true;
+
+	state->x = state->x_min[0];
+	state->y = state->y_min[0];
+
+	/* Each level of the walk leaves at most three siblings pending */
+	state->stack = palloc(sizeof(TileCoverTile) * (4 + 3 * nzooms));
+	state->nstack = 0;
+	return state;
+}
+
+static bool
+tile_cover_next(TileCoverState *state, TileCoverTile *out)
+{
+	while (true)
+	{
+		TileCoverTile t;
+
+		if (state->nstack > 0)
+		{
+			t = state->stack[--state->nstack];
+		}
+		else if (!state->top_done)
+		{
+			t.zoom = state->zoom_min;
+			t.x = state->x;
+			t.y = state->y;
+			if (++state->x > state->x_max[0])
+			{
+				state->x = state->x_min[0];
+				if (++state->y > state->y_max[0])
+					state->top_done = true;
+			}
+		}
+		else
+		{
+			return false;
+		}
+
+		if (!tile_cover_intersects(state, &t, state->walk_margin))
+			continue;
+
+		/* Push the children within the bounds range, last one first */
+		if (t.zoom < state->zoom_max)
+		{
+			uint32_t i = t.zoom + 1 - state->zoom_min;
+			int32_t cx, cy;
+			for (cy = 2 * t.y + 1; cy >= 2 * t.y; cy--)
+			{
+				if (cy < state->y_min[i] || cy > state->y_max[i])
+					continue;
+				for (cx = 2 * t.x + 1; cx >= 2 * t.x; cx--)
+				{
+					if (cx < state->x_min[i] || cx > state->x_max[i])
+						continue;
+					state->stack[state->nstack].zoom = t.zoom + 1;
+					state->stack[state->nstack].x = cx;
+					state->stack[state->nstack].y = cy;
+					state->nstack++;
+				}
+			}
+		}
+
+		if (state->margin < 0 && !tile_cover_intersects(state, &t, state->margin))
+			continue;
+
+		*out = t;
+		return true;
+	}
+}
+
+/**
+* ST_TileCover(geom geometry, zoom_min integer, zoom_max integer,
+*              bounds geometry, margin float8)
+* Returns the (zoom, x, y) of every tile between the two zoom levels
+* that interacts with the geometry, the tiles being grown by the margin
+* as in ST_TileEnvelope.
+*/
+PG_FUNCTION_INFO_V1(ST_TileCover);
+Datum ST_TileCover(PG_FUNCTION_ARGS)
+{
+	FuncCallContext *funcctx;
+	TileCoverState *state;
+	TileCoverTile tile;
+	bool isnull[3] = {0,0,0};
+	Datum tuple_arr[3];
+	HeapTuple tuple;
+
+	if (SRF_IS_FIRSTCALL())
+	{
+		MemoryContext oldcontext;
+		GSERIALIZED *gser, *gbounds;
+		LWGEOM *geom, *lwbounds;
+		GBOX bounds;
+		int32_t zoom_min = PG_GETARG_INT32(1);
+		int32_t zoom_max = PG_GETARG_INT32(2);
+		double margin = PG_GETARG_FLOAT8(4);
+
+		funcctx = SRF_FIRSTCALL_INIT();
+		oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		gser = PG_GETARG_GSERIALIZED_P(0);
+		gbounds = PG_GETARG_GSERIALIZED_P(3);
+		gserialized_error_if_srid_mismatch(gser, gbounds, __func__);
+
+		if (zoom_min < 0 || zoom_max >= 32 || zoom_min > zoom_max)
+			elog(ERROR, "%s: Invalid tile zoom range, %d to %d", __func__, zoom_min, zoom_max);
+		if (margin < -0.5)
+			elog(ERROR, "%s: Margin must not be less than -50%%, margin=%f", __func__, margin);
+
+		/* Full precision bounds, as in ST_TileEnvelope */
+		lwbounds = lwgeom_from_gserialized(gbounds);
+		if (lwgeom_calculate_gbox(lwbounds, &bounds) != LW_SUCCESS)
+			elog(ERROR, "%s: Unable to compute bbox", __func__);
+		lwgeom_free(lwbounds);
+		if (bounds.xmax - bounds.xmin <= 0 || bounds.ymax - bounds.ymin <= 0)
+			elog(ERROR, "%s: Geometric bounds are too small", __func__);
+
+		geom = lwgeom_from_gserialized(gser);
+		if (lwgeom_is_empty(geom))
+		{
+			MemoryContextSwitchTo(oldcontext);
+			funcctx = SRF_PERCALL_SETUP();
+			SRF_RETURN_DONE(funcctx);
+		}
+
+		funcctx->user_fctx = tile_cover_state(geom, &bounds, margin, zoom_min, zoom_max);
+
+		/* get tuple description for return type */
+		if (get_call_result_type(fcinfo, 0, &funcctx->tuple_desc) != TYPEFUNC_COMPOSITE)
+		{
+			ereport(ERROR, (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				errmsg("set-valued function called in context that cannot accept a set")));
+		}
+
+		BlessTupleDesc(funcctx->tuple_desc);
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	/* stuff done on every call of the function */
+	funcctx = SRF_PERCALL_SETUP();
+	state = funcctx->user_fctx;
+
+	if (!tile_cover_next(state, &tile))
+		SRF_RETURN_DONE(funcctx);
+
+	tuple_arr[0] = Int32GetDatum(tile.zoom);
+	tuple_arr[1] = Int32GetDatum(tile.x);
+	tuple_arr[2] = Int32GetDatum(tile.y);
+
+	tuple = heap_form_tuple(funcctx->tuple_desc, tuple_arr, isnull);
+	SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+}
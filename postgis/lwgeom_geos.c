@@ -108,6 +108,9 @@ Datum ST_MaximumInscribedCircle(PG_FUNCTION_ARGS);
 
 Datum pgis_union_geometry_array(PG_FUNCTION_ARGS);
 Datum pgis_geometry_union_finalfn(PG_FUNCTION_ARGS);
+Datum pgis_geometry_union_serialfn(PG_FUNCTION_ARGS);
+Datum pgis_geometry_union_deserialfn(PG_FUNCTION_ARGS);
+Datum pgis_geometry_union_combinefn(PG_FUNCTION_ARGS);
 
 /*
 ** Prototypes end
@@ -635,23 +638,22 @@ Datum pgis_union_geometry_array(PG_FUNCTION_ARGS)
 }
 
 
-PG_FUNCTION_INFO_V1(pgis_geometry_union_finalfn);
-Datum pgis_geometry_union_finalfn(PG_FUNCTION_ARGS)
+/*
+* Union the geometries collected in an aggregate state. Returns NULL
+* when only NULL geometries were collected, and an empty of the largest
+* type seen when only empties were.
+*/
+static LWGEOM *
+pgis_union_state_lwgeom(CollectionBuildState *state)
 {
-	CollectionBuildState *state;
 	ListCell *l;
 	LWGEOM **geoms;
-	GSERIALIZED *gser_out;
 	size_t ngeoms = 0;
 	int empty_type = 0;
 	bool first = true;
 	int32_t srid = SRID_UNKNOWN;
 	int has_z = LW_FALSE;
 
-	if (PG_ARGISNULL(0))
-		PG_RETURN_NULL(); /* returns null iff no input values */
-
-	state = (CollectionBuildState *)PG_GETARG_POINTER(0);
 	geoms = palloc(list_length(state->geoms) * sizeof(LWGEOM*));
 
 	/* Read contents of list into an array of only non-null values */
@@ -691,28 +693,138 @@ Datum pgis_geometry_union_finalfn(PG_FUNCTION_ARGS)
 		{
 			lwcollection_free(col);
 		}
-		gser_out = geometry_serialize(out);
+		return out;
 	}
-	/* No real geometries in our array, any empties? */
-	else
-	{
-		/* If it was only empties, we'll return the largest type number */
-		if (empty_type > 0)
-			PG_RETURN_POINTER(
-			    geometry_serialize(lwgeom_construct_empty(empty_type, srid, has_z, 0)));
 
-		/* Nothing but NULL, returns NULL */
-		else
-			PG_RETURN_NULL();
-	}
+	/* If it was only empties, we'll return the largest type number */
+	if (empty_type > 0)
+		return lwgeom_construct_empty(empty_type, srid, has_z, 0);
+
+	/* Nothing but NULL, returns NULL */
+	return NULL;
+}
+
+PG_FUNCTION_INFO_V1(pgis_geometry_union_finalfn);
+Datum pgis_geometry_union_finalfn(PG_FUNCTION_ARGS)
+{
+	CollectionBuildState *state;
+	LWGEOM *out;
 
-	if (!gser_out)
+	if (PG_ARGISNULL(0))
+		PG_RETURN_NULL(); /* returns null iff no input values */
+
+	state = (CollectionBuildState *)PG_GETARG_POINTER(0);
+	out = pgis_union_state_lwgeom(state);
+
+	if (!out)
 	{
 		/* Union returned a NULL geometry */
 		PG_RETURN_NULL();
 	}
 
-	PG_RETURN_POINTER(gser_out);
+	PG_RETURN_POINTER(geometry_serialize(out));
+}
+
+/*
+* Parallel ST_Union. Each worker unions its own share of the rows
+* before handing it over, so the leader only has to merge one
+* partial union per worker in the final function. The serialized
+* state is the grid size followed by the partial union, if any.
+* Workers are processes, not threads, because a GEOS error during
+* the union is reported through lwgeom_geos_error and ereport, which
+* longjmps to the backend's error handler and cannot leave a thread.
+*/
+PG_FUNCTION_INFO_V1(pgis_geometry_union_serialfn);
+Datum pgis_geometry_union_serialfn(PG_FUNCTION_ARGS)
+{
+	CollectionBuildState *state;
+	GSERIALIZED *gser = NULL;
+	LWGEOM *out;
+	size_t size = VARHDRSZ + sizeof(float8);
+	bytea *result;
+
+	if (!AggCheckCallContext(fcinfo, NULL))
+		elog(ERROR, "%s called in non-aggregate context", __func__);
+
+	if (PG_ARGISNULL(0))
+		PG_RETURN_NULL();
+
+	state = (CollectionBuildState *)PG_GETARG_POINTER(0);
+	out = pgis_union_state_lwgeom(state);
+	if (out)
+	{
+		gser = geometry_serialize(out);
+		size += VARSIZE(gser);
+	}
+
+	result = palloc(size);
+	SET_VARSIZE(result, size);
+	memcpy(VARDATA(result), &(state->gridSize), sizeof(float8));
+	if (gser)
+		memcpy(VARDATA(result) + sizeof(float8), gser, VARSIZE(gser));
+
+	PG_RETURN_BYTEA_P(result);
+}
+
+PG_FUNCTION_INFO_V1(pgis_geometry_union_deserialfn);
+Datum pgis_geometry_union_deserialfn(PG_FUNCTION_ARGS)
+{
+	MemoryContext aggcontext, oldcontext;
+	CollectionBuildState *state;
+	bytea *serialized;
+	size_t gser_size;
+
+	if (!AggCheckCallContext(fcinfo, &aggcontext))
+		elog(ERROR, "%s called in non-aggregate context", __func__);
+
+	if (PG_ARGISNULL(0))
+		PG_RETURN_NULL();
+
+	serialized = PG_GETARG_BYTEA_P(0);
+	gser_size = VARSIZE(serialized) - VARHDRSZ - sizeof(float8);
+
+	oldcontext = MemoryContextSwitchTo(aggcontext);
+	state = palloc0(sizeof(CollectionBuildState));
+	state->geomOid = postgis_oid(GEOMETRYOID);
+	memcpy(&(state->gridSize), VARDATA(serialized), sizeof(float8));
+	if (gser_size > 0)
+	{
+		/* Copy out of the bytea so the coordinates are aligned */
+		GSERIALIZED *gser = palloc(gser_size);
+		memcpy(gser, VARDATA(serialized) + sizeof(float8), gser_size);
+		state->geoms = list_make1(lwgeom_from_gserialized(gser));
+	}
+	MemoryContextSwitchTo(oldcontext);
+
+	PG_RETURN_POINTER(state);
+}
+
+PG_FUNCTION_INFO_V1(pgis_geometry_union_combinefn);
+Datum pgis_geometry_union_combinefn(PG_FUNCTION_ARGS)
+{
+	MemoryContext aggcontext, oldcontext;
+	CollectionBuildState *state1, *state2;
+
+	if (!AggCheckCallContext(fcinfo, &aggcontext))
+		elog(ERROR, "%s called in non-aggregate context", __func__);
+
+	state1 = PG_ARGISNULL(0) ? NULL : (CollectionBuildState *)PG_GETARG_POINTER(0);
+	state2 = PG_ARGISNULL(1) ? NULL : (CollectionBuildState *)PG_GETARG_POINTER(1);
+
+	if (!state1 && !state2)
+		PG_RETURN_NULL();
+	if (!state2)
+		PG_RETURN_POINTER(state1);
+	if (!state1)
+		PG_RETURN_POINTER(state2);
+
+	oldcontext = MemoryContextSwitchTo(aggcontext);
+	state1->geoms = list_concat(state1->geoms, state2->geoms);
+	MemoryContextSwitchTo(oldcontext);
+	if (state2->gridSize > state1->gridSize)
+		state1->gridSize = state2->gridSize;
+
+	PG_RETURN_POINTER(state1);
 }
 
 
@@ -778,15 +890,59 @@ Datum ST_Union(PG_FUNCTION_ARGS)
 	PG_RETURN_POINTER(result);
 }
 
+/*
+* Run a two-argument GEOS overlay, reusing the GEOS conversion held
+* in the prepared geometry cache when one of the arguments repeats
+* from row to row (e.g. ST_Intersection(t.geom, 'POLYGON(...)')).
+*/
+typedef LWGEOM* (*overlay_geos_func)(const LWGEOM*, const GEOSGeometry*, const LWGEOM*, const GEOSGeometry*, double);
+
+static Datum
+overlay_cached(FunctionCallInfo fcinfo, overlay_geos_func overlay)
+{
+	SHARED_GSERIALIZED *shared_geom1 = ToastCacheGetGeometry(fcinfo, 0);
+	SHARED_GSERIALIZED *shared_geom2 = ToastCacheGetGeometry(fcinfo, 1);
+	const GSERIALIZED *geom1 = shared_gserialized_get(shared_geom1);
+	const GSERIALIZED *geom2 = shared_gserialized_get(shared_geom2);
+	const GEOSGeometry *g1 = NULL, *g2 = NULL;
+	PrepGeomCache *prep_cache;
+	GSERIALIZED *result;
+	LWGEOM *lwgeom1, *lwgeom2, *lwresult;
+	double prec = -1;
+
+	if (PG_NARGS() > 2 && ! PG_ARGISNULL(2))
+		prec = PG_GETARG_FLOAT8(2);
+
+	initGEOS(lwpgnotice, lwgeom_geos_error);
+
+	prep_cache = GetPrepGeomCache(fcinfo, shared_geom1, shared_geom2);
+	if (prep_cache && prep_cache->geom)
+	{
+		if (prep_cache->gcache.argnum == 1)
+			g1 = prep_cache->geom;
+		else
+			g2 = prep_cache->geom;
+	}
+
+	lwgeom1 = lwgeom_from_gserialized(geom1);
+	lwgeom2 = lwgeom_from_gserialized(geom2);
+
+	lwresult = overlay(lwgeom1, g1, lwgeom2, g2, prec);
+	result = geometry_serialize(lwresult);
+
+	lwgeom_free(lwgeom1);
+	lwgeom_free(lwgeom2);
+	lwgeom_free(lwresult);
+
+	PG_RETURN_POINTER(result);
+}
+
 /* This is retained for backward ABI compatibility
  * with PostGIS < 3.1.0 */
 PG_FUNCTION_INFO_V1(symdifference);
 Datum symdifference(PG_FUNCTION_ARGS)
 {
-  PG_RETURN_DATUM(DirectFunctionCall2(
-     ST_SymDifference,
-     PG_GETARG_DATUM(0), PG_GETARG_DATUM(1)
-  ));
+	return overlay_cached(fcinfo, lwgeom_symdifference_prec_geos);
 }
 
 /**
@@ -797,31 +953,7 @@ Datum symdifference(PG_FUNCTION_ARGS)
 PG_FUNCTION_INFO_V1(ST_SymDifference);
 Datum ST_SymDifference(PG_FUNCTION_ARGS)
 {
-	GSERIALIZED *geom1;
-	GSERIALIZED *geom2;
-	GSERIALIZED *result;
-	LWGEOM *lwgeom1, *lwgeom2, *lwresult ;
-	double prec = -1;
-
-	geom1 = PG_GETARG_GSERIALIZED_P(0);
-	geom2 = PG_GETARG_GSERIALIZED_P(1);
-	if (PG_NARGS() > 2 && ! PG_ARGISNULL(2))
-		prec = PG_GETARG_FLOAT8(2);
-
-	lwgeom1 = lwgeom_from_gserialized(geom1) ;
-	lwgeom2 = lwgeom_from_gserialized(geom2) ;
-
-	lwresult = lwgeom_symdifference_prec(lwgeom1, lwgeom2, prec);
-	result = geometry_serialize(lwresult) ;
-
-	lwgeom_free(lwgeom1) ;
-	lwgeom_free(lwgeom2) ;
-	lwgeom_free(lwresult) ;
-
-	PG_FREE_IF_COPY(geom1, 0);
-	PG_FREE_IF_COPY(geom2, 1);
-
-	PG_RETURN_POINTER(result);
+	return overlay_cached(fcinfo, lwgeom_symdifference_prec_geos);
 }
 
 PG_FUNCTION_INFO_V1(convexhull);
@@ -938,7 +1070,8 @@ PG_FUNCTION_INFO_V1(buffer);
 Datum buffer(PG_FUNCTION_ARGS)
 {
 	GEOSBufferParams *bufferparams;
-	GEOSGeometry *g1, *g3 = NULL;
+	const GEOSGeometry *g1;
+	GEOSGeometry *g1_owned = NULL, *g3 = NULL;
 	GSERIALIZED *result;
 	LWGEOM *lwg;
 	int quadsegs = 8; /* the default */
@@ -962,7 +1095,9 @@ Datum buffer(PG_FUNCTION_ARGS)
 	int endCapStyle = DEFAULT_ENDCAP_STYLE;
 	int joinStyle  = DEFAULT_JOIN_STYLE;
 
-	GSERIALIZED	*geom1 = PG_GETARG_GSERIALIZED_P(0);
+	SHARED_GSERIALIZED *shared_geom1 = ToastCacheGetGeometry(fcinfo, 0);
+	const GSERIALIZED *geom1 = shared_gserialized_get(shared_geom1);
+	PrepGeomCache *prep_cache;
 	double size = PG_GETARG_FLOAT8(1);
 	text *params_text;
 
@@ -986,9 +1121,18 @@ Datum buffer(PG_FUNCTION_ARGS)
 
 	initGEOS(lwpgnotice, lwgeom_geos_error);
 
-	g1 = POSTGIS2GEOS(geom1);
-	if (!g1)
-		HANDLE_GEOS_ERROR("First argument geometry could not be converted to GEOS");
+	/* Buffering one geometry by many distances converts it only once */
+	prep_cache = GetPrepGeomCache(fcinfo, shared_geom1, NULL);
+	if (prep_cache && prep_cache->geom)
+	{
+		g1 = prep_cache->geom;
+	}
+	else
+	{
+		g1 = g1_owned = POSTGIS2GEOS(geom1);
+		if (!g1)
+			HANDLE_GEOS_ERROR("First argument geometry could not be converted to GEOS");
+	}
 
 
 	if (VARSIZE_ANY_EXHDR(params_text) > 0)
@@ -1138,7 +1282,8 @@ Datum buffer(PG_FUNCTION_ARGS)
 		lwpgerror("Error setting buffer parameters.");
 	}
 
-	GEOSGeom_destroy(g1);
+	if (g1_owned)
+		GEOSGeom_destroy(g1_owned);
 
 	if (!g3) HANDLE_GEOS_ERROR("GEOSBuffer");
 
@@ -1155,7 +1300,6 @@ Datum buffer(PG_FUNCTION_ARGS)
 		PG_RETURN_NULL(); /* never get here */
 	}
 
-	PG_FREE_IF_COPY(geom1, 0);
 	PG_RETURN_POINTER(result);
 }
 
@@ -1340,61 +1484,13 @@ Datum ST_OffsetCurve(PG_FUNCTION_ARGS)
 PG_FUNCTION_INFO_V1(ST_Intersection);
 Datum ST_Intersection(PG_FUNCTION_ARGS)
 {
-	GSERIALIZED *geom1;
-	GSERIALIZED *geom2;
-	GSERIALIZED *result;
-	LWGEOM *lwgeom1, *lwgeom2, *lwresult;
-	double prec = -1;
-
-	geom1 = PG_GETARG_GSERIALIZED_P(0);
-	geom2 = PG_GETARG_GSERIALIZED_P(1);
-	if (PG_NARGS() > 2 && ! PG_ARGISNULL(2))
-		prec = PG_GETARG_FLOAT8(2);
-
-	lwgeom1 = lwgeom_from_gserialized(geom1);
-	lwgeom2 = lwgeom_from_gserialized(geom2);
-
-	lwresult = lwgeom_intersection_prec(lwgeom1, lwgeom2, prec);
-	result = geometry_serialize(lwresult);
-
-	lwgeom_free(lwgeom1);
-	lwgeom_free(lwgeom2);
-	lwgeom_free(lwresult);
-
-	PG_FREE_IF_COPY(geom1, 0);
-	PG_FREE_IF_COPY(geom2, 1);
-
-	PG_RETURN_POINTER(result);
+	return overlay_cached(fcinfo, lwgeom_intersection_prec_geos);
 }
 
 PG_FUNCTION_INFO_V1(ST_Difference);
 Datum ST_Difference(PG_FUNCTION_ARGS)
 {
-	GSERIALIZED *geom1;
-	GSERIALIZED *geom2;
-	GSERIALIZED *result;
-	LWGEOM *lwgeom1, *lwgeom2, *lwresult;
-	double prec = -1;
-
-	geom1 = PG_GETARG_GSERIALIZED_P(0);
-	geom2 = PG_GETARG_GSERIALIZED_P(1);
-	if (PG_NARGS() > 2 && ! PG_ARGISNULL(2))
-		prec = PG_GETARG_FLOAT8(2);
-
-	lwgeom1 = lwgeom_from_gserialized(geom1);
-	lwgeom2 = lwgeom_from_gserialized(geom2);
-
-	lwresult = lwgeom_difference_prec(lwgeom1, lwgeom2, prec);
-	result = geometry_serialize(lwresult);
-
-	lwgeom_free(lwgeom1);
-	lwgeom_free(lwgeom2);
-	lwgeom_free(lwresult);
-
-	PG_FREE_IF_COPY(geom1, 0);
-	PG_FREE_IF_COPY(geom2, 1);
-
-	PG_RETURN_POINTER(result);
+	return overlay_cached(fcinfo, lwgeom_difference_prec_geos);
 }
 
 /**
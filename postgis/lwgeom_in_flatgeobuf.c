@@ -24,6 +24,12 @@
 
 
 #include <assert.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+#include <unistd.h>
 
 #include "postgres.h"
 
@@ -34,6 +40,11 @@
 #include "funcapi.h"
 #include <executor/spi.h>
 #include <utils/builtins.h>
+#include "miscadmin.h"
+#include "utils/acl.h"
+#if POSTGIS_PGSQL_VERSION >= 110
+#include "catalog/pg_authid.h"
+#endif
 #include "flatgeobuf.h"
 
 static char *get_pgtype(uint8_t column_type) {
@@ -154,13 +165,80 @@ Datum pgis_tablefromflatgeobuf(PG_FUNCTION_ARGS)
 	PG_RETURN_NULL();
 }
 
+/*
+ * Common first call setup of the FlatGeobuf set returning functions.
+ * Decodes the header of the buffer already attached to ctx and applies
+ * the optional box2d filter argument. Returns false when there are no
+ * features to return.
+ */
+static bool fromflatgeobuf_init(FunctionCallInfo fcinfo, struct flatgeobuf_decode_ctx *ctx, int bbox_argno)
+{
+	if (ctx->ctx->size == 0) {
+		POSTGIS_DEBUG(2, "no data");
+		return false;
+	}
+	if (ctx->ctx->size < FLATGEOBUF_MAGICBYTES_SIZE)
+		elog(ERROR, "Data is not FlatGeobuf");
+
+	flatgeobuf_check_magicbytes(ctx);
+	flatgeobuf_decode_header(ctx->ctx);
+
+	POSTGIS_DEBUGF(2, "header decoded now at offset %ld", ctx->ctx->offset);
+
+	if (ctx->ctx->size == ctx->ctx->offset) {
+		POSTGIS_DEBUGF(2, "no feature data offset %ld", ctx->ctx->offset);
+		return false;
+	}
+
+	if (PG_NARGS() > bbox_argno && !PG_ARGISNULL(bbox_argno))
+		flatgeobuf_decode_filter(ctx, (GBOX *)PG_GETARG_POINTER(bbox_argno));
+
+	// TODO: get table and verify structure against header
+	return true;
+}
+
+static struct flatgeobuf_decode_ctx *fromflatgeobuf_ctx(FunctionCallInfo fcinfo)
+{
+	TupleDesc tupdesc;
+	struct flatgeobuf_decode_ctx *ctx;
+
+	if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
+		ereport(ERROR,
+				(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+				 errmsg("function returning record called in context "
+						"that cannot accept type record")));
+
+	ctx = palloc0(sizeof(*ctx));
+	ctx->tupdesc = tupdesc;
+	ctx->ctx = palloc0(sizeof(flatgeobuf_ctx));
+	ctx->ctx->offset = 0;
+	ctx->done = false;
+	ctx->fid = 0;
+	return ctx;
+}
+
+static Datum fromflatgeobuf_next(FunctionCallInfo fcinfo, FuncCallContext *funcctx)
+{
+	struct flatgeobuf_decode_ctx *ctx = funcctx->user_fctx;
+
+	if (!ctx->done)
+		flatgeobuf_decode_row(ctx);
+
+	if (!ctx->done) {
+		POSTGIS_DEBUG(2, "Calling SRF_RETURN_NEXT");
+		SRF_RETURN_NEXT(funcctx, ctx->result);
+	} else {
+		POSTGIS_DEBUG(2, "Calling SRF_RETURN_DONE");
+		SRF_RETURN_DONE(funcctx);
+	}
+}
+
 // https://stackoverflow.com/questions/11740256/refactor-a-pl-pgsql-function-to-return-the-output-of-various-select-queries
 PG_FUNCTION_INFO_V1(pgis_fromflatgeobuf);
 Datum pgis_fromflatgeobuf(PG_FUNCTION_ARGS)
 {
 	FuncCallContext *funcctx;
 
-	TupleDesc tupdesc;
 	bytea *data;
 	MemoryContext oldcontext;
 
@@ -172,57 +250,139 @@ Datum pgis_fromflatgeobuf(PG_FUNCTION_ARGS)
 
 		funcctx->max_calls = 0;
 
-		if (get_call_result_type(fcinfo, NULL, &tupdesc) != TYPEFUNC_COMPOSITE)
-			ereport(ERROR,
-					(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
-					 errmsg("function returning record called in context "
-							"that cannot accept type record")));
-
 		data = PG_GETARG_BYTEA_PP(1);
 
-		ctx = palloc0(sizeof(*ctx));
-		ctx->tupdesc = tupdesc;
-		ctx->ctx = palloc0(sizeof(flatgeobuf_ctx));
+		ctx = fromflatgeobuf_ctx(fcinfo);
 		ctx->ctx->size = VARSIZE_ANY_EXHDR(data);
 		POSTGIS_DEBUGF(3, "VARSIZE_ANY_EXHDR %ld", ctx->ctx->size);
 		ctx->ctx->buf = palloc(ctx->ctx->size);
 		memcpy(ctx->ctx->buf, VARDATA_ANY(data), ctx->ctx->size);
-		ctx->ctx->offset = 0;
-		ctx->done = false;
-		ctx->fid = 0;
 
 		funcctx->user_fctx = ctx;
 
-		if (ctx->ctx->size == 0) {
-			POSTGIS_DEBUG(2, "no data");
+		if (!fromflatgeobuf_init(fcinfo, ctx, 2)) {
 			MemoryContextSwitchTo(oldcontext);
 			SRF_RETURN_DONE(funcctx);
 		}
 
-		flatgeobuf_check_magicbytes(ctx);
-		flatgeobuf_decode_header(ctx->ctx);
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	funcctx = SRF_PERCALL_SETUP();
+	return fromflatgeobuf_next(fcinfo, funcctx);
+}
+
+#ifndef _WIN32
+typedef struct
+{
+	void *addr;
+	size_t size;
+} flatgeobuf_mapping;
+
+static void flatgeobuf_unmap(void *arg)
+{
+	flatgeobuf_mapping *mapping = arg;
+	munmap(mapping->addr, mapping->size);
+}
+#endif
+
+/*
+ * Read features from a FlatGeobuf file on the server, mapping the file
+ * into memory instead of reading it as a bytea. Combined with a box2d
+ * filter only the features found in the index are ever paged in.
+ * The mapping is shared with the file, so truncating the file while it
+ * is being read makes the backend fault with SIGBUS; callers must not
+ * rewrite files in place while they are being read.
+ */
+PG_FUNCTION_INFO_V1(pgis_fromflatgeobuffile);
+Datum pgis_fromflatgeobuffile(PG_FUNCTION_ARGS)
+{
+#ifdef _WIN32
+	ereport(ERROR,
+			(errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+			 errmsg("%s: not supported on this platform", __func__)));
+	PG_RETURN_NULL();
+#else
+	FuncCallContext *funcctx;
+	MemoryContext oldcontext;
+	struct flatgeobuf_decode_ctx *ctx;
+
+	if (SRF_IS_FIRSTCALL()) {
+		char *path;
+		int fd;
+		struct stat st;
+		void *addr = NULL;
+
+		funcctx = SRF_FIRSTCALL_INIT();
+		oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+		funcctx->max_calls = 0;
+
+#if POSTGIS_PGSQL_VERSION >= 110
+		if (!is_member_of_role(GetUserId(), ROLE_PG_READ_SERVER_FILES))
+#else
+		if (!superuser())
+#endif
+			ereport(ERROR,
+					(errcode(ERRCODE_INSUFFICIENT_PRIVILEGE),
+					 errmsg("must be superuser or a member of pg_read_server_files to read FlatGeobuf files")));
+
+		if (PG_ARGISNULL(1))
+			elog(ERROR, "%s: file path cannot be null", __func__);
+		path = text_to_cstring(PG_GETARG_TEXT_PP(1));
+
+		ctx = fromflatgeobuf_ctx(fcinfo);
+		funcctx->user_fctx = ctx;
+
+		fd = open(path, O_RDONLY | PG_BINARY, 0);
+		if (fd < 0)
+			ereport(ERROR,
+					(errcode_for_file_access(),
+					 errmsg("could not open file \"%s\": %m", path)));
+		if (fstat(fd, &st) < 0) {
+			close(fd);
+			ereport(ERROR,
+					(errcode_for_file_access(),
+					 errmsg("could not stat file \"%s\": %m", path)));
+		}
+		if (st.st_size > 0) {
+			addr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+			if (addr == MAP_FAILED) {
+				close(fd);
+				ereport(ERROR,
+						(errcode_for_file_access(),
+						 errmsg("could not map file \"%s\": %m", path)));
+			}
+		}
+		close(fd);
+
+		if (addr) {
+			flatgeobuf_mapping *mapping = palloc(sizeof(*mapping));
+			MemoryContextCallback *cb = palloc(sizeof(*cb));
+			mapping->addr = addr;
+			mapping->size = st.st_size;
+			cb->func = flatgeobuf_unmap;
+			cb->arg = mapping;
+			MemoryContextRegisterResetCallback(funcctx->multi_call_memory_ctx, cb);
+#ifdef MADV_RANDOM
+			/* With an index search the access pattern is sparse */
+			if (PG_NARGS() > 2 && !PG_ARGISNULL(2))
+				madvise(addr, st.st_size, MADV_RANDOM);
+#endif
+		}
 
-		POSTGIS_DEBUGF(2, "header decoded now at offset %ld", ctx->ctx->offset);
+		ctx->ctx->buf = addr;
+		ctx->ctx->size = st.st_size;
 
-		if (ctx->ctx->size == ctx->ctx->offset) {
-			POSTGIS_DEBUGF(2, "no feature data offset %ld", ctx->ctx->offset);
+		if (!fromflatgeobuf_init(fcinfo, ctx, 2)) {
 			MemoryContextSwitchTo(oldcontext);
 			SRF_RETURN_DONE(funcctx);
 		}
 
-		// TODO: get table and verify structure against header
 		MemoryContextSwitchTo(oldcontext);
 	}
 
 	funcctx = SRF_PERCALL_SETUP();
-	ctx = funcctx->user_fctx;
-
-	if (!ctx->done) {
-		flatgeobuf_decode_row(ctx);
-		POSTGIS_DEBUG(2, "Calling SRF_RETURN_NEXT");
-		SRF_RETURN_NEXT(funcctx, ctx->result);
-	} else {
-		POSTGIS_DEBUG(2, "Calling SRF_RETURN_DONE");
-		SRF_RETURN_DONE(funcctx);
-	}
+	return fromflatgeobuf_next(fcinfo, funcctx);
+#endif
 }
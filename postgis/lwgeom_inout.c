@@ -69,6 +69,11 @@ Datum LWGEOM_to_latlon(PG_FUNCTION_ARGS);
 Datum WKBFromLWGEOM(PG_FUNCTION_ARGS);
 Datum TWKBFromLWGEOM(PG_FUNCTION_ARGS);
 Datum TWKBFromLWGEOMArray(PG_FUNCTION_ARGS);
+Datum pgis_astwkb_transfn(PG_FUNCTION_ARGS);
+Datum pgis_astwkb_finalfn(PG_FUNCTION_ARGS);
+Datum pgis_astwkb_serialfn(PG_FUNCTION_ARGS);
+Datum pgis_astwkb_deserialfn(PG_FUNCTION_ARGS);
+Datum pgis_astwkb_combinefn(PG_FUNCTION_ARGS);
 Datum LWGEOMFromTWKB(PG_FUNCTION_ARGS);
 
 /*
@@ -607,6 +612,149 @@ Datum TWKBFromLWGEOMArray(PG_FUNCTION_ARGS)
 	    lwcollection_as_lwgeom(col), idlist, variant, sp.precision_xy, sp.precision_z, sp.precision_m));
 }
 
+/**
+* ST_AsTWKBAgg(geom, id [, prec [, prec_z, prec_m [, with_sizes, with_boxes]]])
+* Streams the rows into one TWKB collection, without collecting them
+* into arrays first. Options are read from the first usable row.
+*/
+PG_FUNCTION_INFO_V1(pgis_astwkb_transfn);
+Datum pgis_astwkb_transfn(PG_FUNCTION_ARGS)
+{
+	MemoryContext aggcontext, oldcontext;
+	TWKB_AGG_STATE *state;
+	GSERIALIZED *geom;
+	LWGEOM *lwgeom;
+
+	if (!AggCheckCallContext(fcinfo, &aggcontext))
+		elog(ERROR, "%s called in non-aggregate context", __func__);
+
+	state = PG_ARGISNULL(0) ? NULL : (TWKB_AGG_STATE *) PG_GETARG_POINTER(0);
+
+	/* Rows missing either the geometry or the id are skipped */
+	if ( PG_ARGISNULL(1) || PG_ARGISNULL(2) )
+	{
+		if ( ! state )
+			PG_RETURN_NULL();
+		PG_RETURN_POINTER(state);
+	}
+
+	geom = PG_GETARG_GSERIALIZED_P(1);
+
+	if ( ! state )
+	{
+		/* We are building an ID'ed output */
+		uint8_t variant = TWKB_ID;
+
+		/* Read sensible precision defaults (about one meter) given the srs */
+		srs_precision sp = srid_axis_precision(gserialized_get_srid(geom), TWKB_DEFAULT_PRECISION);
+
+		/* If user specified XY precision, use it */
+		if ( PG_NARGS() > 3 && ! PG_ARGISNULL(3) )
+			sp.precision_xy = PG_GETARG_INT32(3);
+
+		/* If user specified Z precision, use it */
+		if ( PG_NARGS() > 4 && ! PG_ARGISNULL(4) )
+			sp.precision_z = PG_GETARG_INT32(4);
+
+		/* If user specified M precision, use it */
+		if ( PG_NARGS() > 5 && ! PG_ARGISNULL(5) )
+			sp.precision_m = PG_GETARG_INT32(5);
+
+		/* If user wants registered twkb sizes */
+		if ( PG_NARGS() > 6 && ! PG_ARGISNULL(6) && PG_GETARG_BOOL(6) )
+			variant |= TWKB_SIZE;
+
+		/* If user wants bounding boxes */
+		if ( PG_NARGS() > 7 && ! PG_ARGISNULL(7) && PG_GETARG_BOOL(7) )
+			variant |= TWKB_BBOX;
+
+		oldcontext = MemoryContextSwitchTo(aggcontext);
+		state = twkb_agg_init(variant, sp.precision_xy, sp.precision_z, sp.precision_m);
+		MemoryContextSwitchTo(oldcontext);
+	}
+
+	lwgeom = lwgeom_from_gserialized(geom);
+	oldcontext = MemoryContextSwitchTo(aggcontext);
+	twkb_agg_add(state, lwgeom, PG_GETARG_INT64(2));
+	MemoryContextSwitchTo(oldcontext);
+
+	lwgeom_free(lwgeom);
+	PG_FREE_IF_COPY(geom, 1);
+	PG_RETURN_POINTER(state);
+}
+
+PG_FUNCTION_INFO_V1(pgis_astwkb_finalfn);
+Datum pgis_astwkb_finalfn(PG_FUNCTION_ARGS)
+{
+	lwvarlena_t *twkb;
+
+	if (!AggCheckCallContext(fcinfo, NULL))
+		elog(ERROR, "%s called in non-aggregate context", __func__);
+
+	if ( PG_ARGISNULL(0) )
+		PG_RETURN_NULL();
+
+	twkb = twkb_agg_finalize((TWKB_AGG_STATE *) PG_GETARG_POINTER(0));
+	if ( ! twkb )
+		PG_RETURN_NULL();
+
+	PG_RETURN_BYTEA_P(twkb);
+}
+
+PG_FUNCTION_INFO_V1(pgis_astwkb_serialfn);
+Datum pgis_astwkb_serialfn(PG_FUNCTION_ARGS)
+{
+	if (!AggCheckCallContext(fcinfo, NULL))
+		elog(ERROR, "%s called in non-aggregate context", __func__);
+
+	if ( PG_ARGISNULL(0) )
+		PG_RETURN_NULL();
+
+	PG_RETURN_BYTEA_P(twkb_agg_serialize((TWKB_AGG_STATE *) PG_GETARG_POINTER(0)));
+}
+
+PG_FUNCTION_INFO_V1(pgis_astwkb_deserialfn);
+Datum pgis_astwkb_deserialfn(PG_FUNCTION_ARGS)
+{
+	MemoryContext aggcontext, oldcontext;
+	TWKB_AGG_STATE *state;
+	bytea *serialized;
+
+	if (!AggCheckCallContext(fcinfo, &aggcontext))
+		elog(ERROR, "%s called in non-aggregate context", __func__);
+
+	if ( PG_ARGISNULL(0) )
+		PG_RETURN_NULL();
+
+	serialized = PG_GETARG_BYTEA_P(0);
+	oldcontext = MemoryContextSwitchTo(aggcontext);
+	state = twkb_agg_deserialize((uint8_t *) VARDATA(serialized), VARSIZE(serialized) - VARHDRSZ);
+	MemoryContextSwitchTo(oldcontext);
+
+	PG_RETURN_POINTER(state);
+}
+
+PG_FUNCTION_INFO_V1(pgis_astwkb_combinefn);
+Datum pgis_astwkb_combinefn(PG_FUNCTION_ARGS)
+{
+	MemoryContext aggcontext, oldcontext;
+	TWKB_AGG_STATE *state1, *state2, *state;
+
+	if (!AggCheckCallContext(fcinfo, &aggcontext))
+		elog(ERROR, "%s called in non-aggregate context", __func__);
+
+	state1 = PG_ARGISNULL(0) ? NULL : (TWKB_AGG_STATE *) PG_GETARG_POINTER(0);
+	state2 = PG_ARGISNULL(1) ? NULL : (TWKB_AGG_STATE *) PG_GETARG_POINTER(1);
+
+	oldcontext = MemoryContextSwitchTo(aggcontext);
+	state = twkb_agg_combine(state1, state2);
+	MemoryContextSwitchTo(oldcontext);
+
+	if ( ! state )
+		PG_RETURN_NULL();
+	PG_RETURN_POINTER(state);
+}
+
 
 /* puts a bbox inside the geometry */
 PG_FUNCTION_INFO_V1(LWGEOM_addBBOX);
@@ -36,6 +36,7 @@
 /* Prototypes */
 Datum ST_DistanceRectTree(PG_FUNCTION_ARGS);
 Datum ST_DistanceRectTreeCached(PG_FUNCTION_ARGS);
+Datum ST_DWithinRectTreeCached(PG_FUNCTION_ARGS);
 
 
 /**********************************************************************
@@ -43,72 +44,104 @@ Datum ST_DistanceRectTreeCached(PG_FUNCTION_ARGS);
 **********************************************************************/
 
 /*
-* Specific tree types include all the generic slots and
-* their own slots for their trees. We put the implementation
-* for the RectTreeGeomCache here because we can't shove
-* the PgSQL specific bits of the code (fcinfo) back into
-* liblwgeom/lwtree.c, where most of the rect_tree logic lives.
+* Unlike the GeomCache, which holds one tree for whichever argument
+* repeats, this cache keeps the last RECT_TREE_CACHE_SIZE geometries
+* seen on each side of the call. In a join both sides repeat, the
+* outer value on every call and the inner values once per outer row,
+* so trees for both arguments get reused. Like the GeomCache, a tree
+* is only built the second time its geometry shows up.
 */
+#define RECT_TREE_CACHE_SIZE 8
+
 typedef struct {
-	GeomCache           gcache;
-	RECT_NODE           *index;
-} RectTreeGeomCache;
+	SHARED_GSERIALIZED  *geom;
+	LWGEOM              *lwgeom;
+	RECT_NODE           *tree;
+	uint64              last_used;
+} RectTreeCacheEntry;
 
+typedef struct {
+	int                 type;
+	uint64              clock;
+	RectTreeCacheEntry  entry[2][RECT_TREE_CACHE_SIZE];
+} RectTreeCache;
+
+static void
+RectTreeCacheEntryFree(FunctionCallInfo fcinfo, RectTreeCacheEntry *entry)
+{
+	if (entry->tree)
+		rect_tree_free(entry->tree);
+	if (entry->lwgeom)
+		lwgeom_free(entry->lwgeom);
+	if (entry->geom)
+		shared_gserialized_unref(fcinfo, entry->geom);
+	memset(entry, 0, sizeof(RectTreeCacheEntry));
+}
 
 /**
-* Builder, freeer and public accessor for cached RECT_NODE trees
+* Return the cached tree for an argument, building it if this is
+* the second sighting of the geometry. Returns NULL on a first
+* sighting, after remembering the geometry in the least recently
+* used slot for that argument.
 */
-static int
-RectTreeBuilder(const LWGEOM *lwgeom, GeomCache *cache)
+static RECT_NODE *
+GetRectTreeCached(FunctionCallInfo fcinfo, uint32_t argnum, SHARED_GSERIALIZED *geom)
 {
-	RectTreeGeomCache *rect_cache = (RectTreeGeomCache*)cache;
-	RECT_NODE *tree = rect_tree_from_lwgeom(lwgeom);
+	RectTreeCache *cache = GetCacheEntry(fcinfo, RECT_CACHE_ENTRY, sizeof(RectTreeCache));
+	RectTreeCacheEntry *entries = cache->entry[argnum];
+	RectTreeCacheEntry *entry = &entries[0];
+	MemoryContext old_context;
+	uint32_t i;
 
-	if ( rect_cache->index )
+	cache->clock++;
+	for (i = 0; i < RECT_TREE_CACHE_SIZE; i++)
 	{
-		rect_tree_free(rect_cache->index);
-		rect_cache->index = 0;
+		if (entries[i].geom && shared_gserialized_equal(geom, entries[i].geom))
+		{
+			entry = &entries[i];
+			entry->last_used = cache->clock;
+			break;
+		}
+		/* Empty slots have never been used, so they go first */
+		if (entries[i].last_used < entry->last_used)
+			entry = &entries[i];
 	}
-	if ( ! tree )
-		return LW_FAILURE;
 
-	rect_cache->index = tree;
-	return LW_SUCCESS;
-}
-
-static int
-RectTreeFreer(GeomCache *cache)
-{
-	RectTreeGeomCache *rect_cache = (RectTreeGeomCache*)cache;
-	if ( rect_cache->index )
+	/* Miss, recycle the oldest slot and wait for a second sighting */
+	if (i == RECT_TREE_CACHE_SIZE)
 	{
-		rect_tree_free(rect_cache->index);
-		rect_cache->index = 0;
-		rect_cache->gcache.argnum = 0;
+		RectTreeCacheEntryFree(fcinfo, entry);
+		entry->geom = shared_gserialized_ref(fcinfo, geom);
+		entry->last_used = cache->clock;
+		return NULL;
 	}
-	return LW_SUCCESS;
-}
 
-static GeomCache *
-RectTreeAllocator(void)
-{
-	RectTreeGeomCache *cache = palloc(sizeof(RectTreeGeomCache));
-	memset(cache, 0, sizeof(RectTreeGeomCache));
-	return (GeomCache*)cache;
+	/* Hit, but no tree built yet, build it in the cache context */
+	if (!entry->tree)
+	{
+		old_context = MemoryContextSwitchTo(PostgisCacheContext(fcinfo));
+		if (!entry->lwgeom)
+			entry->lwgeom = lwgeom_from_gserialized(shared_gserialized_get(entry->geom));
+		entry->tree = rect_tree_from_lwgeom(entry->lwgeom);
+		MemoryContextSwitchTo(old_context);
+	}
+	return entry->tree;
 }
 
-static GeomCacheMethods RectTreeCacheMethods =
-{
-	RECT_CACHE_ENTRY,
-	RectTreeBuilder,
-	RectTreeFreer,
-	RectTreeAllocator
-};
-
-static RectTreeGeomCache *
-GetRectTreeGeomCache(FunctionCallInfo fcinfo, SHARED_GSERIALIZED *g1, SHARED_GSERIALIZED *g2)
+/**
+* Cached tree for the argument if there is one, otherwise
+* a tree built in the call context. Sets *cached so the
+* caller knows whether to free it.
+*/
+static RECT_NODE *
+GetRectTree(FunctionCallInfo fcinfo, uint32_t argnum, SHARED_GSERIALIZED *geom, LWGEOM **lwgeom, int *cached)
 {
-	return (RectTreeGeomCache*)GetGeomCache(fcinfo, &RectTreeCacheMethods, g1, g2);
+	RECT_NODE *tree = GetRectTreeCached(fcinfo, argnum, geom);
+	*cached = (tree != NULL);
+	if (tree)
+		return tree;
+	*lwgeom = lwgeom_from_gserialized(shared_gserialized_get(geom));
+	return rect_tree_from_lwgeom(*lwgeom);
 }
 
 
@@ -148,11 +181,14 @@ Datum ST_DistanceRectTree(PG_FUNCTION_ARGS)
 PG_FUNCTION_INFO_V1(ST_DistanceRectTreeCached);
 Datum ST_DistanceRectTreeCached(PG_FUNCTION_ARGS)
 {
-	RectTreeGeomCache *tree_cache = NULL;
 	SHARED_GSERIALIZED *shared_geom1 = ToastCacheGetGeometry(fcinfo, 0);
 	SHARED_GSERIALIZED *shared_geom2 = ToastCacheGetGeometry(fcinfo, 1);
 	const GSERIALIZED *g1 = shared_gserialized_get(shared_geom1);
 	const GSERIALIZED *g2 = shared_gserialized_get(shared_geom2);
+	LWGEOM *lwg1 = NULL, *lwg2 = NULL;
+	RECT_NODE *n1, *n2;
+	int cached1, cached2;
+	double distance;
 
 	/* Return NULL on empty arguments. */
 	if (gserialized_is_empty(g1) || gserialized_is_empty(g2))
@@ -163,40 +199,71 @@ Datum ST_DistanceRectTreeCached(PG_FUNCTION_ARGS)
 	/* Two points? Get outa here... */
 	if (gserialized_get_type(g1) == POINTTYPE && gserialized_get_type(g2) == POINTTYPE)
 	{
-		LWGEOM *lwg1 = lwgeom_from_gserialized(g1);
-		LWGEOM *lwg2 = lwgeom_from_gserialized(g2);
+		lwg1 = lwgeom_from_gserialized(g1);
+		lwg2 = lwgeom_from_gserialized(g2);
 		PG_RETURN_FLOAT8(lwgeom_mindistance2d(lwg1, lwg2));
 	}
 
-	/* Fetch/build our cache, if appropriate, etc... */
-	tree_cache = GetRectTreeGeomCache(fcinfo, shared_geom1, shared_geom2);
+	/* Fetch/build our trees, from the cache where possible */
+	n1 = GetRectTree(fcinfo, 0, shared_geom1, &lwg1, &cached1);
+	n2 = GetRectTree(fcinfo, 1, shared_geom2, &lwg2, &cached2);
+	if (n1 && n2)
+		distance = rect_tree_distance_tree(n1, n2, 0.0);
+	else
+		distance = lwgeom_mindistance2d(lwgeom_from_gserialized(g1), lwgeom_from_gserialized(g2));
+
+	if (!cached1) rect_tree_free(n1);
+	if (!cached2) rect_tree_free(n2);
+	PG_RETURN_FLOAT8(distance);
+}
+
+/**********************************************************************
+* ST_DWithinRectTreeCached
+**********************************************************************/
+
+PG_FUNCTION_INFO_V1(ST_DWithinRectTreeCached);
+Datum ST_DWithinRectTreeCached(PG_FUNCTION_ARGS)
+{
+	SHARED_GSERIALIZED *shared_geom1 = ToastCacheGetGeometry(fcinfo, 0);
+	SHARED_GSERIALIZED *shared_geom2 = ToastCacheGetGeometry(fcinfo, 1);
+	const GSERIALIZED *g1 = shared_gserialized_get(shared_geom1);
+	const GSERIALIZED *g2 = shared_gserialized_get(shared_geom2);
+	double tolerance = PG_GETARG_FLOAT8(2);
+	LWGEOM *lwg1 = NULL, *lwg2 = NULL;
+	RECT_NODE *n1, *n2;
+	int cached1, cached2;
+	double distance;
+
+	if (tolerance < 0)
+	{
+		elog(ERROR, "Tolerance cannot be less than zero\n");
+		PG_RETURN_NULL();
+	}
+
+	gserialized_error_if_srid_mismatch(g1, g2, __func__);
 
-	if (tree_cache && tree_cache->gcache.argnum)
+	if (gserialized_is_empty(g1) || gserialized_is_empty(g2))
 	{
-		RECT_NODE *n;
-		RECT_NODE *n_cached = tree_cache->index;;
-		if (tree_cache->gcache.argnum == 1)
-		{
-			LWGEOM *lwg2 = lwgeom_from_gserialized(g2);
-			n = rect_tree_from_lwgeom(lwg2);
-		}
-		else if (tree_cache->gcache.argnum == 2)
-		{
-			LWGEOM *lwg1 = lwgeom_from_gserialized(g1);
-			n = rect_tree_from_lwgeom(lwg1);
-		}
-		else
-		{
-			elog(ERROR, "reached unreachable block in %s", __func__);
-		}
-		PG_RETURN_FLOAT8(rect_tree_distance_tree(n, n_cached, 0.0));
+		PG_RETURN_BOOL(false);
 	}
-	else
+
+	/* Two points? Get outa here... */
+	if (gserialized_get_type(g1) == POINTTYPE && gserialized_get_type(g2) == POINTTYPE)
 	{
-		LWGEOM *lwg1 = lwgeom_from_gserialized(g1);
-		LWGEOM *lwg2 = lwgeom_from_gserialized(g2);
-		PG_RETURN_FLOAT8(lwgeom_mindistance2d(lwg1, lwg2));
+		lwg1 = lwgeom_from_gserialized(g1);
+		lwg2 = lwgeom_from_gserialized(g2);
+		PG_RETURN_BOOL(tolerance >= lwgeom_mindistance2d(lwg1, lwg2));
 	}
 
-	PG_RETURN_NULL();
+	/* The search stops as soon as it finds a pair within tolerance */
+	n1 = GetRectTree(fcinfo, 0, shared_geom1, &lwg1, &cached1);
+	n2 = GetRectTree(fcinfo, 1, shared_geom2, &lwg2, &cached2);
+	if (n1 && n2)
+		distance = rect_tree_distance_tree(n1, n2, tolerance);
+	else
+		distance = lwgeom_mindistance2d_tolerance(lwgeom_from_gserialized(g1), lwgeom_from_gserialized(g2), tolerance);
+
+	if (!cached1) rect_tree_free(n1);
+	if (!cached2) rect_tree_free(n2);
+	PG_RETURN_BOOL(tolerance >= distance);
 }
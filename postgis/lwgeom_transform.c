@@ -26,6 +26,8 @@
 #include "postgres.h"
 #include "fmgr.h"
 #include "utils/builtins.h"
+#include "utils/array.h"
+#include "utils/lsyscache.h"
 
 #include "../postgis_config.h"
 #include "liblwgeom.h"
@@ -34,6 +36,7 @@
 
 Datum transform(PG_FUNCTION_ARGS);
 Datum transform_geom(PG_FUNCTION_ARGS);
+Datum transform_array(PG_FUNCTION_ARGS);
 Datum postgis_proj_version(PG_FUNCTION_ARGS);
 Datum LWGEOM_asKML(PG_FUNCTION_ARGS);
 
@@ -148,6 +151,129 @@ Datum transform_geom(PG_FUNCTION_ARGS)
 	PG_RETURN_POINTER(gser_result); /* new geometry */
 }
 
+/**
+ * transform_array( GEOMETRY[], INT (output srid) )
+ * Same as transform() applied to every element, but the coordinates of
+ * all elements sharing a source SRID go through PROJ in one call.
+ * NULL elements stay NULL, the array shape is kept.
+ */
+PG_FUNCTION_INFO_V1(transform_array);
+Datum transform_array(PG_FUNCTION_ARGS)
+{
+	ArrayType *array, *result;
+	ArrayIterator iterator;
+	Datum value;
+	bool isnull;
+	Datum *elems;
+	bool *nulls;
+	LWGEOM **lwgeoms, **batch;
+	int16 elmlen;
+	bool elmbyval;
+	char elmalign;
+	uint32_t nelems, nbatch, i, j;
+	int32 srid_to;
+
+	srid_to = PG_GETARG_INT32(1);
+	if (srid_to == SRID_UNKNOWN)
+	{
+		elog(ERROR, "ST_Transform: %d is an invalid target SRID", SRID_UNKNOWN);
+		PG_RETURN_NULL();
+	}
+
+	array = PG_GETARG_ARRAYTYPE_P(0);
+	nelems = ArrayGetNItems(ARR_NDIM(array), ARR_DIMS(array));
+	if (nelems == 0)
+		PG_RETURN_ARRAYTYPE_P(array);
+
+	elems = palloc(sizeof(Datum) * nelems);
+	nulls = palloc(sizeof(bool) * nelems);
+	lwgeoms = palloc0(sizeof(LWGEOM*) * nelems);
+	batch = palloc(sizeof(LWGEOM*) * nelems);
+
+	/* Deserialize copies of everything that needs transforming */
+	i = 0;
+	iterator = array_create_iterator(array, 0, NULL);
+	while (array_iterate(iterator, &value, &isnull))
+	{
+		elems[i] = value;
+		nulls[i] = isnull;
+		if (!isnull)
+		{
+			GSERIALIZED *geom = (GSERIALIZED *)DatumGetPointer(value);
+			int32 srid_from = gserialized_get_srid(geom);
+
+			if (srid_from == SRID_UNKNOWN)
+			{
+				elog(ERROR, "ST_Transform: Input geometry has unknown (%d) SRID", SRID_UNKNOWN);
+				PG_RETURN_NULL();
+			}
+
+			/* Input SRID and output SRID are equal, noop */
+			if (srid_from != srid_to)
+			{
+				/* Take a copy, since we will be altering the coordinates */
+				GSERIALIZED *copy = palloc(VARSIZE(geom));
+				memcpy(copy, geom, VARSIZE(geom));
+				lwgeoms[i] = lwgeom_from_gserialized(copy);
+			}
+		}
+		i++;
+	}
+	array_free_iterator(iterator);
+
+	postgis_initialize_cache();
+
+	/* One batch per distinct source SRID */
+	for (i = 0; i < nelems; i++)
+	{
+		LWPROJ *pj;
+		int32 srid_from;
+
+		if (!lwgeoms[i] || lwgeoms[i]->srid == srid_to)
+			continue;
+
+		srid_from = lwgeoms[i]->srid;
+		nbatch = 0;
+		for (j = i; j < nelems; j++)
+		{
+			if (lwgeoms[j] && lwgeoms[j]->srid == srid_from)
+				batch[nbatch++] = lwgeoms[j];
+		}
+
+		if (GetLWPROJ(srid_from, srid_to, &pj) == LW_FAILURE)
+		{
+			elog(ERROR, "ST_Transform: Failure reading projections from spatial_ref_sys.");
+			PG_RETURN_NULL();
+		}
+		lwgeom_transform_array(batch, nbatch, pj);
+
+		for (j = 0; j < nbatch; j++)
+		{
+			batch[j]->srid = srid_to;
+			/* Re-compute bbox if input had one (COMPUTE_BBOX TAINTING) */
+			if (batch[j]->bbox)
+				lwgeom_refresh_bbox(batch[j]);
+		}
+	}
+
+	for (i = 0; i < nelems; i++)
+	{
+		if (lwgeoms[i])
+		{
+			elems[i] = PointerGetDatum(geometry_serialize(lwgeoms[i]));
+			lwgeom_free(lwgeoms[i]);
+		}
+	}
+
+	get_typlenbyvalalign(ARR_ELEMTYPE(array), &elmlen, &elmbyval, &elmalign);
+	result = construct_md_array(elems, nulls,
+				    ARR_NDIM(array), ARR_DIMS(array), ARR_LBOUND(array),
+				    ARR_ELEMTYPE(array), elmlen, elmbyval, elmalign);
+
+	pfree(batch);
+	pfree(lwgeoms);
+	PG_RETURN_ARRAYTYPE_P(result);
+}
 
 PG_FUNCTION_INFO_V1(postgis_proj_version);
 Datum postgis_proj_version(PG_FUNCTION_ARGS)
@@ -50,6 +50,7 @@
 #include "vector_tile.pb-c.h"
 
 #define FEATURES_CAPACITY_INITIAL 50
+#define MVT_ARENA_CHUNK_SIZE 65536 /* Largest arena chunk */
 
 enum mvt_cmd_id
 {
@@ -78,6 +79,34 @@ struct mvt_kv_value {
 	UT_hash_handle hh;
 };
 
+/*
+ * Allocates from the arena. Memory is only released with the memory
+ * context that was current when the chunks were allocated.
+ */
+static void *
+mvt_arena_alloc(mvt_arena *arena, size_t size)
+{
+	void *ptr;
+
+	size = MAXALIGN(size);
+	/* Big requests get their own allocation instead of wasting chunks */
+	if (size > MVT_ARENA_CHUNK_SIZE / 4)
+		return palloc(size);
+
+	if (!arena->chunk || arena->used + size > arena->size)
+	{
+		/* Start small for tiles with a handful of features */
+		size_t chunk_size = arena->size ? Min(arena->size * 2, MVT_ARENA_CHUNK_SIZE) : 8192;
+		chunk_size = Max(chunk_size, size);
+		arena->chunk = palloc(chunk_size);
+		arena->size = chunk_size;
+		arena->used = 0;
+	}
+	ptr = arena->chunk + arena->used;
+	arena->used += size;
+	return ptr;
+}
+
 static inline uint32_t c_int(enum mvt_cmd_id id, uint32_t count)
 {
 	return (id & 0x7) | (count << 3);
@@ -152,21 +181,36 @@ static void encode_point(mvt_agg_context *ctx, LWPOINT *point)
 	VectorTile__Tile__Feature *feature = ctx->feature;
 	feature->type = VECTOR_TILE__TILE__GEOM_TYPE__POINT;
 	feature->n_geometry = 3;
-	feature->geometry = palloc(sizeof(*feature->geometry) * 3);
+	feature->geometry = mvt_arena_alloc(&ctx->arena, sizeof(*feature->geometry) * 3);
 	encode_ptarray_initial(ctx, MVT_POINT, point->point, feature->geometry);
 }
 
 static void encode_mpoint(mvt_agg_context *ctx, LWMPOINT *mpoint)
 {
-	size_t c;
+	uint32_t i, c = 0, offset = 1;
+	int32_t px = 0, py = 0;
 	VectorTile__Tile__Feature *feature = ctx->feature;
-	// NOTE: inefficient shortcut LWMPOINT->LWLINE
-	LWLINE *lwline = lwline_from_lwmpoint(mpoint->srid, mpoint);
 	feature->type = VECTOR_TILE__TILE__GEOM_TYPE__POINT;
-	c = 1 + lwline->points->npoints * 2;
-	feature->geometry = palloc(sizeof(*feature->geometry) * c);
-	feature->n_geometry = encode_ptarray_initial(ctx, MVT_POINT,
-		lwline->points, feature->geometry);
+	feature->geometry = mvt_arena_alloc(&ctx->arena,
+		sizeof(*feature->geometry) * (1 + mpoint->ngeoms * 2));
+	/* A single move command followed by all the points */
+	for (i = 0; i < mpoint->ngeoms; i++)
+	{
+		const POINT2D *p;
+		int32_t x, y;
+		if (lwpoint_is_empty(mpoint->geoms[i]))
+			continue;
+		p = getPoint2d_cp(mpoint->geoms[i]->point, 0);
+		x = p->x;
+		y = p->y;
+		feature->geometry[offset++] = p_int(x - px);
+		feature->geometry[offset++] = p_int(y - py);
+		px = x;
+		py = y;
+		c++;
+	}
+	feature->geometry[0] = c_int(CMD_MOVE_TO, c);
+	feature->n_geometry = offset;
 }
 
 static void encode_line(mvt_agg_context *ctx, LWLINE *lwline)
@@ -175,7 +219,7 @@ static void encode_line(mvt_agg_context *ctx, LWLINE *lwline)
 	VectorTile__Tile__Feature *feature = ctx->feature;
 	feature->type = VECTOR_TILE__TILE__GEOM_TYPE__LINESTRING;
 	c = 2 + lwline->points->npoints * 2;
-	feature->geometry = palloc(sizeof(*feature->geometry) * c);
+	feature->geometry = mvt_arena_alloc(&ctx->arena, sizeof(*feature->geometry) * c);
 	feature->n_geometry = encode_ptarray_initial(ctx, MVT_LINE,
 		lwline->points, feature->geometry);
 }
@@ -189,7 +233,7 @@ static void encode_mline(mvt_agg_context *ctx, LWMLINE *lwmline)
 	feature->type = VECTOR_TILE__TILE__GEOM_TYPE__LINESTRING;
 	for (i = 0; i < lwmline->ngeoms; i++)
 		c += 2 + lwmline->geoms[i]->points->npoints * 2;
-	feature->geometry = palloc(sizeof(*feature->geometry) * c);
+	feature->geometry = mvt_arena_alloc(&ctx->arena, sizeof(*feature->geometry) * c);
 	for (i = 0; i < lwmline->ngeoms; i++)
 		offset += encode_ptarray(ctx, MVT_LINE,
 			lwmline->geoms[i]->points,
@@ -206,7 +250,7 @@ static void encode_poly(mvt_agg_context *ctx, LWPOLY *lwpoly)
 	feature->type = VECTOR_TILE__TILE__GEOM_TYPE__POLYGON;
 	for (i = 0; i < lwpoly->nrings; i++)
 		c += 3 + ((lwpoly->rings[i]->npoints - 1) * 2);
-	feature->geometry = palloc(sizeof(*feature->geometry) * c);
+	feature->geometry = mvt_arena_alloc(&ctx->arena, sizeof(*feature->geometry) * c);
 	for (i = 0; i < lwpoly->nrings; i++)
 		offset += encode_ptarray(ctx, MVT_RING,
 			lwpoly->rings[i],
@@ -225,7 +269,7 @@ static void encode_mpoly(mvt_agg_context *ctx, LWMPOLY *lwmpoly)
 	for (i = 0; i < lwmpoly->ngeoms; i++)
 		for (j = 0; poly = lwmpoly->geoms[i], j < poly->nrings; j++)
 			c += 3 + ((poly->rings[j]->npoints - 1) * 2);
-	feature->geometry = palloc(sizeof(*feature->geometry) * c);
+	feature->geometry = mvt_arena_alloc(&ctx->arena, sizeof(*feature->geometry) * c);
 	for (i = 0; i < lwmpoly->ngeoms; i++)
 		for (j = 0; poly = lwmpoly->geoms[i], j < poly->nrings; j++)
 			offset += encode_ptarray(ctx, MVT_RING,
@@ -409,7 +453,7 @@ static void encode_values(mvt_agg_context *ctx)
 			if (!kv) \
 			{ \
 				POSTGIS_DEBUG(4, "MVT_PARSE_VALUE value not found"); \
-				kv = palloc(sizeof(*kv)); \
+				kv = mvt_arena_alloc(&ctx->arena, sizeof(*kv)); \
 				POSTGIS_DEBUGF(4, "MVT_PARSE_VALUE new hash key: %d", ctx->values_hash_i); \
 				kv->id = ctx->values_hash_i++; \
 				vector_tile__tile__value__init(kv->value); \
@@ -468,7 +512,7 @@ add_value_as_string_with_size(mvt_agg_context *ctx, char *value, size_t size, ui
 	if (!kv)
 	{
 		POSTGIS_DEBUG(4, "add_value_as_string value not found");
-		kv = palloc(sizeof(*kv));
+		kv = mvt_arena_alloc(&ctx->arena, sizeof(*kv));
 		POSTGIS_DEBUGF(4, "add_value_as_string new hash key: %d",
 			ctx->values_hash_i);
 		kv->id = ctx->values_hash_i++;
@@ -506,6 +550,22 @@ parse_datum_as_string(mvt_agg_context *ctx, Oid typoid, Datum datum, uint32_t *t
 	add_value_as_string(ctx, value, tags, k);
 }
 
+/* Makes room for n_tags in the tag buffer shared by all the rows */
+static uint32_t *
+reserve_tags(mvt_agg_context *ctx, uint32_t n_tags)
+{
+	if (n_tags > ctx->tags_capacity)
+	{
+		uint32_t capacity = Max(n_tags, ctx->tags_capacity * 2);
+		if (ctx->tags)
+			ctx->tags = repalloc(ctx->tags, capacity * sizeof(*ctx->tags));
+		else
+			ctx->tags = palloc(capacity * sizeof(*ctx->tags));
+		ctx->tags_capacity = capacity;
+	}
+	return ctx->tags;
+}
+
 static uint32_t *parse_jsonb(mvt_agg_context *ctx, Jsonb *jb,
 	uint32_t *tags)
 {
@@ -537,7 +597,7 @@ static uint32_t *parse_jsonb(mvt_agg_context *ctx, Jsonb *jb,
 				memcpy(key, v.val.string.val, v.val.string.len);
 				key[v.val.string.len] = '\0';
 
-				tags = repalloc(tags, newSize * 2 * sizeof(*tags));
+				tags = reserve_tags(ctx, newSize * 2);
 				k = add_key(ctx, key);
 			}
 
@@ -632,7 +692,7 @@ static void set_feature_id(mvt_agg_context *ctx, Datum datum, bool isNull)
 static void parse_values(mvt_agg_context *ctx)
 {
 	uint32_t n_keys = ctx->keys_hash_i;
-	uint32_t *tags = palloc(n_keys * 2 * sizeof(*tags));
+	uint32_t *tags = reserve_tags(ctx, n_keys * 2);
 	uint32_t i;
 	mvt_column_cache cc = ctx->column_cache;
 	uint32_t natts = (uint32_t) cc.tupdesc->natts;
@@ -737,8 +797,10 @@ static void parse_values(mvt_agg_context *ctx)
 	}
 
 
+	/* Keep only the tags used by this row */
 	ctx->feature->n_tags = ctx->row_columns * 2;
-	ctx->feature->tags = tags;
+	ctx->feature->tags = mvt_arena_alloc(&ctx->arena, ctx->feature->n_tags * sizeof(*tags));
+	memcpy(ctx->feature->tags, tags, ctx->feature->n_tags * sizeof(*tags));
 
 	POSTGIS_DEBUGF(3, "parse_values n_tags %zd", ctx->feature->n_tags);
 }
@@ -809,11 +871,73 @@ lwgeom_to_basic_type(LWGEOM *geom, uint8_t original_type)
 	return geom_out;
 }
 
-/* Clips a geometry using lwgeom_clip_by_rect. Might return NULL */
+/*
+ * Clips points and lines already snapped to the tile grid by the box,
+ * without going through GEOS. Might return NULL
+ */
+static LWGEOM *
+mvt_clip_by_box(LWGEOM *lwg_in, const GBOX *clip_box)
+{
+	gridspec grid = {0, 0, 0, 0, 1, 1, 0, 0};
+	LWCOLLECTION *col;
+	uint32_t i;
+
+	switch (lwg_in->type)
+	{
+	case POINTTYPE:
+	case MULTIPOINTTYPE:
+	{
+		LWMPOINT *mpoint = lwgeom_as_lwmpoint(lwg_in);
+		LWPOINT *point = lwgeom_as_lwpoint(lwg_in);
+		uint32_t npoints = mpoint ? mpoint->ngeoms : 1;
+
+		col = lwcollection_construct_empty(MULTIPOINTTYPE, lwg_in->srid,
+			lwgeom_has_z(lwg_in), lwgeom_has_m(lwg_in));
+		for (i = 0; i < npoints; i++)
+		{
+			LWPOINT *pt = mpoint ? mpoint->geoms[i] : point;
+			POINT4D p;
+			if (!lwpoint_getPoint4d_p(pt, &p))
+				continue;
+			if (p.x >= clip_box->xmin && p.x <= clip_box->xmax &&
+			    p.y >= clip_box->ymin && p.y <= clip_box->ymax)
+				lwcollection_add_lwgeom(col, lwpoint_as_lwgeom(pt));
+		}
+		break;
+	}
+	case LINETYPE:
+	case MULTILINETYPE:
+	{
+		LWMLINE *mline = lwgeom_as_lwmline(lwg_in);
+		LWLINE *line = lwgeom_as_lwline(lwg_in);
+		uint32_t nlines = mline ? mline->ngeoms : 1;
+
+		col = lwcollection_construct_empty(MULTILINETYPE, lwg_in->srid,
+			lwgeom_has_z(lwg_in), lwgeom_has_m(lwg_in));
+		for (i = 0; i < nlines; i++)
+			ptarray_clip_by_rect((mline ? mline->geoms[i] : line)->points, clip_box, LW_TRUE, col);
+
+		/* Cut points are back on the grid, which keeps them inside the box as its
+		 * limits are integers. Pieces collapsing to a single point go away. */
+		lwgeom_grid_in_place(lwcollection_as_lwgeom(col), &grid);
+		break;
+	}
+	default:
+		elog(ERROR, "%s: Invalid type (%d)", __func__, lwg_in->type);
+	}
+
+	if (col->ngeoms == 0)
+		return NULL;
+	/* Single parts are returned as such */
+	if (col->ngeoms == 1)
+		return col->geoms[0];
+	return lwcollection_as_lwgeom(col);
+}
+
+/* Clips a geometry using mvt_clip_by_box. Might return NULL */
 static LWGEOM *
 mvt_unsafe_clip_by_box(LWGEOM *lwg_in, GBOX *clip_box)
 {
-	LWGEOM *geom_clipped;
 	GBOX geom_box;
 
 	gbox_init(&geom_box);
@@ -832,18 +956,15 @@ mvt_unsafe_clip_by_box(LWGEOM *lwg_in, GBOX *clip_box)
 		return lwg_in;
 	}
 
-	geom_clipped = lwgeom_clip_by_rect(lwg_in, clip_box->xmin, clip_box->ymin, clip_box->xmax, clip_box->ymax);
-	if (!geom_clipped || lwgeom_is_empty(geom_clipped))
-		return NULL;
-	return geom_clipped;
+	return mvt_clip_by_box(lwg_in, clip_box);
 }
 
-/* Clips a geometry for MVT using GEOS.
+/* Clips a point or line geometry for MVT on the integer tile grid.
  * Does NOT work for polygons
  * Might return NULL
  */
 static LWGEOM *
-mvt_clip_and_validate_geos(LWGEOM *lwgeom, uint8_t basic_type, uint32_t extent, uint32_t buffer, bool clip_geom)
+mvt_clip_and_validate_grid(LWGEOM *lwgeom, uint8_t basic_type, uint32_t extent, uint32_t buffer, bool clip_geom)
 {
 	LWGEOM *ng = lwgeom;
 	assert(lwgeom->type != POLYGONTYPE);
@@ -851,16 +972,12 @@ mvt_clip_and_validate_geos(LWGEOM *lwgeom, uint8_t basic_type, uint32_t extent,
 
 	if (clip_geom)
 	{
-		gridspec grid = {0, 0, 0, 0, 1, 1, 0, 0};
 		GBOX bgbox;
 		bgbox.xmax = bgbox.ymax = (double)extent + (double)buffer;
 		bgbox.xmin = bgbox.ymin = -(double)buffer;
 		FLAGS_SET_GEODETIC(bgbox.flags, 0);
 
 		ng = mvt_unsafe_clip_by_box(ng, &bgbox);
-
-		/* Make sure there is no pending float values (clipping can do that) */
-		lwgeom_grid_in_place(ng, &grid);
 	}
 
 	return ng;
@@ -872,11 +989,11 @@ mvt_clip_and_validate(LWGEOM *lwgeom, uint8_t basic_type, uint32_t extent, uint3
 	GBOX clip_box = {0};
 	LWGEOM *clipped_lwgeom;
 
-	/* Wagyu only supports polygons. Default to geos for other types */
+	/* Wagyu only supports polygons. Points and lines are clipped directly on the grid */
 	lwgeom = lwgeom_to_basic_type(lwgeom, POLYGONTYPE);
 	if (lwgeom->type != POLYGONTYPE && lwgeom->type != MULTIPOLYGONTYPE)
 	{
-		return mvt_clip_and_validate_geos(lwgeom, basic_type, extent, buffer, clip_geom);
+		return mvt_clip_and_validate_grid(lwgeom, basic_type, extent, buffer, clip_geom);
 	}
 
 	if (!clip_geom)
@@ -984,6 +1101,9 @@ void mvt_agg_init_context(mvt_agg_context *ctx)
 	ctx->geom_index = UINT32_MAX;
 
 	memset(&ctx->column_cache, 0, sizeof(ctx->column_cache));
+	ctx->tags = NULL;
+	ctx->tags_capacity = 0;
+	memset(&ctx->arena, 0, sizeof(ctx->arena));
 
 	layer = palloc(sizeof(*layer));
 	vector_tile__tile__layer__init(layer);
@@ -1035,7 +1155,7 @@ void mvt_agg_transfn(mvt_agg_context *ctx)
 		return;
 	}
 
-	feature = palloc(sizeof(*feature));
+	feature = mvt_arena_alloc(&ctx->arena, sizeof(*feature));
 	vector_tile__tile__feature__init(feature);
 
 	ctx->feature = feature;
@@ -1048,7 +1168,8 @@ void mvt_agg_transfn(mvt_agg_context *ctx)
 
 	encode_geometry(ctx, lwgeom);
 	lwgeom_free(lwgeom);
-	// TODO: free detoasted datum?
+	if ((Pointer) gs != DatumGetPointer(datum))
+		pfree(gs);
 	parse_values(ctx);
 }
 
@@ -1103,18 +1224,20 @@ bytea * mvt_ctx_serialize(mvt_agg_context *ctx)
 	return mvt_ctx_to_bytea(ctx);
 }
 
-static void * mvt_allocator(__attribute__((__unused__)) void *data, size_t size)
+static void * mvt_allocator(void *data, size_t size)
 {
-	return palloc(size);
+	return mvt_arena_alloc((mvt_arena *)data, size);
 }
 
-static void mvt_deallocator(__attribute__((__unused__)) void *data, void *ptr)
+static void mvt_deallocator(__attribute__((__unused__)) void *data, __attribute__((__unused__)) void *ptr)
 {
-	return pfree(ptr);
+	/* Arena memory goes away with the aggregate context */
 }
 
 mvt_agg_context * mvt_ctx_deserialize(const bytea *ba)
 {
+	size_t len = VARSIZE_ANY_EXHDR(ba);
+	mvt_agg_context *ctx = palloc(sizeof(mvt_agg_context));
 	ProtobufCAllocator allocator =
 	{
 		mvt_allocator,
@@ -1122,53 +1245,199 @@ mvt_agg_context * mvt_ctx_deserialize(const bytea *ba)
 		NULL
 	};
 
-	size_t len = VARSIZE_ANY_EXHDR(ba);
-	VectorTile__Tile *tile = vector_tile__tile__unpack(&allocator, len, (uint8_t*)VARDATA(ba));
-	mvt_agg_context *ctx = palloc(sizeof(mvt_agg_context));
 	memset(ctx, 0, sizeof(mvt_agg_context));
-	ctx->tile = tile;
+	allocator.allocator_data = &ctx->arena;
+	ctx->tile = vector_tile__tile__unpack(&allocator, len, (uint8_t*)VARDATA(ba));
 	return ctx;
 }
 
+/* Concatenates two arrays into a new one, as they might live in an arena */
+static void *
+concat_array(const void *a, size_t n_a, const void *b, size_t n_b, size_t size)
+{
+	char *out = palloc((n_a + n_b) * size);
+	memcpy(out, a, n_a * size);
+	memcpy(out + n_a * size, b, n_b * size);
+	return out;
+}
+
+/* Hash table entry of a value being merged, by type and payload */
+struct mvt_kv_merged_value
+{
+	VectorTile__Tile__Value *value;
+	uint32_t id;
+	UT_hash_handle hh;
+};
+
+/* Deduplicated keys and values of a layer being combined */
+typedef struct mvt_layer_merge
+{
+	VectorTile__Tile__Layer *layer;
+	struct mvt_kv_key *keys_hash;
+	struct mvt_kv_key *key_entries;
+	/* One hash table per value type, indexed by the oneof case */
+	struct mvt_kv_merged_value *values_hash[8];
+	struct mvt_kv_merged_value *value_entries;
+} mvt_layer_merge;
+
+/* Returns the bytes identifying a value within its type, NULL if unset */
+static const void *
+vectortile_value_payload(const VectorTile__Tile__Value *value, size_t *size)
+{
+	switch (value->test_oneof_case)
+	{
+	case VECTOR_TILE__TILE__VALUE__TEST_ONEOF_STRING_VALUE:
+		*size = strlen(value->string_value);
+		return value->string_value;
+	case VECTOR_TILE__TILE__VALUE__TEST_ONEOF_FLOAT_VALUE:
+		*size = sizeof(value->float_value);
+		return &value->float_value;
+	case VECTOR_TILE__TILE__VALUE__TEST_ONEOF_DOUBLE_VALUE:
+		*size = sizeof(value->double_value);
+		return &value->double_value;
+	case VECTOR_TILE__TILE__VALUE__TEST_ONEOF_INT_VALUE:
+		*size = sizeof(value->int_value);
+		return &value->int_value;
+	case VECTOR_TILE__TILE__VALUE__TEST_ONEOF_UINT_VALUE:
+		*size = sizeof(value->uint_value);
+		return &value->uint_value;
+	case VECTOR_TILE__TILE__VALUE__TEST_ONEOF_SINT_VALUE:
+		*size = sizeof(value->sint_value);
+		return &value->sint_value;
+	case VECTOR_TILE__TILE__VALUE__TEST_ONEOF_BOOL_VALUE:
+		*size = sizeof(value->bool_value);
+		return &value->bool_value;
+	default:
+		*size = 0;
+		return NULL;
+	}
+}
+
+/* Adds a key to the merged layer if new. Returns its index there */
+static uint32_t
+vectortile_merge_key(mvt_layer_merge *merge, char *name)
+{
+	VectorTile__Tile__Layer *layer = merge->layer;
+	struct mvt_kv_key *kv;
+	size_t size = strlen(name);
+	unsigned hashv;
+
+	HASH_VALUE(name, size, hashv);
+	HASH_FIND_BYHASHVALUE(hh, merge->keys_hash, name, size, hashv, kv);
+	if (kv)
+		return kv->id;
+
+	kv = &merge->key_entries[layer->n_keys];
+	kv->name = name;
+	kv->id = layer->n_keys;
+	layer->keys[layer->n_keys++] = name;
+	HASH_ADD_KEYPTR_BYHASHVALUE(hh, merge->keys_hash, name, size, hashv, kv);
+	return kv->id;
+}
+
+/* Adds a value to the merged layer if new. Returns its index there */
+static uint32_t
+vectortile_merge_value(mvt_layer_merge *merge, VectorTile__Tile__Value *value)
+{
+	VectorTile__Tile__Layer *layer = merge->layer;
+	struct mvt_kv_merged_value *kv = NULL;
+	struct mvt_kv_merged_value **hash;
+	size_t size;
+	const void *payload = vectortile_value_payload(value, &size);
+	unsigned hashv = 0;
+
+	/* Values we cannot compare are kept as they are */
+	if (!payload || (uint32_t)value->test_oneof_case >= 8)
+	{
+		layer->values[layer->n_values] = value;
+		return layer->n_values++;
+	}
+
+	hash = &merge->values_hash[value->test_oneof_case];
+	HASH_VALUE(payload, size, hashv);
+	HASH_FIND_BYHASHVALUE(hh, *hash, payload, size, hashv, kv);
+	if (kv)
+		return kv->id;
+
+	kv = &merge->value_entries[layer->n_values];
+	kv->value = value;
+	kv->id = layer->n_values;
+	layer->values[layer->n_values++] = value;
+	HASH_ADD_KEYPTR_BYHASHVALUE(hh, *hash, payload, size, hashv, kv);
+	return kv->id;
+}
+
+/* Merges the keys and values of a source layer and points the tags of its features to them */
+static void
+vectortile_merge_tags(mvt_layer_merge *merge,
+		      char **keys, size_t n_keys,
+		      VectorTile__Tile__Value **values, size_t n_values,
+		      VectorTile__Tile__Feature **features, size_t n_features)
+{
+	uint32_t *key_map = palloc(sizeof(uint32_t) * (n_keys + 1));
+	uint32_t *value_map = palloc(sizeof(uint32_t) * (n_values + 1));
+	uint32_t i, t;
+
+	for (i = 0; i < n_keys; i++)
+		key_map[i] = vectortile_merge_key(merge, keys[i]);
+	for (i = 0; i < n_values; i++)
+		value_map[i] = vectortile_merge_value(merge, values[i]);
+
+	for (i = 0; i < n_features; i++)
+	{
+		VectorTile__Tile__Feature *feature = features[i];
+		for (t = 0; t + 1 < feature->n_tags; t += 2)
+		{
+			if (feature->tags[t] >= n_keys || feature->tags[t + 1] >= n_values)
+				elog(ERROR, "%s: Invalid tag index in feature", __func__);
+			feature->tags[t] = key_map[feature->tags[t]];
+			feature->tags[t + 1] = value_map[feature->tags[t + 1]];
+		}
+	}
+
+	pfree(key_map);
+	pfree(value_map);
+}
+
 /**
  * Combine 2 layers. This is going to push everything from layer2 into layer1
  * We can do this because both sources and the result live in the same aggregation context
  * so we are good as long as we don't free anything from the sources
  *
- * TODO: Apply hash to remove duplicates (https://trac.osgeo.org/postgis/ticket/4310)
+ * Keys and values present in both layers are stored once, and the tags of
+ * the features are remapped to the merged tables.
  */
 static VectorTile__Tile__Layer *
 vectortile_layer_combine(VectorTile__Tile__Layer *layer, VectorTile__Tile__Layer *layer2)
 {
-	const uint32_t key_offset = layer->n_keys;
-	const uint32_t value_offset = layer->n_values;
-	const uint32_t feature_offset = layer->n_features;
+	mvt_layer_merge merge;
+	char **keys = layer->keys;
+	size_t n_keys = layer->n_keys;
+	VectorTile__Tile__Value **values = layer->values;
+	size_t n_values = layer->n_values;
+	size_t max_keys = n_keys + layer2->n_keys;
+	size_t max_values = n_values + layer2->n_values;
+	uint32_t i;
 
-	if (!layer->n_keys)
-	{
-		layer->keys = layer2->keys;
-		layer->n_keys = layer2->n_keys;
-	}
-	else if (layer2->n_keys)
-	{
-		layer->keys = repalloc(layer->keys, sizeof(char *) * (layer->n_keys + layer2->n_keys));
-		memcpy(&layer->keys[key_offset], layer2->keys, sizeof(char *) * layer2->n_keys);
-		layer->n_keys += layer2->n_keys;
-	}
+	memset(&merge, 0, sizeof(merge));
+	merge.layer = layer;
+	merge.key_entries = palloc(sizeof(*merge.key_entries) * (max_keys + 1));
+	merge.value_entries = palloc(sizeof(*merge.value_entries) * (max_values + 1));
 
-	if (!layer->n_values)
-	{
-		layer->values = layer2->values;
-		layer->n_values = layer2->n_values;
-	}
-	else if (layer2->n_values)
-	{
-		layer->values =
-		    repalloc(layer->values, sizeof(VectorTile__Tile__Value *) * (layer->n_values + layer2->n_values));
-		memcpy(
-		    &layer->values[value_offset], layer2->values, sizeof(VectorTile__Tile__Value *) * layer2->n_values);
-		layer->n_values += layer2->n_values;
-	}
+	layer->keys = palloc(sizeof(char *) * (max_keys + 1));
+	layer->n_keys = 0;
+	layer->values = palloc(sizeof(VectorTile__Tile__Value *) * (max_values + 1));
+	layer->n_values = 0;
+
+	vectortile_merge_tags(&merge, keys, n_keys, values, n_values, layer->features, layer->n_features);
+	vectortile_merge_tags(&merge, layer2->keys, layer2->n_keys, layer2->values, layer2->n_values,
+			      layer2->features, layer2->n_features);
+
+	HASH_CLEAR(hh, merge.keys_hash);
+	for (i = 0; i < 8; i++)
+		HASH_CLEAR(hh, merge.values_hash[i]);
+	pfree(merge.key_entries);
+	pfree(merge.value_entries);
 
 	if (!layer->n_features)
 	{
@@ -1177,25 +1446,14 @@ vectortile_layer_combine(VectorTile__Tile__Layer *layer, VectorTile__Tile__Layer
 	}
 	else if (layer2->n_features)
 	{
-		layer->features = repalloc(
-		    layer->features, sizeof(VectorTile__Tile__Feature *) * (layer->n_features + layer2->n_features));
-		memcpy(&layer->features[feature_offset], layer2->features, sizeof(char *) * layer2->n_features);
+		layer->features = concat_array(layer->features, layer->n_features,
+		    layer2->features, layer2->n_features, sizeof(VectorTile__Tile__Feature *));
 		layer->n_features += layer2->n_features;
-		/* We need to adapt the indexes of the copied features */
-		for (uint32_t i = feature_offset; i < layer->n_features; i++)
-		{
-			for (uint32_t t = 0; t < layer->features[i]->n_tags; t += 2)
-			{
-				layer->features[i]->tags[t] += key_offset;
-				layer->features[i]->tags[t + 1] += value_offset;
-			}
-		}
 	}
 
 	return layer;
 }
 
-
 static VectorTile__Tile *
 vectortile_tile_combine(VectorTile__Tile *tile1, VectorTile__Tile *tile2)
 {
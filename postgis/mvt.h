@@ -54,6 +54,14 @@ typedef struct mvt_column_cache
     TupleDesc tupdesc;
 } mvt_column_cache;
 
+/* Bump allocator handing out the many small arrays of a tile from larger chunks */
+typedef struct mvt_arena
+{
+	char *chunk;
+	size_t used;
+	size_t size;
+} mvt_arena;
+
 typedef struct mvt_agg_context
 {
 	/* Temporal memory context using during during pgis_asmvt_transfn and deleted after
@@ -95,6 +103,13 @@ typedef struct mvt_agg_context
 
 	uint32_t row_columns;
 	mvt_column_cache column_cache;
+
+	/* Tags of the row being parsed, copied to the feature once complete */
+	uint32_t *tags;
+	uint32_t tags_capacity;
+
+	/* Feature structs, geometry commands and tags of the tile */
+	mvt_arena arena;
 } mvt_agg_context;
 
 /* Prototypes */
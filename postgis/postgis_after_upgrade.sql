@@ -244,6 +244,16 @@ IF _postgis_scripts_pgsql_version()::integer >= 96 THEN
         EXCEPTION WHEN OTHERS THEN
             RAISE DEBUG 'Could not update st_union(geometry): %', SQLERRM;
         END;
+-- let ST_Union agg run partial unions in parallel workers
+        BEGIN
+            UPDATE pg_aggregate SET
+                aggcombinefn = 'pgis_geometry_union_combinefn'::regproc,
+                aggserialfn = 'pgis_geometry_union_serialfn'::regproc,
+                aggdeserialfn = 'pgis_geometry_union_deserialfn'::regproc
+            WHERE aggfnoid = 'st_union(geometry)'::regprocedure AND aggcombinefn::oid = 0;
+        EXCEPTION WHEN OTHERS THEN
+            RAISE DEBUG 'Could not update st_union(geometry): %', SQLERRM;
+        END;
 END IF;
 END;
 $$;
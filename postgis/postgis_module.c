@@ -33,6 +33,7 @@
 
 #include "lwgeom_log.h"
 #include "lwgeom_pg.h"
+#include "lwgeom_transform.h"
 #include "geos_c.h"
 
 #ifdef HAVE_LIBPROTOBUF
@@ -70,6 +71,51 @@ _PG_init(void)
 
   /* install PostgreSQL handlers */
   pg_install_lwgeom_handlers();
+
+  /* Define custom GUC variables. */
+  if ( postgis_guc_find_option("postgis.proj_cache_size") )
+  {
+    /* In this narrow case the previously installed GUC is tied to the */
+    /* previously loaded library. Probably this is happening during an upgrade. */
+    elog(WARNING, "'%s' is already set and cannot be changed until you reconnect", "postgis.proj_cache_size");
+  }
+  else
+  {
+    DefineCustomIntVariable(
+      "postgis.proj_cache_size", /* name */
+      "Number of PROJ transformations cached per backend.", /* short_desc */
+      "Least recently used transformations are dropped when the cache is full.", /* long_desc */
+      &postgis_proj_cache_size, /* valueAddr */
+      PROJ_CACHE_ITEMS, /* bootValue */
+      1, /* minValue */
+      65536, /* maxValue */
+      PGC_USERSET, /* GucContext context */
+      0, /* int flags */
+      NULL, /* GucIntCheckHook check_hook */
+      NULL, /* GucIntAssignHook assign_hook */
+      NULL  /* GucShowHook show_hook */
+    );
+  }
+
+  if ( postgis_guc_find_option("postgis.proj_prewarm") )
+  {
+    elog(WARNING, "'%s' is already set and cannot be changed until you reconnect", "postgis.proj_prewarm");
+  }
+  else
+  {
+    DefineCustomStringVariable(
+      "postgis.proj_prewarm", /* name */
+      "SRID pairs to build PROJ transformations for in advance.", /* short_desc */
+      "Comma separated list of srid_from:srid_to pairs, all built on the first transformation in a backend.", /* long_desc */
+      &postgis_proj_prewarm, /* valueAddr */
+      "", /* bootValue */
+      PGC_USERSET, /* GucContext context */
+      0, /* int flags */
+      postgis_proj_prewarm_check, /* GucStringCheckHook check_hook */
+      NULL, /* GucStringAssignHook assign_hook */
+      NULL  /* GucShowHook show_hook */
+    );
+  }
 }
 
 /*
@@ -158,6 +158,44 @@ select 'E1', id, bool_1, ST_AsText(geom), bool_2 from ST_FromFlatGeobuf(null::fl
     ) q)
 );
 
+select '--- Bounding box filter ---';
+
+-- without index, features are filtered while scanning
+select 'B1', count(*), min(ST_X(geom)), max(ST_X(geom)) from ST_FromFlatGeobuf(null::flatgeobuf_t1, (
+    select ST_AsFlatGeobuf(q) fgb from (select ST_MakePoint(i, i) from generate_series(1, 100) i) q),
+    'BOX(10 10,20.5 20.5)'::box2d
+);
+-- with index, only matching features are decoded
+select 'B2', count(*), min(ST_X(geom)), max(ST_X(geom)) from ST_FromFlatGeobuf(null::flatgeobuf_t1, (
+    select ST_AsFlatGeobuf(q, true) fgb from (select ST_MakePoint(i, i) from generate_series(1, 100) i) q),
+    'BOX(10 10,20.5 20.5)'::box2d
+);
+-- nothing matches
+select 'B3', count(*) from ST_FromFlatGeobuf(null::flatgeobuf_t1, (
+    select ST_AsFlatGeobuf(q, true) fgb from (select ST_MakePoint(i, i) from generate_series(1, 100) i) q),
+    'BOX(200 200,300 300)'::box2d
+);
+-- null box reads everything
+select 'B4', count(*) from ST_FromFlatGeobuf(null::flatgeobuf_t1, (
+    select ST_AsFlatGeobuf(q, true) fgb from (select ST_MakePoint(i, i) from generate_series(1, 100) i) q),
+    null::box2d
+);
+
+select '--- File input ---';
+
+select 'F0', lo_export(o, :tmpfile), lo_unlink(o) from lo_from_bytea(0, (
+    select ST_AsFlatGeobuf(q, true) fgb from (select ST_MakePoint(i, i) from generate_series(1, 100) i) q)) o;
+select 'F1', count(*) from ST_FromFlatGeobufFile(null::flatgeobuf_t1, :tmpfile);
+select 'F2', count(*), min(ST_X(geom)), max(ST_X(geom)) from ST_FromFlatGeobufFile(null::flatgeobuf_t1, :tmpfile,
+    'BOX(10 10,20.5 20.5)'::box2d
+);
+-- empty file has no features
+select 'F3', lo_export(o, :tmpfile), lo_unlink(o) from lo_from_bytea(0, ''::bytea) o;
+select 'F4', count(*) from ST_FromFlatGeobufFile(null::flatgeobuf_t1, :tmpfile);
+-- file shorter than the magic bytes
+select 'F5', lo_export(o, :tmpfile), lo_unlink(o) from lo_from_bytea(0, '\x6667'::bytea) o;
+select 'F6', count(*) from ST_FromFlatGeobufFile(null::flatgeobuf_t1, :tmpfile);
+
 drop table if exists public.flatgeobuf_t1;
 drop table if exists public.flatgeobuf_a1;
 drop table if exists public.flatgeobuf_e1;
@@ -124,3 +124,17 @@ select 'dwithin_poly_line_1', ST_DWithin('POLYGON((1 1, 2 2, 3 0, 1 1))'::geogra
 select 'dwithin_poly_poly_1', ST_DWithin('POLYGON((0 0, -2 -2, -3 0, 0 0))'::geography, 'POLYGON((1 1, 2 2, 3 0, 1 1))'::geography, 10);
 select 'dwithin_poly_poly_2', ST_DWithin('POLYGON((0 0, -2 -2, -3 0, 0 0))'::geography, 'POLYGON((1 1, 2 2, 3 0, 1 1))'::geography, 300000);
 select 'dwithin_poly_poly_3', ST_DWithin('POLYGON((1 1, -2 -2, -3 0, 1 1))'::geography, 'POLYGON((1 1, 2 2, 3 0, 1 1))'::geography, 300000);
+-- Stored circular trees
+select 'circtree_poly_line', ST_Distance(a, ST_CircTree(a), b, ST_CircTree(b)) = _ST_DistanceTree(a, b) from (select 'POLYGON((0 0, -2 -2, -3 0, 0 0))'::geography a, 'LINESTRING(1 1, 2 2, 3 0)'::geography b) t;
+select 'circtree_one_side', ST_Distance(a, ST_CircTree(a), b, NULL) = _ST_DistanceTree(a, b) from (select 'MULTIPOLYGON(((0 0, -2 -2, -3 0, 0 0)),((10 10, 11 11, 12 10, 10 10)))'::geography a, 'POINT(5 5)'::geography b) t;
+select 'circtree_inside', ST_Distance(a, ST_CircTree(a), b, ST_CircTree(b)) from (select 'POLYGON((0 0, 0 10, 10 10, 10 0, 0 0))'::geography a, 'POINT(5 5)'::geography b) t;
+select 'circtree_dwithin', ST_DWithin(a, ST_CircTree(a), b, ST_CircTree(b), 300000), ST_DWithin(a, ST_CircTree(a), b, ST_CircTree(b), 10) from (select 'POLYGON((0 0, -2 -2, -3 0, 0 0))'::geography a, 'POLYGON((1 1, 2 2, 3 0, 1 1))'::geography b) t;
+select 'circtree_empty', ST_CircTree('POINT EMPTY'::geography) IS NULL;
+select 'circtree_other_count', ST_Distance(a, ST_CircTree('LINESTRING(0 0, 1 1, 2 2)'::geography), b, NULL) from (select 'LINESTRING(0 0, 2 2)'::geography a, 'POINT(5 5)'::geography b) t;
+select 'circtree_other_box', ST_Distance(a, ST_CircTree('LINESTRING(0 0, 2 3)'::geography), b, NULL) from (select 'LINESTRING(0 0, 2 2)'::geography a, 'POINT(5 5)'::geography b) t;
+select 'circtree_other_interior', ST_Distance(a, ST_CircTree('LINESTRING(0 0, 1 0.5, 2 2)'::geography), b, NULL) from (select 'LINESTRING(0 0, 1 1, 2 2)'::geography a, 'POINT(5 5)'::geography b) t;
+-- Pairwise dwithin over two sets
+select 'dwithin_pairs', idx1, idx2 from ST_DWithinPairs(ARRAY['POINT(0 0)','POINT(10 10)',NULL,'POLYGON((20 20,20 30,30 30,30 20,20 20))','POINT EMPTY']::geography[], ARRAY['POINT(0 0.001)','POINT(25 25)','POINT(50 50)','LINESTRING(9.999 10,10 11)']::geography[], 1000) order by 2, 3;
+select 'dwithin_pairs_none', count(*) from ST_DWithinPairs(ARRAY['POINT(0 0)']::geography[], ARRAY['POINT(0 0.001)']::geography[], 10);
+select 'dwithin_pairs_empty', count(*) from ST_DWithinPairs(ARRAY[]::geography[], ARRAY['POINT(0 0)']::geography[], 10);
+select 'dwithin_pairs_nulls', count(*) from ST_DWithinPairs(ARRAY['POINT(0 0)']::geography[], ARRAY[NULL, NULL]::geography[], 10);
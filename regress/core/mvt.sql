@@ -418,6 +418,43 @@ SELECT 'PG64', ST_AsText(ST_AsMVTGeom(
 	ST_MakeBox2D(ST_Point(0, 0), ST_Point(100, 100)),
 	100, 0, true));
 
+-- Point and line clipping on the tile grid
+SELECT 'PG65', ST_AsText(ST_AsMVTGeom(
+	ST_GeomFromText('LINESTRING(-5 5, 15 5)'),
+	ST_MakeBox2D(ST_Point(0, 0), ST_Point(10, 10)),
+	10, 0, true));
+
+SELECT 'PG66', ST_AsText(ST_AsMVTGeom(
+	ST_GeomFromText('LINESTRING(-5 2, 5 2, 5 15, 5 -15)'),
+	ST_MakeBox2D(ST_Point(0, 0), ST_Point(10, 10)),
+	10, 0, true));
+
+SELECT 'PG67', ST_AsText(ST_AsMVTGeom(
+	ST_GeomFromText('MULTIPOINT(1 1, -1 1, 5 5, 11 0)'),
+	ST_MakeBox2D(ST_Point(0, 0), ST_Point(10, 10)),
+	10, 0, true));
+
+SELECT 'PG68', ST_AsText(ST_AsMVTGeom(
+	ST_GeomFromText('LINESTRING(-5 -5, 15 15)'),
+	ST_MakeBox2D(ST_Point(0, 0), ST_Point(10, 10)),
+	10, 1, true));
+
+SELECT 'PG69', ST_AsText(ST_AsMVTGeom(
+	ST_GeomFromText('LINESTRING(-3 7, 3 13)'),
+	ST_MakeBox2D(ST_Point(0, 0), ST_Point(10, 10)),
+	10, 0, true));
+
+-- Points and line pieces on the buffer edge are kept
+SELECT 'PG70', ST_AsText(ST_AsMVTGeom(
+	ST_GeomFromText('MULTIPOINT(0 1, 5 5, 11 0)'),
+	ST_MakeBox2D(ST_Point(0, 0), ST_Point(10, 10)),
+	10, 0, true));
+
+SELECT 'PG71', ST_AsText(ST_AsMVTGeom(
+	ST_GeomFromText('LINESTRING(0 12, 0 5, 5 5)'),
+	ST_MakeBox2D(ST_Point(0, 0), ST_Point(10, 10)),
+	10, 0, true));
+
 -- geometry encoding tests
 SELECT 'TG1', encode(ST_AsMVT(q, 'test', 4096, 'geom'), 'base64') FROM (SELECT 1 AS c1,
 	ST_AsMVTGeom(ST_GeomFromText('POINT(25 17)'),
@@ -734,3 +771,66 @@ WITH geom AS (
 	SELECT 3 as id, 'TRIANGLE EMPTY'::geometry geom
 )
 select '#4399', id, 'ST_AsMVTGeom', ST_AsText(ST_AsMVTGeom(geom, ST_MakeBox2D(ST_Point(0, 0), ST_Point(32, 32))))::text from geom order by id asc;
+
+-- ST_AsMVTPyramid
+SELECT 'PY1', p.zoom, p.x, p.y, p.mvt = ST_AsMVT(f, 'test', 4096, 'geom')
+FROM ST_AsMVTPyramid('SELECT 1 AS id, ''POINT(10 10)''::geometry AS geom UNION ALL SELECT 2, NULL::geometry',
+	0, 2, ST_MakeEnvelope(-100, -100, 100, 100, 0), 'test') p,
+LATERAL (SELECT ST_AsMVTGeom('POINT(10 10)'::geometry, ST_TileEnvelope(p.zoom, p.x, p.y, ST_MakeEnvelope(-100, -100, 100, 100, 0))::box2d) AS geom,
+	'{"id": 1}'::jsonb AS attributes) f
+GROUP BY p.zoom, p.x, p.y, p.mvt ORDER BY 2, 3, 4;
+
+-- Parallel aggregation stores the keys and values shared by the partial tiles once
+CREATE TABLE mvt_parallel AS
+SELECT i AS id, 'v' || (i % 3) AS a, i % 2 AS b, ST_Point(i % 64, i / 64) AS geom
+FROM generate_series(0, 4095) AS i;
+ANALYZE mvt_parallel;
+
+SET max_parallel_workers_per_gather = 0;
+CREATE TABLE mvt_parallel_serial AS
+SELECT length(ST_AsMVT(q, 'test', 4096, 'geom')) AS len FROM (
+	SELECT a, b, ST_AsMVTGeom(geom, ST_MakeBox2D(ST_Point(0, 0), ST_Point(64, 64)), 4096, 0, false) AS geom
+	FROM mvt_parallel) AS q;
+
+SET parallel_setup_cost = 0;
+SET parallel_tuple_cost = 0;
+SET min_parallel_table_scan_size = 0;
+SET max_parallel_workers_per_gather = 2;
+
+-- the aggregate must actually be split across workers
+CREATE FUNCTION mvt_parallel_nodes(q text) RETURNS text
+LANGUAGE 'plpgsql' AS
+$$
+DECLARE
+  exp TEXT;
+  mat TEXT[];
+  ret TEXT[];
+BEGIN
+  FOR exp IN EXECUTE 'EXPLAIN ' || q
+  LOOP
+    mat := regexp_matches(exp, ' *(?:-> *)?(Finalize Aggregate|Gather|Partial Aggregate|Parallel Seq Scan)');
+    IF mat IS NOT NULL THEN
+      ret := array_append(ret, mat[1]);
+    END IF;
+  END LOOP;
+  RETURN array_to_string(ret,',');
+END;
+$$;
+
+SELECT 'TP0', mvt_parallel_nodes($$
+SELECT ST_AsMVT(q, 'test', 4096, 'geom') FROM (
+	SELECT a, b, ST_AsMVTGeom(geom, ST_MakeBox2D(ST_Point(0, 0), ST_Point(64, 64)), 4096, 0, false) AS geom
+	FROM mvt_parallel) AS q$$);
+
+SELECT 'TP1', length(ST_AsMVT(q, 'test', 4096, 'geom')) = (SELECT len FROM mvt_parallel_serial) FROM (
+	SELECT a, b, ST_AsMVTGeom(geom, ST_MakeBox2D(ST_Point(0, 0), ST_Point(64, 64)), 4096, 0, false) AS geom
+	FROM mvt_parallel) AS q;
+
+RESET max_parallel_workers_per_gather;
+RESET min_parallel_table_scan_size;
+RESET parallel_tuple_cost;
+RESET parallel_setup_cost;
+
+DROP FUNCTION mvt_parallel_nodes(text);
+DROP TABLE mvt_parallel_serial;
+DROP TABLE mvt_parallel;
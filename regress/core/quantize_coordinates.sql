@@ -11,4 +11,28 @@ SELECT 't5', ST_X(ST_QuantizeCoordinates('POINT (1.2345678 1.2345678)', 7, 4)) !
 -- Significant digits are preserved
 WITH input AS (SELECT ST_MakePoint(1.23456789012345, 0) AS geom)
 SELECT 't6', bool_and(abs(ST_X(geom)-ST_X(ST_QuantizeCoordinates(geom, i))) < pow(10, -i))
-FROM input, generate_series(1,15) AS i
+FROM input, generate_series(1,15) AS i;
+-- Compact storage snaps to the grid
+SELECT 't7', ST_AsEWKT(ST_CompactStorage('SRID=4326;LINESTRING(1.23456 2.34567,3 4)', 2));
+-- Compact storage is smaller and reads back equal
+WITH input AS (SELECT ST_MakeLine(ST_MakePoint((-7100000 + i) / 100000.0, (4200000 + i % 7) / 100000.0)) AS geom FROM generate_series(1, 1000) AS i)
+SELECT 't8', ST_MemSize(ST_CompactStorage(geom, 5)) * 2 < ST_MemSize(geom), ST_CompactStorage(geom, 5) = geom,
+	ST_Equals(ST_CompactStorage(geom, 5), geom), ST_CompactStorage(geom, 5) ~= geom
+FROM input;
+-- Point accessors and operators work on compact storage
+SELECT 't9', ST_X(g), ST_Y(g), ST_SRID(g), g && 'POINT(10.5 -4.25)'::geometry
+FROM (SELECT ST_CompactStorage('SRID=3857;POINT(10.5 -4.25)', 3) AS g) AS q;
+-- Precision out of range
+SELECT 't10', ST_CompactStorage('POINT (3 7)', 16);
+-- Compact points are smaller and their box is read in place
+SELECT 't11', ST_MemSize(g), ST_MemSize(ST_CompactStorage(g, 7)),
+	ST_CompactStorage(g, 7) && ST_MakeEnvelope(-72, 42, -71, 43, 4326),
+	ST_CompactStorage(g, 7) && ST_MakeEnvelope(-71, 42, -70, 43, 4326)
+FROM (SELECT 'SRID=4326;POINT(-71.0638213 42.3582145)'::geometry AS g) AS q;
+CREATE TABLE quantize_points AS
+SELECT i, ST_CompactStorage(ST_MakePoint(i / 10.0, i / 10.0), 1) AS g FROM generate_series(1, 100) AS i;
+CREATE INDEX ON quantize_points USING GIST (g);
+SET enable_seqscan = off;
+SELECT 't12', count(*) FROM quantize_points WHERE g && ST_MakeEnvelope(0, 0, 5, 5);
+RESET enable_seqscan;
+DROP TABLE quantize_points;
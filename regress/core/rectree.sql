@@ -0,0 +1,36 @@
+-- The rect tree functions keep trees for both arguments, so run them
+-- over a join where each side repeats and compare with the plain path
+CREATE TABLE rectree_a AS
+	SELECT i AS id, ST_Buffer(ST_MakePoint(i * 10, i * 3), 4 + i % 3, 4) AS geom
+	FROM generate_series(1, 12) i
+	UNION ALL
+	SELECT 100 + i, ST_MakeLine(ST_MakePoint(i * 7, 0), ST_MakePoint(i * 9, 40))
+	FROM generate_series(1, 12) i;
+CREATE TABLE rectree_b AS
+	SELECT i AS id, ST_Buffer(ST_MakePoint(i * 8 + 1, 20 - i), 2, 2) AS geom
+	FROM generate_series(1, 12) i
+	UNION ALL
+	SELECT 100 + i, ST_Segmentize(ST_MakeLine(ST_MakePoint(0, i * 5), ST_MakePoint(120, i * 4)), 10)
+	FROM generate_series(1, 12) i
+	UNION ALL
+	SELECT 200 + i, ST_MakePoint(i * 10, i * 3)
+	FROM generate_series(1, 12) i;
+
+SELECT 'distance', count(*)
+FROM rectree_a a, rectree_b b
+WHERE abs(_ST_DistanceRectTreeCached(a.geom, b.geom) - ST_Distance(a.geom, b.geom)) > 1e-9;
+
+SELECT 'dwithin', t,
+	count(*) FILTER (WHERE _ST_DWithinRectTreeCached(a.geom, b.geom, t) != ST_DWithin(a.geom, b.geom, t)),
+	count(*) FILTER (WHERE _ST_DWithinRectTreeCached(a.geom, b.geom, t)) > 0
+FROM rectree_a a, rectree_b b, (VALUES (0.0), (1.5), (6.0)) AS v(t)
+GROUP BY t ORDER BY t;
+
+SELECT 'contained', _ST_DistanceRectTreeCached('POLYGON((0 0,10 0,10 10,0 10,0 0))', 'LINESTRING(2 2,3 3)'),
+	_ST_DWithinRectTreeCached('LINESTRING(2 2,3 3)', 'POLYGON((0 0,10 0,10 10,0 10,0 0))', 0);
+SELECT 'empty', _ST_DistanceRectTreeCached('POINT EMPTY', 'POINT(0 0)') IS NULL,
+	_ST_DWithinRectTreeCached('POINT EMPTY', 'POINT(0 0)', 1);
+SELECT 'srid', _ST_DWithinRectTreeCached('SRID=4326;POINT(0 0)', 'SRID=3857;POINT(1 1)', 1);
+
+DROP TABLE rectree_a;
+DROP TABLE rectree_b;
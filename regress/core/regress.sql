@@ -282,6 +282,19 @@ select '252', ST_AsText(ST_TileEnvelope(10,300,387, margin => 0.5), 2);
 select '253', ST_AsText(ST_TileEnvelope(10,300,387, margin => 2), 2);
 select '254', ST_AsText(ST_TileEnvelope(10,300,387, margin => -0.3), 2);
 
+-- ST_TileCover()
+select '255', string_agg(format('%s/%s/%s', zoom, x, y), ',' order by zoom, x, y) from ST_TileCover('POINT(10 10)', 0, 2, ST_MakeEnvelope(-100, -100, 100, 100, 0));
+select '256', string_agg(format('%s/%s/%s', zoom, x, y), ',' order by zoom, x, y) from ST_TileCover('POINT(0 0)', 1, 1, ST_MakeEnvelope(-100, -100, 100, 100, 0));
+select '257', string_agg(format('%s/%s/%s', zoom, x, y), ',' order by zoom, x, y) from ST_TileCover('LINESTRING(-90 -90, -60 -70)', 2, 3, ST_MakeEnvelope(-100, -100, 100, 100, 0));
+select '258', string_agg(format('%s/%s/%s', zoom, x, y), ',' order by zoom, x, y) from ST_TileCover('POINT(10 10)', 2, 2, ST_MakeEnvelope(-100, -100, 100, 100, 0), margin => 0.25);
+select '259', count(*) from ST_TileCover('POINT(10 10)', 2, 2, ST_MakeEnvelope(-100, -100, 100, 100, 0), margin => -0.25);
+select '260', count(*) from ST_TileCover('POLYGON((-50 -50,50 -50,50 50,-50 50,-50 -50))', 1, 5, ST_MakeEnvelope(-100, -100, 100, 100, 0));
+select '261', count(*) from ST_TileCover('POINT(500 500)', 0, 4, ST_MakeEnvelope(-100, -100, 100, 100, 0));
+select '262', count(*) from ST_TileCover('POINT EMPTY', 0, 4, ST_MakeEnvelope(-100, -100, 100, 100, 0));
+select '263', count(*) from ST_TileCover('POINT(0 0)', 0, 31);
+select '264', count(*) from ST_TileCover('POINT(0 0)', 3, 2);
+select '265', count(*) from ST_TileCover('POINT(0 0)', 0, 32);
+
 -- ST_Hexagon()
 select '300', ST_AsText(ST_Hexagon(10, 0, 0), 5);
 select '301', ST_AsText(ST_Hexagon(10, 1, 1), 5);
@@ -292,3 +292,17 @@ SELECT 'covers311', ST_Covers('POLYGON((0 0, 0 10, 10 10, 10 0, 0 0))', p) FROM
 ('LINESTRING(1 10, 10 10, 10 8)'),('LINESTRING(1 10, 10 10, 10 8)'),('LINESTRING(1 10, 10 10, 10 8)')
 ) AS v(p);
 
+
+-- Overlays and buffer reuse the GEOS conversion of a repeated argument
+SELECT 'intersection320', ST_Area(ST_Intersection('POLYGON((0 0, 0 10, 10 10, 10 0, 0 0))', p)) FROM ( VALUES
+('POLYGON((5 5, 5 15, 15 15, 15 5, 5 5))'),('POLYGON((8 8, 8 18, 18 18, 18 8, 8 8))'),('POLYGON((-2 -2, -2 2, 2 2, 2 -2, -2 -2))')
+) AS v(p);
+SELECT 'difference320', ST_Area(ST_Difference(p, 'POLYGON((0 0, 0 10, 10 10, 10 0, 0 0))')) FROM ( VALUES
+('POLYGON((5 5, 5 15, 15 15, 15 5, 5 5))'),('POLYGON((8 8, 8 18, 18 18, 18 8, 8 8))'),('POLYGON((-2 -2, -2 2, 2 2, 2 -2, -2 -2))')
+) AS v(p);
+SELECT 'symdifference320', ST_Area(ST_SymDifference('POLYGON((0 0, 0 10, 10 10, 10 0, 0 0))', p)) FROM ( VALUES
+('POLYGON((5 5, 5 15, 15 15, 15 5, 5 5))'),('POLYGON((8 8, 8 18, 18 18, 18 8, 8 8))'),('POLYGON((-2 -2, -2 2, 2 2, 2 -2, -2 -2))')
+) AS v(p);
+SELECT 'buffer320', ST_Area(ST_Buffer('POLYGON((0 0, 0 10, 10 10, 10 0, 0 0))', d, 'join=mitre')) FROM ( VALUES
+(1),(2),(0)
+) AS v(d);
@@ -28,3 +28,8 @@ SELECT 'M2', ST_AsText(ST_SnapToGrid(st_transform('SRID=4326;POINT(-20 -21.5)'::
 SELECT 'M3', ST_AsText(ST_SnapToGrid(st_transform('SRID=4326;POINT(-30 -21.5)'::geometry, 3857),1));
 SELECT 'M4', ST_AsText(ST_SnapToGrid(st_transform('SRID=4326;POINT(-72.345 41.3)'::geometry, 3857),1));
 SELECT 'M5', ST_AsText(ST_SnapToGrid(st_transform('SRID=4326;POINT(71.999 -42.5)'::geometry, 3857),1));
+
+-- ST_TransformArray
+SELECT 'A1', ST_AsEWKT(ST_SnapToGrid(g,1)) FROM unnest(ST_TransformArray(ARRAY['SRID=4326;POINT(-20 -20)'::geometry, NULL, 'SRID=3857;POINT(1 2)', 'SRID=4326;LINESTRING(-20 -21.5,-30 -21.5)', 'SRID=4326;POINT EMPTY'], 3857)) g;
+SELECT 'A2', ST_TransformArray('{}'::geometry[], 3857);
+SELECT 'A3', ST_TransformArray(ARRAY['POINT(0 0)'::geometry], 3857);
@@ -5,3 +5,17 @@ SELECT 13, count(*) FROM
     FROM
         ( Select srid from spatial_ref_sys where srid IN (3819,  3821,  3824,  3889,  3906,  4001,  4002,  4003,  4004,  4005,  4006,  4007,  4008,  4009,  4010,  4011,  4012,  4013,  4014,  4015,  4016,  4018,  4019,  4020,  4021,  4022,  4023,  4024,  4025,  4027,  4028,  4029,  4030,  4031,  4032,  4033,  4034,  4035,  4036,  4041,  4042,  4043,  4044,  4045,  4046,  4047,  4052,  4053,  4054,  4055,  4075,  4081,  4120,  4121,  4122,  4123,  4124,  4125,  4126,  4127,  4128,  4129,  4130,  4131,  4132,  4133,  4134,  4135,  4139,  4140,  4141,  4142,  4143,  4144,  4145,  4146,  4147,  4148,  4149,  4150,  4151,  4152,  4153,  4154,  4155,  4156,  4157,  4158,  4159,  4160,  4161,  4162,  4163,  4164,  4165,  4166,  4167,  4168,  4169,  4170,  4171,  4172,  4173,  4174,  4175,  4176,  4178,  4179,  4180,  4181,  4182,  4183,  4184,  4185,  4188,  4189,  4190,  4191,  4192,  4193,  4194,  4195,  4196,  4197,  4198,  4199,  4200,  4201,  4202,  4203,  4204,  4205,  4206,  4207,  4208,  4209,  4210,  4211,  4212,  4213,  4214,  4215,  4216,  4218,  4219,  4220,  4221)) _a
 ) _b WHERE g IS NOT NULL;
+
+--- Tiny LRU cache
+SET postgis.proj_cache_size = 2;
+SELECT 14, count(*) FROM
+(
+    SELECT ST_Transform('SRID=4326; POINT(0 0)'::geometry, srid) AS g
+    FROM spatial_ref_sys WHERE srid IN (3857, 3395, 32633, 32634, 3857, 3395)
+) _a WHERE g IS NOT NULL;
+RESET postgis.proj_cache_size;
+
+--- Prewarm list syntax
+SET postgis.proj_prewarm = '4326:3857, 4326:32633';
+SET postgis.proj_prewarm = '4326:3857 x';
+RESET postgis.proj_prewarm;
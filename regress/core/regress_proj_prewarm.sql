@@ -0,0 +1,9 @@
+--- Pairs that cannot be built are skipped with a warning, the others are built
+SET postgis.proj_prewarm = '4326:3857, 4326:10, 4326:32633';
+SELECT 1, ST_SRID(g), ST_X(g)::int, ST_Y(g)::int
+FROM ST_Transform('SRID=4326;POINT(0 0)'::geometry, 3857) g;
+
+--- Pre-warming only happens once per backend
+SELECT 2, ST_SRID(g), ST_X(g)::int, ST_Y(g)::int
+FROM ST_Transform('SRID=4326;POINT(15 0)'::geometry, 32633) g;
+RESET postgis.proj_prewarm;
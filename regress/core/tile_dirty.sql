@@ -0,0 +1,36 @@
+-- postgis_tile_dirty_trigger records the tiles touched by modified rows
+CREATE TABLE tile_dirty_roads (id integer PRIMARY KEY, name text, geom geometry);
+CREATE TABLE tile_dirty_tiles (zoom integer, x integer, y integer, PRIMARY KEY (zoom, x, y));
+CREATE TRIGGER tile_dirty_roads_trigger
+	AFTER INSERT OR UPDATE OR DELETE ON tile_dirty_roads
+	FOR EACH ROW EXECUTE PROCEDURE postgis_tile_dirty_trigger('tile_dirty_tiles', 'geom', 0, 2);
+
+INSERT INTO tile_dirty_roads VALUES (1, 'a', 'SRID=3857;LINESTRING(1000 1000, 2000 2000)');
+SELECT 'insert', string_agg(format('%s/%s/%s', zoom, x, y), ',' ORDER BY zoom, x, y) FROM tile_dirty_tiles;
+
+-- Same tiles again are only recorded once
+INSERT INTO tile_dirty_roads VALUES (2, 'b', 'SRID=3857;LINESTRING(1500 1500, 1600 1600)');
+SELECT 'insert_same', count(*) FROM tile_dirty_tiles;
+
+-- Both the old and the new position are dirty
+TRUNCATE tile_dirty_tiles;
+UPDATE tile_dirty_roads SET geom = 'SRID=3857;LINESTRING(-1000 -1000, -2000 -2000)' WHERE id = 1;
+SELECT 'update_geom', string_agg(format('%s/%s/%s', zoom, x, y), ',' ORDER BY zoom, x, y) FROM tile_dirty_tiles;
+
+TRUNCATE tile_dirty_tiles;
+UPDATE tile_dirty_roads SET name = 'c' WHERE id = 1;
+SELECT 'update_attr', string_agg(format('%s/%s/%s', zoom, x, y), ',' ORDER BY zoom, x, y) FROM tile_dirty_tiles;
+
+TRUNCATE tile_dirty_tiles;
+DELETE FROM tile_dirty_roads WHERE id = 1;
+SELECT 'delete', string_agg(format('%s/%s/%s', zoom, x, y), ',' ORDER BY zoom, x, y) FROM tile_dirty_tiles;
+
+TRUNCATE tile_dirty_tiles;
+INSERT INTO tile_dirty_roads VALUES (3, 'd', NULL);
+SELECT 'insert_null', count(*) FROM tile_dirty_tiles;
+
+INSERT INTO tile_dirty_roads VALUES (4, 'e', 'POINT(1000 1000)');
+SELECT 'insert_srid0', count(*) FROM tile_dirty_tiles;
+
+DROP TABLE tile_dirty_roads;
+DROP TABLE tile_dirty_tiles;
@@ -72,4 +72,11 @@ select 'Removing of duplicate points LINESTRING', encode(st_astwkb('LINESTRING(1
 select 'Removing of duplicate points POLYGON', encode(st_astwkb('POLYGON((1 1,0.6 2.2, 1.2 1.7, 2 2, 2 1, 1 1))'::geometry), 'hex');
 
 -- Not removing from multipoint
-select 'Not Removing from MULTIPOINT',encode(st_astwkb('MULTIPOINT(1 1, 2 2, 2 2, 3 1)'::geometry), 'hex');
\ No newline at end of file
+select 'Not Removing from MULTIPOINT',encode(st_astwkb('MULTIPOINT(1 1, 2 2, 2 2, 3 1)'::geometry), 'hex');
+-- Streaming aggregate gives the same output as the array form
+select 'ST_AsTWKBAgg points', ST_AsTWKBAgg(g, id order by id) = ST_AsTWKB(array_agg(g order by id), array_agg(id order by id))
+from (select ST_MakePoint(i, i % 7) g, i::bigint id from generate_series(1, 500) i) foo;
+select 'ST_AsTWKBAgg mixed', ST_AsTWKBAgg(g, id, 1, 0, 0, true, true order by id) = ST_AsTWKB(array_agg(g order by id), array_agg(id order by id), 1, 0, 0, true, true)
+from (select ('POINT(' || i || ' 1)')::geometry g, i::bigint id from generate_series(1, 3) i
+	union all select 'LINESTRING(1 1,2 2.55)'::geometry, 4
+	union all select 'POINT EMPTY'::geometry, 5) foo;
@@ -0,0 +1,23 @@
+-- ST_Union aggregate with partial unions computed in parallel workers
+CREATE TABLE union_parallel AS
+SELECT i, ST_MakeEnvelope(i % 100, i / 100, i % 100 + 2, i / 100 + 2) AS geom
+FROM generate_series(0, 9999) AS i;
+INSERT INTO union_parallel VALUES (10000, NULL), (10001, 'POLYGON EMPTY');
+ANALYZE union_parallel;
+
+SET parallel_setup_cost = 0;
+SET parallel_tuple_cost = 0;
+SET min_parallel_table_scan_size = 0;
+SET max_parallel_workers_per_gather = 2;
+
+SELECT 'union1', ST_Area(ST_Union(geom)), ST_NumGeometries(ST_Union(geom)) FROM union_parallel;
+SELECT 'union2', ST_AsText(ST_Union(geom)) FROM union_parallel WHERE i > 10000;
+SELECT 'union3', ST_Union(geom) IS NULL FROM union_parallel WHERE i = 10000;
+SELECT 'union4', i % 2, ST_Area(ST_Union(geom)) FROM union_parallel GROUP BY i % 2 ORDER BY 2;
+
+RESET max_parallel_workers_per_gather;
+RESET min_parallel_table_scan_size;
+RESET parallel_tuple_cost;
+RESET parallel_setup_cost;
+
+DROP TABLE union_parallel;